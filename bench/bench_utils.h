@@ -0,0 +1,63 @@
+/*!
+ * bigmath.
+ * bench_utils.h
+ *
+ * \date 10/17/2026
+ * \author Eduard Maximovich (edward.vstock@gmail.com)
+ * \link   https://github.com/edwardstock
+ */
+#ifndef BIGMATHPP_BENCH_UTILS_H
+#define BIGMATHPP_BENCH_UTILS_H
+
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace bigmath {
+namespace bench {
+
+/// \brief Heap calls made by GMP, mpdecimal and operator new since start, counted by hooks installed in main()
+struct alloc_counters {
+    uint64_t allocs;
+    uint64_t frees;
+    uint64_t bytes;
+};
+
+alloc_counters alloc_snapshot();
+
+/// \brief Deterministic decimal digit string of given length without leading zeros
+std::string make_digits(size_t n, uint32_t seed = 1);
+
+/// \brief Same as make_digits(), but with decimal point before last "scale" digits
+std::string make_decimal(size_t n, size_t scale, uint32_t seed = 1);
+
+/// \brief Operand sizes in decimal digits: token amounts (18, 38) up to 10k-digit values
+void digit_sizes(benchmark::internal::Benchmark* b);
+
+/// \brief Helper to report heap activity per iteration as user counters
+class alloc_scope {
+public:
+    explicit alloc_scope(benchmark::State& state)
+        : m_state(state),
+          m_start(alloc_snapshot()) {
+    }
+
+    ~alloc_scope() {
+        const alloc_counters end = alloc_snapshot();
+        m_state.counters["allocs/op"] = benchmark::Counter(
+            double(end.allocs - m_start.allocs), benchmark::Counter::kAvgIterations);
+        m_state.counters["bytes/op"] = benchmark::Counter(
+            double(end.bytes - m_start.bytes), benchmark::Counter::kAvgIterations);
+        m_state.counters["digits"] = double(m_state.range(0));
+    }
+
+private:
+    benchmark::State& m_state;
+    alloc_counters m_start;
+};
+
+} // namespace bench
+} // namespace bigmath
+
+#endif // BIGMATHPP_BENCH_UTILS_H
@@ -0,0 +1,553 @@
+/*!
+ * bigmath.
+ * bigdecimal_bench.cpp
+ *
+ * \date 10/17/2026
+ * \author Eduard Maximovich (edward.vstock@gmail.com)
+ * \link   https://github.com/edwardstock
+ */
+
+#include "bench_utils.h"
+
+#include <benchmark/benchmark.h>
+#include <bigmath/batch.h>
+#include <bigmath/bigdecimal.h>
+#include <bigmath/bigdecimal_view.h>
+#include <bigmath/checked.h>
+#include <bigmath/decimal_column.h>
+#include <bigmath/decimal_expr.h>
+#include <bigmath/fixed_decimal.h>
+#include <vector>
+
+using namespace bigmath;
+using namespace bigmath::bench;
+
+// amounts carry 18 fractional digits like on-chain token values
+static constexpr size_t SCALE = 18;
+
+static void BigDecimal_Add(benchmark::State& state) {
+    const bigdecimal a(make_decimal(state.range(0), SCALE, 1));
+    const bigdecimal b(make_decimal(state.range(0), SCALE, 2));
+    alloc_scope allocs(state);
+    for (auto _ : state) {
+        bigdecimal r = a + b;
+        benchmark::DoNotOptimize(r);
+    }
+}
+BENCHMARK(BigDecimal_Add)->Apply(digit_sizes);
+
+static void BigDecimal_AddAssign(benchmark::State& state) {
+    bigdecimal a(make_decimal(state.range(0), SCALE, 1));
+    const bigdecimal b(make_decimal(state.range(0), SCALE, 2));
+    alloc_scope allocs(state);
+    for (auto _ : state) {
+        a += b;
+        benchmark::DoNotOptimize(a);
+    }
+}
+BENCHMARK(BigDecimal_AddAssign)->Apply(digit_sizes);
+
+static void BigDecimal_Mul(benchmark::State& state) {
+    const bigdecimal a(make_decimal(state.range(0), SCALE, 1));
+    const bigdecimal b(make_decimal(state.range(0), SCALE, 2));
+    alloc_scope allocs(state);
+    for (auto _ : state) {
+        bigdecimal r = a * b;
+        benchmark::DoNotOptimize(r);
+    }
+}
+BENCHMARK(BigDecimal_Mul)->Apply(digit_sizes);
+
+static void BigDecimal_Div(benchmark::State& state) {
+    const bigdecimal a(make_decimal(state.range(0), SCALE, 1));
+    const bigdecimal b(make_decimal(state.range(0), SCALE, 2));
+    alloc_scope allocs(state);
+    for (auto _ : state) {
+        bigdecimal r = a / b;
+        benchmark::DoNotOptimize(r);
+    }
+}
+BENCHMARK(BigDecimal_Div)->Apply(digit_sizes);
+
+static void BigDecimal_SetStr(benchmark::State& state) {
+    const std::string s = make_decimal(state.range(0), SCALE, 1);
+    bigdecimal r;
+    alloc_scope allocs(state);
+    for (auto _ : state) {
+        r.set_str(s);
+        benchmark::DoNotOptimize(r);
+    }
+}
+BENCHMARK(BigDecimal_SetStr)->Apply(digit_sizes);
+
+static void BigDecimal_SetStrInteger(benchmark::State& state) {
+    const std::string s = make_digits(state.range(0), 1);
+    bigdecimal r;
+    alloc_scope allocs(state);
+    for (auto _ : state) {
+        r.set_str(s);
+        benchmark::DoNotOptimize(r);
+    }
+}
+BENCHMARK(BigDecimal_SetStrInteger)->Apply(digit_sizes);
+
+static void BigDecimal_Format(benchmark::State& state) {
+    const bigdecimal a(make_decimal(state.range(0), SCALE, 1));
+    alloc_scope allocs(state);
+    for (auto _ : state) {
+        std::string r = a.format("f");
+        benchmark::DoNotOptimize(r);
+    }
+}
+BENCHMARK(BigDecimal_Format)->Apply(digit_sizes);
+
+static void BigDecimal_FormatFixed18(benchmark::State& state) {
+    const bigdecimal a(make_decimal(state.range(0), SCALE + 2, 1));
+    alloc_scope allocs(state);
+    for (auto _ : state) {
+        std::string r = a.format(".18f");
+        benchmark::DoNotOptimize(r);
+    }
+}
+BENCHMARK(BigDecimal_FormatFixed18)->Apply(digit_sizes);
+
+static void BigDecimal_ToChars(benchmark::State& state) {
+    const bigdecimal a(make_decimal(state.range(0), SCALE, 1));
+    std::vector<char> buf(state.range(0) + SCALE + 8);
+    alloc_scope allocs(state);
+    for (auto _ : state) {
+        std::to_chars_result r = a.to_chars(buf.data(), buf.data() + buf.size());
+        benchmark::DoNotOptimize(r);
+    }
+}
+BENCHMARK(BigDecimal_ToChars)->Apply(digit_sizes);
+
+static void BigDecimal_AppendFixed18(benchmark::State& state) {
+    const bigdecimal a(make_decimal(state.range(0), SCALE + 2, 1));
+    std::string out;
+    alloc_scope allocs(state);
+    for (auto _ : state) {
+        out.clear();
+        a.append_to(out, 18);
+        benchmark::DoNotOptimize(out);
+    }
+}
+BENCHMARK(BigDecimal_AppendFixed18)->Apply(digit_sizes);
+
+static void BigDecimal_ToBigint(benchmark::State& state) {
+    const bigdecimal a(make_decimal(state.range(0), SCALE, 1));
+    alloc_scope allocs(state);
+    for (auto _ : state) {
+        bigint r = a.to_bigint();
+        benchmark::DoNotOptimize(r);
+    }
+}
+BENCHMARK(BigDecimal_ToBigint)->Apply(digit_sizes);
+
+static void BigDecimal_FromBigint(benchmark::State& state) {
+    const bigint a(make_digits(state.range(0), 1));
+    alloc_scope allocs(state);
+    for (auto _ : state) {
+        bigdecimal r(a);
+        benchmark::DoNotOptimize(r);
+    }
+}
+BENCHMARK(BigDecimal_FromBigint)->Apply(digit_sizes);
+
+static void inline_sizes(benchmark::internal::Benchmark* b) {
+    for (int64_t n : {18, 38, 76, 152}) {
+        b->Arg(n);
+    }
+}
+
+// heap spills (allocs/op) against object size for inline coefficient of N words
+template<mpd_ssize_t N>
+static void BigDecimal_InlineMulAdd(benchmark::State& state) {
+    using dec = basic_bigdecimal<N>;
+    const dec a(make_decimal(state.range(0), SCALE, 1));
+    const dec b(make_decimal(state.range(0), SCALE, 2));
+    state.counters["object_bytes"] = double(sizeof(dec));
+    alloc_scope allocs(state);
+    for (auto _ : state) {
+        dec r = a * b;
+        r += a;
+        benchmark::DoNotOptimize(r);
+    }
+}
+BENCHMARK_TEMPLATE(BigDecimal_InlineMulAdd, 2)->Apply(inline_sizes);
+BENCHMARK_TEMPLATE(BigDecimal_InlineMulAdd, 4)->Apply(inline_sizes);
+BENCHMARK_TEMPLATE(BigDecimal_InlineMulAdd, 8)->Apply(inline_sizes);
+
+// sum of array, smaller objects are denser in cache
+template<mpd_ssize_t N>
+static void BigDecimal_InlineSum(benchmark::State& state) {
+    using dec = basic_bigdecimal<N>;
+    std::vector<dec> values;
+    for (uint32_t i = 0; i < 4096; i++) {
+        values.emplace_back(make_decimal(state.range(0), SCALE, i + 1));
+    }
+    state.counters["object_bytes"] = double(sizeof(dec));
+    alloc_scope allocs(state);
+    for (auto _ : state) {
+        dec sum("0");
+        for (const dec& v : values) {
+            sum += v;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+}
+BENCHMARK_TEMPLATE(BigDecimal_InlineSum, 2)->Apply(inline_sizes);
+BENCHMARK_TEMPLATE(BigDecimal_InlineSum, 4)->Apply(inline_sizes);
+BENCHMARK_TEMPLATE(BigDecimal_InlineSum, 8)->Apply(inline_sizes);
+
+// a * b / c + d with operators: three temporaries and a context per operation
+static void BigDecimal_Chain(benchmark::State& state) {
+    const bigdecimal a(make_decimal(state.range(0), SCALE, 1));
+    const bigdecimal b(make_decimal(state.range(0), SCALE, 2));
+    const bigdecimal c(make_decimal(state.range(0), SCALE, 3));
+    const bigdecimal d(make_decimal(state.range(0), SCALE, 4));
+    alloc_scope allocs(state);
+    for (auto _ : state) {
+        bigdecimal r = a * b / c + d;
+        benchmark::DoNotOptimize(r);
+    }
+}
+BENCHMARK(BigDecimal_Chain)->Apply(digit_sizes);
+
+// same expression evaluated lazily: exact product, single final rounding
+static void BigDecimal_LazyChain(benchmark::State& state) {
+    const bigdecimal a(make_decimal(state.range(0), SCALE, 1));
+    const bigdecimal b(make_decimal(state.range(0), SCALE, 2));
+    const bigdecimal c(make_decimal(state.range(0), SCALE, 3));
+    const bigdecimal d(make_decimal(state.range(0), SCALE, 4));
+    alloc_scope allocs(state);
+    for (auto _ : state) {
+        bigdecimal r = eval(lazy(a) * b / c + d);
+        benchmark::DoNotOptimize(r);
+    }
+}
+BENCHMARK(BigDecimal_LazyChain)->Apply(digit_sizes);
+
+// a * b + c maps to fma
+static void BigDecimal_LazyMulAdd(benchmark::State& state) {
+    const bigdecimal a(make_decimal(state.range(0), SCALE, 1));
+    const bigdecimal b(make_decimal(state.range(0), SCALE, 2));
+    const bigdecimal c(make_decimal(state.range(0), SCALE, 3));
+    alloc_scope allocs(state);
+    for (auto _ : state) {
+        bigdecimal r = eval(lazy(a) * b + c);
+        benchmark::DoNotOptimize(r);
+    }
+}
+BENCHMARK(BigDecimal_LazyMulAdd)->Apply(digit_sizes);
+
+static std::vector<bigdecimal> make_array(size_t digits, uint32_t seed) {
+    std::vector<bigdecimal> values;
+    for (uint32_t i = 0; i < 4096; i++) {
+        values.emplace_back(make_decimal(digits, SCALE, seed + i));
+    }
+    return values;
+}
+
+// sum with operator+=: context and rounding per element
+static void BigDecimal_LoopSum(benchmark::State& state) {
+    const std::vector<bigdecimal> values = make_array(state.range(0), 1);
+    alloc_scope allocs(state);
+    for (auto _ : state) {
+        bigdecimal sum("0");
+        for (const bigdecimal& v : values) {
+            sum += v;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+}
+BENCHMARK(BigDecimal_LoopSum)->Arg(18)->Arg(38)->Arg(100);
+
+static void BigDecimal_BatchSum(benchmark::State& state) {
+    const std::vector<bigdecimal> values = make_array(state.range(0), 1);
+    alloc_scope allocs(state);
+    for (auto _ : state) {
+        bigdecimal sum = batch::sum(values);
+        benchmark::DoNotOptimize(sum);
+    }
+}
+BENCHMARK(BigDecimal_BatchSum)->Arg(18)->Arg(38)->Arg(100);
+
+static void BigDecimal_LoopDot(benchmark::State& state) {
+    const std::vector<bigdecimal> a = make_array(state.range(0), 1);
+    const std::vector<bigdecimal> b = make_array(state.range(0), 5000);
+    alloc_scope allocs(state);
+    for (auto _ : state) {
+        bigdecimal sum("0");
+        for (size_t i = 0; i < a.size(); i++) {
+            sum += a[i] * b[i];
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+}
+BENCHMARK(BigDecimal_LoopDot)->Arg(18)->Arg(38)->Arg(100);
+
+static void BigDecimal_BatchDot(benchmark::State& state) {
+    const std::vector<bigdecimal> a = make_array(state.range(0), 1);
+    const std::vector<bigdecimal> b = make_array(state.range(0), 5000);
+    alloc_scope allocs(state);
+    for (auto _ : state) {
+        bigdecimal sum = batch::dot(a, b);
+        benchmark::DoNotOptimize(sum);
+    }
+}
+BENCHMARK(BigDecimal_BatchDot)->Arg(18)->Arg(38)->Arg(100);
+
+static void BigDecimal_ColumnSum(benchmark::State& state) {
+    const decimal_column values(make_array(state.range(0), 1));
+    alloc_scope allocs(state);
+    for (auto _ : state) {
+        bigdecimal sum = values.sum();
+        benchmark::DoNotOptimize(sum);
+    }
+}
+BENCHMARK(BigDecimal_ColumnSum)->Arg(18)->Arg(38)->Arg(100);
+
+// element-wise a[i] + b[i] of arrays
+static void BigDecimal_LoopAdd(benchmark::State& state) {
+    const std::vector<bigdecimal> a = make_array(state.range(0), 1);
+    const std::vector<bigdecimal> b = make_array(state.range(0), 5000);
+    std::vector<bigdecimal> out(a.size());
+    alloc_scope allocs(state);
+    for (auto _ : state) {
+        for (size_t i = 0; i < a.size(); i++) {
+            out[i] = a[i] + b[i];
+        }
+        benchmark::DoNotOptimize(out);
+    }
+}
+BENCHMARK(BigDecimal_LoopAdd)->Arg(18)->Arg(38);
+
+static void BigDecimal_ColumnAdd(benchmark::State& state) {
+    const decimal_column a(make_array(state.range(0), 1));
+    const decimal_column b(make_array(state.range(0), 5000));
+    decimal_column out;
+    alloc_scope allocs(state);
+    for (auto _ : state) {
+        decimal_column::add(a, b, out);
+        benchmark::DoNotOptimize(out);
+    }
+}
+BENCHMARK(BigDecimal_ColumnAdd)->Arg(18)->Arg(38);
+
+// array of values to text and back, as in JSON or CSV
+static void BigDecimal_TextRoundTrip(benchmark::State& state) {
+    const std::vector<bigdecimal> values = make_array(state.range(0), 1);
+    std::vector<std::string> text(values.size());
+    std::vector<bigdecimal> out(values.size());
+    alloc_scope allocs(state);
+    for (auto _ : state) {
+        for (size_t i = 0; i < values.size(); i++) {
+            text[i] = values[i].to_sci();
+        }
+        for (size_t i = 0; i < values.size(); i++) {
+            out[i].set_str(text[i]);
+        }
+        benchmark::DoNotOptimize(out);
+    }
+}
+BENCHMARK(BigDecimal_TextRoundTrip)->Arg(18)->Arg(38);
+
+static void BigDecimal_BinaryRoundTrip(benchmark::State& state) {
+    const std::vector<bigdecimal> values = make_array(state.range(0), 1);
+    std::vector<uint8_t> buffer;
+    std::vector<bigdecimal> out(values.size());
+    alloc_scope allocs(state);
+    for (auto _ : state) {
+        buffer.clear();
+        for (const bigdecimal& v : values) {
+            v.serialize_to(buffer);
+        }
+        size_t offset = 0, consumed = 0;
+        for (size_t i = 0; i < out.size(); i++) {
+            out[i] = bigdecimal::deserialize(buffer.data() + offset, buffer.size() - offset, &consumed);
+            offset += consumed;
+        }
+        benchmark::DoNotOptimize(out);
+    }
+}
+BENCHMARK(BigDecimal_BinaryRoundTrip)->Arg(18)->Arg(38);
+
+// comparison of serialized values with threshold without materializing decimals
+static void BigDecimal_ViewCompare(benchmark::State& state) {
+    const std::vector<bigdecimal> values = make_array(state.range(0), 1);
+    const bigdecimal threshold = values[values.size() / 2];
+    std::vector<uint8_t> buffer;
+    for (const bigdecimal& v : values) {
+        v.serialize_to(buffer);
+    }
+    alloc_scope allocs(state);
+    for (auto _ : state) {
+        size_t offset = 0, greater = 0;
+        while (offset < buffer.size()) {
+            const bigdecimal_view view(buffer.data() + offset, buffer.size() - offset);
+            greater += view.compare(threshold) > 0;
+            offset += view.encoded_size();
+        }
+        benchmark::DoNotOptimize(greater);
+    }
+}
+BENCHMARK(BigDecimal_ViewCompare)->Arg(18)->Arg(38);
+
+// failed division: exception from trap vs status of checked::div
+static void BigDecimal_DivByZeroThrow(benchmark::State& state) {
+    const bigdecimal a(make_decimal(state.range(0), SCALE, 1));
+    const bigdecimal zero("0");
+    const bd_context saved = context;
+    context.policy(precision_policy::fixed);
+    context.add_traps(MPD_Division_by_zero);
+    size_t failed = 0;
+    for (auto _ : state) {
+        try {
+            bigdecimal r = a / zero;
+            benchmark::DoNotOptimize(r);
+        } catch (const bigmath::division_by_zero&) {
+            failed++;
+        }
+    }
+    context = saved;
+    benchmark::DoNotOptimize(failed);
+}
+BENCHMARK(BigDecimal_DivByZeroThrow)->Arg(18);
+
+static void BigDecimal_DivByZeroChecked(benchmark::State& state) {
+    const bigdecimal a(make_decimal(state.range(0), SCALE, 1));
+    const bigdecimal zero("0");
+    size_t failed = 0;
+    for (auto _ : state) {
+        result<bigdecimal> r = checked::div(a, zero);
+        failed += !r.ok();
+        benchmark::DoNotOptimize(r);
+    }
+    benchmark::DoNotOptimize(failed);
+}
+BENCHMARK(BigDecimal_DivByZeroChecked)->Arg(18);
+
+// loop of divisions with traps checked by every operation vs deferred to single check at guard exit
+static void BigDecimal_LoopTrapped(benchmark::State& state) {
+    std::vector<bigdecimal> values;
+    for (uint32_t i = 0; i < 1024; i++) {
+        values.emplace_back(make_decimal(state.range(0), SCALE, i + 1));
+    }
+    const bigdecimal divisor("3");
+    bd_context c;
+    for (auto _ : state) {
+        for (const bigdecimal& v : values) {
+            bigdecimal r = v.div(divisor, c);
+            benchmark::DoNotOptimize(r);
+        }
+    }
+}
+BENCHMARK(BigDecimal_LoopTrapped)->Arg(18);
+
+static void BigDecimal_LoopDeferred(benchmark::State& state) {
+    std::vector<bigdecimal> values;
+    for (uint32_t i = 0; i < 1024; i++) {
+        values.emplace_back(make_decimal(state.range(0), SCALE, i + 1));
+    }
+    const bigdecimal divisor("3");
+    bd_context c;
+    for (auto _ : state) {
+        deferred_traps guard(c);
+        for (const bigdecimal& v : values) {
+            bigdecimal r = v.div(divisor, c);
+            benchmark::DoNotOptimize(r);
+        }
+    }
+}
+BENCHMARK(BigDecimal_LoopDeferred)->Arg(18);
+
+// precision override of thread context for one division: manual copy and validated setters vs context_scope
+static void BigDecimal_ContextSaveRestore(benchmark::State& state) {
+    const bigdecimal a(make_decimal(state.range(0), SCALE, 1));
+    const bigdecimal b("3");
+    for (auto _ : state) {
+        const bd_context saved = context;
+        context.prec(38);
+        bigdecimal r = a.div(b);
+        context = saved;
+        benchmark::DoNotOptimize(r);
+    }
+}
+BENCHMARK(BigDecimal_ContextSaveRestore)->Arg(18);
+
+static void BigDecimal_ContextScope(benchmark::State& state) {
+    const bigdecimal a(make_decimal(state.range(0), SCALE, 1));
+    const bigdecimal b("3");
+    for (auto _ : state) {
+        context_scope scope(38);
+        bigdecimal r = a.div(b);
+        benchmark::DoNotOptimize(r);
+    }
+}
+BENCHMARK(BigDecimal_ContextScope)->Arg(18);
+
+// addition with context built per call by operator, runtime context argument and compile-time context
+static void BigDecimal_AddOperator(benchmark::State& state) {
+    const bigdecimal a(make_decimal(state.range(0), SCALE, 1));
+    const bigdecimal b(make_decimal(state.range(0), SCALE, 7));
+    for (auto _ : state) {
+        bigdecimal r = a + b;
+        benchmark::DoNotOptimize(r);
+    }
+}
+BENCHMARK(BigDecimal_AddOperator)->Arg(18);
+
+static void BigDecimal_AddRuntimeContext(benchmark::State& state) {
+    const bigdecimal a(make_decimal(state.range(0), SCALE, 1));
+    const bigdecimal b(make_decimal(state.range(0), SCALE, 7));
+    bd_context c(38, 999999, -999999, ROUND_HALF_EVEN);
+    for (auto _ : state) {
+        bigdecimal r = a.add(b, c);
+        benchmark::DoNotOptimize(r);
+    }
+}
+BENCHMARK(BigDecimal_AddRuntimeContext)->Arg(18);
+
+static void BigDecimal_AddStaticContext(benchmark::State& state) {
+    const bigdecimal a(make_decimal(state.range(0), SCALE, 1));
+    const bigdecimal b(make_decimal(state.range(0), SCALE, 7));
+    for (auto _ : state) {
+        bigdecimal r = a.add(b, static_context<38>{});
+        benchmark::DoNotOptimize(r);
+    }
+}
+BENCHMARK(BigDecimal_AddStaticContext)->Arg(18);
+
+#ifdef HAVE_UINT128_T
+// same operations as BigDecimal_InlineMulAdd and BigDecimal_InlineSum on 128-bit fixed-point values
+static void FixedDecimal_MulAdd(benchmark::State& state) {
+    const fixed_decimal<SCALE> a(make_decimal(state.range(0), SCALE, 1));
+    const fixed_decimal<SCALE> b(make_decimal(state.range(0), SCALE, 2));
+    state.counters["object_bytes"] = double(sizeof(a));
+    alloc_scope allocs(state);
+    for (auto _ : state) {
+        fixed_decimal<SCALE> r = a * b;
+        r += a;
+        benchmark::DoNotOptimize(r);
+    }
+}
+BENCHMARK(FixedDecimal_MulAdd)->Arg(18);
+
+static void FixedDecimal_Sum(benchmark::State& state) {
+    std::vector<fixed_decimal<SCALE>> values;
+    for (uint32_t i = 0; i < 4096; i++) {
+        values.emplace_back(make_decimal(state.range(0), SCALE, i + 1));
+    }
+    state.counters["object_bytes"] = double(sizeof(values[0]));
+    alloc_scope allocs(state);
+    for (auto _ : state) {
+        fixed_decimal<SCALE> sum;
+        for (const fixed_decimal<SCALE>& v : values) {
+            sum += v;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+}
+BENCHMARK(FixedDecimal_Sum)->Arg(18)->Arg(30);
+#endif // HAVE_UINT128_T
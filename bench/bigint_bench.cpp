@@ -0,0 +1,382 @@
+/*!
+ * bigmath.
+ * bigint_bench.cpp
+ *
+ * \date 10/17/2026
+ * \author Eduard Maximovich (edward.vstock@gmail.com)
+ * \link   https://github.com/edwardstock
+ */
+
+#include "bench_utils.h"
+
+#include <benchmark/benchmark.h>
+#include <bigmath/bigint.h>
+#include <bigmath/bigint_expr.h>
+#include <bigmath/parallel.h>
+#include <bigmath/uint256.h>
+#include <vector>
+
+using namespace bigmath;
+using namespace bigmath::bench;
+
+static void BigInt_Add(benchmark::State& state) {
+    const bigint a(make_digits(state.range(0), 1));
+    const bigint b(make_digits(state.range(0), 2));
+    alloc_scope allocs(state);
+    for (auto _ : state) {
+        bigint r = a + b;
+        benchmark::DoNotOptimize(r);
+    }
+}
+BENCHMARK(BigInt_Add)->Apply(digit_sizes);
+
+static void BigInt_AddAssign(benchmark::State& state) {
+    bigint a(make_digits(state.range(0), 1));
+    const bigint b(make_digits(state.range(0), 2));
+    alloc_scope allocs(state);
+    for (auto _ : state) {
+        a += b;
+        benchmark::DoNotOptimize(a);
+    }
+}
+BENCHMARK(BigInt_AddAssign)->Apply(digit_sizes);
+
+static void BigInt_AddAssignU64(benchmark::State& state) {
+    bigint a(make_digits(state.range(0), 1));
+    const uint64_t fee = 21000;
+    alloc_scope allocs(state);
+    for (auto _ : state) {
+        a += fee;
+        benchmark::DoNotOptimize(a);
+    }
+}
+BENCHMARK(BigInt_AddAssignU64)->Apply(digit_sizes);
+
+static void BigInt_Sub(benchmark::State& state) {
+    const bigint a(make_digits(state.range(0), 1));
+    const bigint b(make_digits(state.range(0), 2));
+    alloc_scope allocs(state);
+    for (auto _ : state) {
+        bigint r = a - b;
+        benchmark::DoNotOptimize(r);
+    }
+}
+BENCHMARK(BigInt_Sub)->Apply(digit_sizes);
+
+static void BigInt_Mul(benchmark::State& state) {
+    const bigint a(make_digits(state.range(0), 1));
+    const bigint b(make_digits(state.range(0), 2));
+    alloc_scope allocs(state);
+    for (auto _ : state) {
+        bigint r = a * b;
+        benchmark::DoNotOptimize(r);
+    }
+}
+BENCHMARK(BigInt_Mul)->Apply(digit_sizes);
+
+static void BigInt_Div(benchmark::State& state) {
+    const bigint a(make_digits(state.range(0) * 2, 1));
+    const bigint b(make_digits(state.range(0), 2));
+    alloc_scope allocs(state);
+    for (auto _ : state) {
+        bigint r = a / b;
+        benchmark::DoNotOptimize(r);
+    }
+}
+BENCHMARK(BigInt_Div)->Apply(digit_sizes);
+
+static void BigInt_Mod(benchmark::State& state) {
+    const bigint a(make_digits(state.range(0) * 2, 1));
+    const bigint b(make_digits(state.range(0), 2));
+    alloc_scope allocs(state);
+    for (auto _ : state) {
+        bigint r = a % b;
+        benchmark::DoNotOptimize(r);
+    }
+}
+BENCHMARK(BigInt_Mod)->Apply(digit_sizes);
+
+static void BigInt_CompareZero(benchmark::State& state) {
+    bigint a(make_digits(state.range(0), 1));
+    alloc_scope allocs(state);
+    for (auto _ : state) {
+        bool r = a > 0;
+        benchmark::DoNotOptimize(r);
+    }
+}
+BENCHMARK(BigInt_CompareZero)->Apply(digit_sizes);
+
+static void BigInt_FromU64(benchmark::State& state) {
+    uint64_t v = 1000000000000000000ULL;
+    alloc_scope allocs(state);
+    for (auto _ : state) {
+        bigint r(v++);
+        benchmark::DoNotOptimize(r);
+    }
+}
+BENCHMARK(BigInt_FromU64)->Arg(18);
+
+static void BigInt_Copy(benchmark::State& state) {
+    const bigint a(make_digits(state.range(0), 1));
+    alloc_scope allocs(state);
+    for (auto _ : state) {
+        bigint r(a);
+        benchmark::DoNotOptimize(r);
+    }
+}
+BENCHMARK(BigInt_Copy)->Apply(digit_sizes);
+
+static void BigInt_FromString(benchmark::State& state) {
+    const std::string s = make_digits(state.range(0), 1);
+    alloc_scope allocs(state);
+    for (auto _ : state) {
+        bigint r(s);
+        benchmark::DoNotOptimize(r);
+    }
+}
+BENCHMARK(BigInt_FromString)->Apply(digit_sizes);
+
+static void BigInt_Str(benchmark::State& state) {
+    const bigint a(make_digits(state.range(0), 1));
+    alloc_scope allocs(state);
+    for (auto _ : state) {
+        std::string r = a.str();
+        benchmark::DoNotOptimize(r);
+    }
+}
+BENCHMARK(BigInt_Str)->Apply(digit_sizes);
+
+static void BigInt_ToChars(benchmark::State& state) {
+    const bigint a(make_digits(state.range(0), 1));
+    std::vector<char> buf(state.range(0) + 2);
+    alloc_scope allocs(state);
+    for (auto _ : state) {
+        std::to_chars_result r = a.to_chars(buf.data(), buf.data() + buf.size());
+        benchmark::DoNotOptimize(r);
+    }
+}
+BENCHMARK(BigInt_ToChars)->Apply(digit_sizes);
+
+static void BigInt_ExportBytes(benchmark::State& state) {
+    const bigint a(make_digits(state.range(0), 1));
+    alloc_scope allocs(state);
+    for (auto _ : state) {
+        std::vector<uint8_t> r = a.export_bytes();
+        benchmark::DoNotOptimize(r);
+    }
+}
+BENCHMARK(BigInt_ExportBytes)->Apply(digit_sizes);
+
+static void BigInt_ImportBytes(benchmark::State& state) {
+    const std::vector<uint8_t> bytes = bigint(make_digits(state.range(0), 1)).export_bytes();
+    bigint r;
+    alloc_scope allocs(state);
+    for (auto _ : state) {
+        r.import_bytes(bytes);
+        benchmark::DoNotOptimize(r);
+    }
+}
+BENCHMARK(BigInt_ImportBytes)->Apply(digit_sizes);
+
+// fixed 32-byte words, as uint256 values and hashes are stored
+static void BigInt_ExportTo(benchmark::State& state) {
+    const bigint a(make_digits(state.range(0), 1));
+    uint8_t out[64];
+    alloc_scope allocs(state);
+    for (auto _ : state) {
+        a.export_to(out, 32, endian::big, true);
+        benchmark::DoNotOptimize(out);
+    }
+}
+BENCHMARK(BigInt_ExportTo)->Arg(18)->Arg(38)->Arg(77);
+
+static void BigInt_ImportFrom(benchmark::State& state) {
+    uint8_t bytes[32];
+    bigint(make_digits(state.range(0), 1)).export_to(bytes, sizeof(bytes), endian::big, true);
+    bigint r;
+    alloc_scope allocs(state);
+    for (auto _ : state) {
+        r.import_from(bytes, sizeof(bytes));
+        benchmark::DoNotOptimize(r);
+    }
+}
+BENCHMARK(BigInt_ImportFrom)->Arg(18)->Arg(38)->Arg(77);
+
+// r = a * b + c * d with operators: three temporaries
+static void BigInt_SumOfProducts(benchmark::State& state) {
+    const bigint a(make_digits(state.range(0), 1));
+    const bigint b(make_digits(state.range(0), 2));
+    const bigint c(make_digits(state.range(0), 3));
+    const bigint d(make_digits(state.range(0), 4));
+    bigint r;
+    alloc_scope allocs(state);
+    for (auto _ : state) {
+        r = a * b + c * d;
+        benchmark::DoNotOptimize(r);
+    }
+}
+BENCHMARK(BigInt_SumOfProducts)->Apply(digit_sizes);
+
+// same expression evaluated lazily into limbs of r with mpz_addmul
+static void BigInt_LazySumOfProducts(benchmark::State& state) {
+    const bigint a(make_digits(state.range(0), 1));
+    const bigint b(make_digits(state.range(0), 2));
+    const bigint c(make_digits(state.range(0), 3));
+    const bigint d(make_digits(state.range(0), 4));
+    bigint r;
+    alloc_scope allocs(state);
+    for (auto _ : state) {
+        r = lazy(a) * b + c * lazy(d);
+        benchmark::DoNotOptimize(r);
+    }
+}
+BENCHMARK(BigInt_LazySumOfProducts)->Apply(digit_sizes);
+
+// quotient and remainder with operators: two divisions, two results
+static void BigInt_DivMod(benchmark::State& state) {
+    const bigint a(make_digits(state.range(0) * 2, 1));
+    const bigint b(make_digits(state.range(0), 2));
+    alloc_scope allocs(state);
+    for (auto _ : state) {
+        bigint q = a / b;
+        bigint r = a % b;
+        benchmark::DoNotOptimize(q);
+        benchmark::DoNotOptimize(r);
+    }
+}
+BENCHMARK(BigInt_DivMod)->Apply(digit_sizes);
+
+// one mpz_tdiv_qr call into reused results
+static void BigInt_TdivQr(benchmark::State& state) {
+    const bigint a(make_digits(state.range(0) * 2, 1));
+    const bigint b(make_digits(state.range(0), 2));
+    bigint q, r;
+    alloc_scope allocs(state);
+    for (auto _ : state) {
+        bigint::tdiv_qr(q, r, a, b);
+        benchmark::DoNotOptimize(q);
+        benchmark::DoNotOptimize(r);
+    }
+}
+BENCHMARK(BigInt_TdivQr)->Apply(digit_sizes);
+
+static void BigInt_MulOut(benchmark::State& state) {
+    const bigint a(make_digits(state.range(0), 1));
+    const bigint b(make_digits(state.range(0), 2));
+    bigint r;
+    alloc_scope allocs(state);
+    for (auto _ : state) {
+        bigint::mul(r, a, b);
+        benchmark::DoNotOptimize(r);
+    }
+}
+BENCHMARK(BigInt_MulOut)->Apply(digit_sizes);
+
+#ifdef HAVE_UINT128_T
+// same operations as BigInt_Add, BigInt_Mul and BigInt_TdivQr on inline 256-bit values
+static void UInt256_Add(benchmark::State& state) {
+    const uint256 a(make_digits(state.range(0), 1));
+    const uint256 b(make_digits(state.range(0), 2));
+    alloc_scope allocs(state);
+    for (auto _ : state) {
+        uint256 r = a + b;
+        benchmark::DoNotOptimize(r);
+    }
+}
+BENCHMARK(UInt256_Add)->Arg(18)->Arg(38)->Arg(76);
+
+static void UInt256_Mul(benchmark::State& state) {
+    const uint256 a(make_digits(state.range(0), 1));
+    const uint256 b(make_digits(state.range(0), 2));
+    alloc_scope allocs(state);
+    for (auto _ : state) {
+        uint256 r = a * b;
+        benchmark::DoNotOptimize(r);
+    }
+}
+BENCHMARK(UInt256_Mul)->Arg(18)->Arg(38);
+
+static void UInt256_DivMod(benchmark::State& state) {
+    const uint256 a(make_digits(state.range(0) * 2, 1));
+    const uint256 b(make_digits(state.range(0), 2));
+    uint256 q, r;
+    alloc_scope allocs(state);
+    for (auto _ : state) {
+        uint256::div_mod(a, b, q, r);
+        benchmark::DoNotOptimize(q);
+        benchmark::DoNotOptimize(r);
+    }
+}
+BENCHMARK(UInt256_DivMod)->Arg(18)->Arg(38);
+
+static void UInt256_ToBigInt(benchmark::State& state) {
+    const uint256 a(make_digits(state.range(0), 1));
+    bigint r;
+    alloc_scope allocs(state);
+    for (auto _ : state) {
+        r = a.to_bigint();
+        benchmark::DoNotOptimize(r);
+    }
+}
+BENCHMARK(UInt256_ToBigInt)->Arg(18)->Arg(38)->Arg(76);
+
+static void UInt256_FromBigInt(benchmark::State& state) {
+    const bigint a(make_digits(state.range(0), 1));
+    alloc_scope allocs(state);
+    for (auto _ : state) {
+        uint256 r(a);
+        benchmark::DoNotOptimize(r);
+    }
+}
+BENCHMARK(UInt256_FromBigInt)->Arg(18)->Arg(38)->Arg(76);
+
+// compare with BigInt_ExportTo and BigInt_ImportFrom
+static void UInt256_Bytes(benchmark::State& state) {
+    const uint256 a(make_digits(state.range(0), 1));
+    uint8_t out[uint256::BYTES];
+    uint256 r;
+    alloc_scope allocs(state);
+    for (auto _ : state) {
+        a.export_to(out);
+        benchmark::DoNotOptimize(out);
+        r.import_from(out);
+        benchmark::DoNotOptimize(r);
+    }
+}
+BENCHMARK(UInt256_Bytes)->Arg(76);
+#endif // HAVE_UINT128_T
+
+static std::vector<bigint> make_balances(size_t digits) {
+    std::vector<bigint> values;
+    for (uint32_t i = 0; i < (1u << 18); i++) {
+        values.emplace_back(make_digits(digits, i + 1));
+    }
+    return values;
+}
+
+static void add_balance(bigint& acc, const bigint& v) {
+    acc += v;
+}
+
+static void BigInt_LoopSum(benchmark::State& state) {
+    const std::vector<bigint> values = make_balances(state.range(0));
+    for (auto _ : state) {
+        bigint sum("0");
+        for (const bigint& v : values) {
+            sum += v;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+}
+BENCHMARK(BigInt_LoopSum)->Arg(18)->Arg(100)->Unit(benchmark::kMillisecond);
+
+static void BigInt_ParallelSum(benchmark::State& state) {
+    const std::vector<bigint> values = make_balances(state.range(0));
+    thread_pool& pool = thread_pool::shared();
+    state.counters["threads"] = double(pool.size() + 1);
+    for (auto _ : state) {
+        bigint sum = parallel::reduce(values.begin(), values.end(), bigint("0"), add_balance, pool);
+        benchmark::DoNotOptimize(sum);
+    }
+}
+BENCHMARK(BigInt_ParallelSum)->Arg(18)->Arg(100)->Unit(benchmark::kMillisecond)->UseRealTime();
@@ -0,0 +1,133 @@
+/*!
+ * bigmath.
+ * main.cpp
+ *
+ * \date 10/17/2026
+ * \author Eduard Maximovich (edward.vstock@gmail.com)
+ * \link   https://github.com/edwardstock
+ */
+
+#include "bench_utils.h"
+
+#include <atomic>
+#include <benchmark/benchmark.h>
+#include <bigmath/mpdecimal_backport.h>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+#if defined(HAVE_GMP)
+#include <gmp.h>
+#elif defined(HAVE_MPIR)
+#include <mpir.h>
+#endif
+
+static std::atomic<uint64_t> n_allocs{0};
+static std::atomic<uint64_t> n_frees{0};
+static std::atomic<uint64_t> n_bytes{0};
+
+static ALWAYS_INLINE void count_alloc(size_t size) {
+    n_allocs.fetch_add(1, std::memory_order_relaxed);
+    n_bytes.fetch_add(size, std::memory_order_relaxed);
+}
+
+static void* counting_malloc(size_t size) {
+    count_alloc(size);
+    return std::malloc(size);
+}
+
+static void* counting_calloc(size_t nmemb, size_t size) {
+    count_alloc(nmemb * size);
+    return std::calloc(nmemb, size);
+}
+
+static void* counting_realloc(void* ptr, size_t size) {
+    count_alloc(size);
+    return std::realloc(ptr, size);
+}
+
+static void counting_free(void* ptr) {
+    if (ptr != nullptr) {
+        n_frees.fetch_add(1, std::memory_order_relaxed);
+    }
+    std::free(ptr);
+}
+
+static void* gmp_counting_realloc(void* ptr, size_t, size_t new_size) {
+    return counting_realloc(ptr, new_size);
+}
+
+static void gmp_counting_free(void* ptr, size_t) {
+    counting_free(ptr);
+}
+
+// count C++ heap usage (std::string, std::vector) as well
+void* operator new(size_t size) {
+    void* p = counting_malloc(size == 0 ? 1 : size);
+    if (p == nullptr) {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void operator delete(void* ptr) noexcept {
+    counting_free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept {
+    counting_free(ptr);
+}
+
+bigmath::bench::alloc_counters bigmath::bench::alloc_snapshot() {
+    return alloc_counters{
+        n_allocs.load(std::memory_order_relaxed),
+        n_frees.load(std::memory_order_relaxed),
+        n_bytes.load(std::memory_order_relaxed)};
+}
+
+std::string bigmath::bench::make_digits(size_t n, uint32_t seed) {
+    std::string out(n, '0');
+    uint32_t x = seed * 2654435761u + 1u;
+    for (size_t i = 0; i < n; i++) {
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        out[i] = char('0' + (x % 10));
+    }
+    if (n > 0 && out[0] == '0') {
+        out[0] = '1';
+    }
+    return out;
+}
+
+std::string bigmath::bench::make_decimal(size_t n, size_t scale, uint32_t seed) {
+    std::string out = make_digits(n, seed);
+    if (scale >= n) {
+        return "0." + std::string(scale - n, '0') + out;
+    }
+    out.insert(out.size() - scale, 1, '.');
+    return out;
+}
+
+void bigmath::bench::digit_sizes(benchmark::internal::Benchmark* b) {
+    for (int64_t n : {18, 38, 100, 1000, 10000}) {
+        b->Arg(n);
+    }
+}
+
+int main(int argc, char** argv) {
+    // hooks must be installed before any value is allocated
+    mp_set_memory_functions(counting_malloc, gmp_counting_realloc, gmp_counting_free);
+    mpd_mallocfunc = counting_malloc;
+    mpd_callocfunc = counting_calloc;
+    mpd_reallocfunc = counting_realloc;
+    mpd_free = counting_free;
+
+    ::benchmark::Initialize(&argc, argv);
+    if (::benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return 1;
+    }
+    ::benchmark::RunSpecifiedBenchmarks();
+    ::benchmark::Shutdown();
+    return 0;
+}
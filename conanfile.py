@@ -47,6 +47,7 @@ class BigmathConan(ConanFile):
     )
     build_requires = (
         "gtest/1.10.0",
+        "benchmark/1.6.1",
     )
 
     def source(self):
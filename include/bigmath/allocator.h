@@ -0,0 +1,137 @@
+/*!
+ * bigmath.
+ * allocator.h
+ *
+ * \date 10/17/2026
+ * \author Eduard Maximovich (edward.vstock@gmail.com)
+ * \link   https://github.com/edwardstock
+ */
+#ifndef BIGMATHPP_ALLOCATOR_H
+#define BIGMATHPP_ALLOCATOR_H
+
+#include "bigmath_config.h"
+
+#include "errors.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace bigmath {
+
+/// \brief Memory functions used by GMP (bigint) and mpdecimal (bigdecimal) for values data.
+/// Functions have C malloc/realloc/free semantics: realloc(nullptr, n) allocates, free(nullptr) does nothing.
+struct allocator {
+    void* (*alloc)(size_t size);
+    void* (*realloc)(void* ptr, size_t size);
+    void (*free)(void* ptr);
+};
+
+/// \brief Counters of pool_allocator() for the calling thread
+struct pool_stats {
+    /// allocations served from thread cache
+    uint64_t hits = 0;
+    /// allocations passed to std::malloc: empty cache or size larger than biggest size class
+    uint64_t misses = 0;
+    /// blocks freed to thread cache
+    uint64_t cached = 0;
+    /// blocks freed to std::free: cache is full or size larger than biggest size class
+    uint64_t released = 0;
+};
+
+/// \brief Installs memory functions for both GMP and mpdecimal.
+/// Memory allocated by one allocator must not be freed by another, so call it before any bigint or bigdecimal
+/// (or GMP and mpdecimal value, functions are process-wide) allocates heap, usually at start of main().
+/// \param a functions, all must be not null
+BIGMATHPP_API void set_allocator(const allocator& a);
+
+/// \brief Returns currently installed memory functions
+BIGMATHPP_API allocator get_allocator();
+
+/// \brief std::malloc, std::realloc and std::free, installed by default
+BIGMATHPP_API allocator system_allocator();
+
+/// \brief Thread-local size-class pool.
+/// Blocks up to 4096 bytes are rounded up to power of 2 size class and cached by freeing thread,
+/// so repeated allocations of same-sized coefficients and limbs don't take malloc locks.
+/// Block can be freed by any thread. Cache of each class is bounded, cached blocks are released on thread exit.
+BIGMATHPP_API allocator pool_allocator();
+
+/// \brief Returns pool_allocator() counters of the calling thread
+BIGMATHPP_API pool_stats get_pool_stats();
+
+/// \brief Resets pool_allocator() counters of the calling thread
+BIGMATHPP_API void reset_pool_stats();
+
+/// \brief Defines how arena_scope handles values that still hold arena memory when scope ends
+enum class arena_mode {
+    /// arena memory is freed, escaped value is dangling
+    fast,
+    /// arena memory is kept alive until escaped values are freed, close() throws arena_escape_error
+    /// and destructor aborts the process
+    checked,
+};
+
+/// \brief Routes every GMP and mpdecimal allocation of the current thread into bump arena,
+/// that is freed at once when scope ends. Freeing arena block is a no-op (except the last allocated),
+/// so batch of temporary bigint and bigdecimal values costs a pointer increment per allocation.
+/// Requires pool_allocator() to be installed. Scopes can be nested, must be destroyed by the creating thread.
+/// Values created inside the scope must not outlive it, including results moved to outer variables:
+/// copy them to values created outside within arena_bypass before scope exit.
+/// Values created outside the scope also take arena memory when they grow or get a result inside of it,
+/// including inline bigint limbs and bigdecimal coefficients that spill to heap. Modify them only within
+/// arena_bypass, otherwise in arena_mode::fast they are left dangling.
+class BIGMATHPP_API arena_scope {
+public:
+    static constexpr size_t DEFAULT_CHUNK_SIZE = 64 * 1024;
+
+    explicit arena_scope(arena_mode mode = arena_mode::fast, size_t chunk_size = DEFAULT_CHUNK_SIZE);
+    arena_scope(const arena_scope& other) = delete;
+    arena_scope(arena_scope&& other) = delete;
+    arena_scope& operator=(const arena_scope& other) = delete;
+    arena_scope& operator=(arena_scope&& other) = delete;
+    ~arena_scope();
+
+    /// \brief Ends scope before destructor. Scopes must be closed in reverse order.
+    /// \throws arena_escape_error in arena_mode::checked if some values were not freed
+    void close();
+
+    /// \brief Returns count of allocated and not freed blocks
+    size_t live_blocks() const;
+
+    /// \brief Returns total bytes requested from arena
+    size_t allocated_bytes() const;
+
+private:
+    friend struct arena_access;
+
+    void* m_chunks = nullptr;
+    char* m_cur = nullptr;
+    char* m_end = nullptr;
+    void* m_last = nullptr;
+    arena_scope* m_prev = nullptr;
+    size_t m_chunk_size;
+    size_t m_live = 0;
+    size_t m_bytes = 0;
+    uint32_t m_id;
+    arena_mode m_mode;
+    bool m_closed = false;
+
+    bool release();
+};
+
+/// \brief Temporarily routes allocations of the current thread back to the pool inside arena_scope,
+/// to create or copy values that outlive the arena
+class BIGMATHPP_API arena_bypass {
+public:
+    arena_bypass();
+    arena_bypass(const arena_bypass& other) = delete;
+    arena_bypass& operator=(const arena_bypass& other) = delete;
+    ~arena_bypass();
+
+private:
+    bool m_prev;
+};
+
+} // namespace bigmath
+
+#endif //BIGMATHPP_ALLOCATOR_H
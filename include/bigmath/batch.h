@@ -0,0 +1,221 @@
+/*!
+ * bigmath.
+ * batch.h
+ *
+ * \date 10/17/2026
+ * \author Eduard Maximovich (edward.vstock@gmail.com)
+ * \link   https://github.com/edwardstock
+ */
+#ifndef BIGMATHPP_BATCH_H
+#define BIGMATHPP_BATCH_H
+
+#include "bigdecimal.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace bigmath {
+
+/* Kernels over contiguous arrays of bigdecimal. sum and dot accumulate exactly in one value, that grows in place
+ * without rounding or status checks per element, and round once at the end. scale and fma_n round every result,
+ * but build context once and raise collected status once for the whole array. */
+namespace batch {
+
+namespace detail {
+
+/* exact accumulation: status of elements is collected, result is rounded by final context */
+ALWAYS_INLINE mpd_context_t exact_context(const mpd_context_t& final) {
+    mpd_context_t exact;
+    mpd_maxcontext(&exact);
+    exact.traps = 0;
+    exact.emax = final.emax;
+    exact.emin = final.emin;
+    return exact;
+}
+
+template<mpd_ssize_t N>
+ALWAYS_INLINE mpd_ssize_t max_digits(const basic_bigdecimal<N>* values, size_t n) {
+    mpd_ssize_t digits = 0;
+    for (size_t i = 0; i < n; i++) {
+        digits = std::max(digits, values[i].getconst()->digits);
+    }
+    return digits;
+}
+
+/* count of decimal digits in n: carries of n-term sum */
+ALWAYS_INLINE mpd_ssize_t count_digits(size_t n) {
+    mpd_ssize_t digits = 1;
+    for (; n >= 10; n /= 10) {
+        digits++;
+    }
+    return digits;
+}
+
+ALWAYS_INLINE bd_context operand_context(mpd_ssize_t digits) {
+    mpd_context_t ctx = OPERAND_CONTEXT;
+    ctx.prec = std::min<mpd_ssize_t>(std::max<mpd_ssize_t>(digits, 1), MPD_MAX_PREC);
+    return bd_context(ctx);
+}
+
+} // namespace detail
+
+/// \brief Sum of n values, rounded once with context c
+template<mpd_ssize_t N>
+basic_bigdecimal<N> sum(const basic_bigdecimal<N>* values, size_t n, bd_context& c) {
+    const mpd_context_t exact = detail::exact_context(*c.getconst());
+    uint32_t status = 0;
+    basic_bigdecimal<N> acc;
+    mpd_qset_ssize(acc.get(), 0, &exact, &status);
+    for (size_t i = 0; i < n; i++) {
+        mpd_qadd(acc.get(), acc.getconst(), values[i].getconst(), &exact, &status);
+    }
+    mpd_qplus(acc.get(), acc.getconst(), c.getconst(), &status);
+    c.raise(status);
+    return acc;
+}
+
+/// \brief Dot product of a and b of n values: a[0] * b[0] + ... + a[n-1] * b[n-1], rounded once with context c
+template<mpd_ssize_t N>
+basic_bigdecimal<N> dot(const basic_bigdecimal<N>* a, const basic_bigdecimal<N>* b, size_t n, bd_context& c) {
+    const mpd_context_t exact = detail::exact_context(*c.getconst());
+    uint32_t status = 0;
+    basic_bigdecimal<N> acc, product;
+    mpd_qset_ssize(acc.get(), 0, &exact, &status);
+    for (size_t i = 0; i < n; i++) {
+        mpd_qmul(product.get(), a[i].getconst(), b[i].getconst(), &exact, &status);
+        mpd_qadd(acc.get(), acc.getconst(), product.getconst(), &exact, &status);
+    }
+    mpd_qplus(acc.get(), acc.getconst(), c.getconst(), &status);
+    c.raise(status);
+    return acc;
+}
+
+/// \brief Multiplies n values by factor in place, each result is rounded with context c
+template<mpd_ssize_t N>
+void scale(basic_bigdecimal<N>* values, size_t n, const basic_bigdecimal<N>& factor, bd_context& c) {
+    uint32_t status = 0;
+    for (size_t i = 0; i < n; i++) {
+        mpd_qmul(values[i].get(), values[i].getconst(), factor.getconst(), c.getconst(), &status);
+    }
+    c.raise(status);
+}
+
+/// \brief out[i] = a[i] * b[i] + addend[i] for n values, each result is rounded once with context c
+/// out may be the same array as any of operands.
+template<mpd_ssize_t N>
+void fma_n(basic_bigdecimal<N>* out,
+           const basic_bigdecimal<N>* a,
+           const basic_bigdecimal<N>* b,
+           const basic_bigdecimal<N>* addend,
+           size_t n,
+           bd_context& c) {
+    uint32_t status = 0;
+    for (size_t i = 0; i < n; i++) {
+        mpd_qfma(out[i].get(), a[i].getconst(), b[i].getconst(), addend[i].getconst(), c.getconst(), &status);
+    }
+    c.raise(status);
+}
+
+/* Overloads without context follow arithmetic operators: thread context for precision_policy::fixed,
+ * for precision_policy::operand_digits precision is max(digits) of operands, sum and dot add room for carries
+ * and dot for full products, so values with same exponent are summed exactly */
+
+/// \brief Sum of n values, with precision of arithmetic operators
+template<mpd_ssize_t N>
+basic_bigdecimal<N> sum(const basic_bigdecimal<N>* values, size_t n) {
+    if (context.policy() == precision_policy::fixed) {
+        return sum(values, n, context);
+    }
+    bd_context c = detail::operand_context(detail::max_digits(values, n) + detail::count_digits(n));
+    return sum(values, n, c);
+}
+
+/// \brief Dot product of n values, with precision of arithmetic operators
+template<mpd_ssize_t N>
+basic_bigdecimal<N> dot(const basic_bigdecimal<N>* a, const basic_bigdecimal<N>* b, size_t n) {
+    if (context.policy() == precision_policy::fixed) {
+        return dot(a, b, n, context);
+    }
+    const mpd_ssize_t digits = detail::max_digits(a, n) + detail::max_digits(b, n);
+    bd_context c = detail::operand_context(digits + detail::count_digits(n));
+    return dot(a, b, n, c);
+}
+
+/// \brief Multiplies n values by factor in place, with precision of operator*=
+template<mpd_ssize_t N>
+void scale(basic_bigdecimal<N>* values, size_t n, const basic_bigdecimal<N>& factor) {
+    if (context.policy() == precision_policy::fixed) {
+        scale(values, n, factor, context);
+        return;
+    }
+    mpd_context_t ctx = OPERAND_CONTEXT;
+    uint32_t status = 0;
+    for (size_t i = 0; i < n; i++) {
+        const mpd_ssize_t digits = std::max(values[i].getconst()->digits, factor.getconst()->digits);
+        ctx.prec = std::min<mpd_ssize_t>(std::max<mpd_ssize_t>(digits, 1), MPD_MAX_PREC);
+        mpd_qmul(values[i].get(), values[i].getconst(), factor.getconst(), &ctx, &status);
+    }
+    bd_context(ctx).raise(status);
+}
+
+/// \brief out[i] = a[i] * b[i] + addend[i] for n values, precision is max(digits) of three operands
+/// for precision_policy::operand_digits
+template<mpd_ssize_t N>
+void fma_n(basic_bigdecimal<N>* out,
+           const basic_bigdecimal<N>* a,
+           const basic_bigdecimal<N>* b,
+           const basic_bigdecimal<N>* addend,
+           size_t n) {
+    if (context.policy() == precision_policy::fixed) {
+        fma_n(out, a, b, addend, n, context);
+        return;
+    }
+    mpd_context_t ctx = OPERAND_CONTEXT;
+    uint32_t status = 0;
+    for (size_t i = 0; i < n; i++) {
+        const mpd_ssize_t digits = std::max({a[i].getconst()->digits, b[i].getconst()->digits, addend[i].getconst()->digits});
+        ctx.prec = std::min<mpd_ssize_t>(std::max<mpd_ssize_t>(digits, 1), MPD_MAX_PREC);
+        mpd_qfma(out[i].get(), a[i].getconst(), b[i].getconst(), addend[i].getconst(), &ctx, &status);
+    }
+    bd_context(ctx).raise(status);
+}
+
+/* std::vector overloads */
+
+template<mpd_ssize_t N, typename... Context>
+basic_bigdecimal<N> sum(const std::vector<basic_bigdecimal<N>>& values, Context&... c) {
+    return sum(values.data(), values.size(), c...);
+}
+
+/// \throws value_error if sizes of a and b differ
+template<mpd_ssize_t N, typename... Context>
+basic_bigdecimal<N> dot(const std::vector<basic_bigdecimal<N>>& a, const std::vector<basic_bigdecimal<N>>& b, Context&... c) {
+    if (a.size() != b.size()) {
+        throw value_error("dot product of vectors with different sizes");
+    }
+    return dot(a.data(), b.data(), a.size(), c...);
+}
+
+template<mpd_ssize_t N, typename... Context>
+void scale(std::vector<basic_bigdecimal<N>>& values, const basic_bigdecimal<N>& factor, Context&... c) {
+    scale(values.data(), values.size(), factor, c...);
+}
+
+/// \throws value_error if sizes of vectors differ, out is resized to size of operands
+template<mpd_ssize_t N, typename... Context>
+void fma_n(std::vector<basic_bigdecimal<N>>& out,
+           const std::vector<basic_bigdecimal<N>>& a,
+           const std::vector<basic_bigdecimal<N>>& b,
+           const std::vector<basic_bigdecimal<N>>& addend,
+           Context&... c) {
+    if (a.size() != b.size() || a.size() != addend.size()) {
+        throw value_error("fma of vectors with different sizes");
+    }
+    out.resize(a.size());
+    fma_n(out.data(), a.data(), b.data(), addend.data(), a.size(), c...);
+}
+
+} // namespace batch
+} // namespace bigmath
+
+#endif //BIGMATHPP_BATCH_H
@@ -11,6 +11,7 @@
 
 #include "bigmath_config.h"
 #include "mpdecimal_backport.h"
+#include "stats.h"
 #include "utils.h"
 
 namespace bigmath {
@@ -20,6 +21,15 @@ namespace bigmath {
 /******************************************************************************/
 
 class bd_context;
+class deferred_traps;
+
+/// \brief Defines how bigdecimal arithmetic operators (+, -, *, /, +=, *=, /=) choose precision
+enum class precision_policy {
+    /// precision is max(digits) of both operands, result keeps all significant digits of the widest operand
+    operand_digits,
+    /// precision, rounding and traps are taken from the thread context bigmath::context
+    fixed,
+};
 
 BIGMATHPP_API extern bd_context context_template;
 BIGMATHPP_API extern thread_local bd_context context;
@@ -27,7 +37,16 @@ BIGMATHPP_API extern thread_local bd_context context;
 class BIGMATHPP_API bd_context {
 private:
     mpd_context_t ctx;
+    precision_policy m_policy = precision_policy::operand_digits;
+    /* deferred trap state, see bigmath::deferred_traps. Not copied with context */
+    bool m_deferring = false;
+    uint32_t m_pending = 0;
+    uint64_t m_ops = 0;
+    uint64_t m_first_pending = 0;
+
+    friend class deferred_traps;
     static void raiseit(const uint32_t status);
+    void on_trap(const uint32_t active_traps);
 
 public:
     /* Constructors and destructors */
@@ -71,6 +90,11 @@ public:
     int64_t etiny() const;
     int64_t etop() const;
 
+    /// \brief returns precision policy of arithmetic operators
+    /// \see bigmath::precision_policy
+    /// \return precision_policy
+    precision_policy policy() const;
+
     /* set individual fields */
     ALWAYS_INLINE void prec(mpd_ssize_t v) {
         if (!mpd_qsetprec(&ctx, v)) {
@@ -123,12 +147,18 @@ public:
         }
     }
 
+    ALWAYS_INLINE void policy(precision_policy v) {
+        m_policy = v;
+    }
+
     /* add flags to status and raise an exception if a relevant trap is active */
     ALWAYS_INLINE void raise(uint32_t flags) {
         ctx.status |= (flags & ~MPD_Malloc_error);
         const uint32_t active_traps = flags & (ctx.traps | MPD_Malloc_error);
+        m_ops++;
+        BIGMATH_STATS_ADD(RAISES);
         if (active_traps) {
-            raiseit(active_traps);
+            on_trap(active_traps);
         }
     }
 
@@ -178,6 +208,118 @@ public:
     friend std::ostream& operator<<(std::ostream& os, const bd_context& c);
 };
 
+/// \brief Defers traps of context for its lifetime: operations only accumulate status flags, and trapped
+/// flags are raised once, when guard is destroyed, as single exception with union of flags and index of
+/// first operation that set them.
+///
+/// Only operations that report status to the guarded context are deferred: functions with context argument
+/// and arithmetic operators with precision_policy::fixed. Operators with precision_policy::operand_digits and
+/// copies of context still trap immediately. Malloc error is never deferred.
+/// \code
+/// {
+///     bigmath::deferred_traps guard;
+///     for (auto& v : values) {
+///         v = v.div(divisor); // no exception here
+///     }
+/// } // throws bigmath::division_by_zero if any of divisors was zero
+/// \endcode
+class BIGMATHPP_API deferred_traps {
+public:
+    static constexpr uint64_t npos = UINT64_MAX;
+
+    explicit deferred_traps(bd_context& c = context);
+    deferred_traps(const deferred_traps& other) = delete;
+    deferred_traps& operator=(const deferred_traps& other) = delete;
+    /// \throws bigdecimal_exception for pending flags, unless dismissed or destroyed by stack unwinding
+    ~deferred_traps() noexcept(false);
+
+    /// \brief Trapped flags set since guard was created (or since last check()). For nested guards on the
+    /// same context, pending() and first_index() of outer guard are valid only outside of inner guard
+    uint32_t pending() const noexcept;
+    /// \brief Zero-based index of first operation that set pending flag, counted from guard creation.
+    /// npos if nothing is pending
+    uint64_t first_index() const noexcept;
+    /// \brief Number of operations that reported status to context since guard was created
+    uint64_t count() const noexcept;
+
+    /// \brief Raises pending flags now, as destructor would do, and continues deferring
+    void check();
+    /// \brief Stops deferring and drops pending flags without exception. Flags remain in context status
+    void dismiss() noexcept;
+
+private:
+    bd_context& m_ctx;
+    bool m_active = true;
+    bool m_saved_deferring;
+    uint32_t m_saved_pending;
+    uint64_t m_saved_first;
+    uint64_t m_base;
+    int m_uncaught;
+
+    void restore(bool merge) noexcept;
+};
+
+/// \brief Overrides thread context bigmath::context for its lifetime and restores previous one on exit.
+/// Methods with default context argument and fixed policy operators use overridden context. Nested scopes
+/// save previous context on stack of the caller, restore is plain copy without validation.
+///
+/// Status is shared with enclosing code: flags raised inside scope remain in context after restore.
+/// \code
+/// {
+///     bigmath::context_scope scope(38);
+///     r = a.div(b); // 38 digits
+/// }
+/// \endcode
+class context_scope {
+public:
+    /// \brief Installs all fields of c except status, including precision policy
+    explicit context_scope(const bd_context& c)
+        : context_scope() {
+        mpd_context_t* cur = m_ctx.get();
+        const uint32_t status = cur->status;
+        *cur = *c.getconst();
+        cur->status = status;
+        m_ctx.policy(c.policy());
+    }
+    /// \brief Changes precision only. Note that operators use it only with precision_policy::fixed
+    explicit context_scope(mpd_ssize_t prec)
+        : context_scope() {
+        m_ctx.prec(prec);
+    }
+    context_scope(mpd_ssize_t prec, precision_policy policy)
+        : context_scope(prec) {
+        m_ctx.policy(policy);
+    }
+    context_scope(const context_scope& other) = delete;
+    context_scope& operator=(const context_scope& other) = delete;
+
+    ~context_scope() noexcept {
+        mpd_context_t* cur = m_ctx.get();
+        m_saved.status = cur->status;
+        *cur = m_saved;
+        m_ctx.policy(m_saved_policy);
+    }
+
+private:
+    /* thread context is looked up once */
+    bd_context& m_ctx;
+    mpd_context_t m_saved;
+    precision_policy m_saved_policy;
+
+    context_scope()
+        : m_ctx(context),
+          m_saved(*m_ctx.getconst()),
+          m_saved_policy(m_ctx.policy()) {
+    }
+};
+
+/// \brief Calls fn() with thread context overridden by c, returns its result
+template<typename Fn>
+decltype(auto) with_context(const bd_context& c, Fn&& fn) {
+    context_scope scope(c);
+    return fn();
+}
+
 BIGMATHPP_API bd_context MaxContext();
 BIGMATHPP_API bd_context IEEEContext(int bits);
 
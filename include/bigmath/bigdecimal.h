@@ -33,24 +33,30 @@
 #define BIGMATHPP_MPDECIMAL_H
 
 #include "bd_context.h"
+#include "bigdecimal_fwd.h"
 #include "bigint.h"
 #include "errors.h"
 #include "mpdecimal_backport.h"
+#include "static_context.h"
 #include "utils.h"
 
 #include <algorithm>
 #include <atomic>
 #include <cassert>
+#include <charconv>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <exception>
 #include <iostream>
 #include <limits>
 #include <memory>
 #include <sstream>
 #include <string>
+#include <string_view>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 #undef isfinite    /* math.h */
 #undef isnan       /* math.h */
@@ -63,18 +69,49 @@
 
 namespace bigmath {
 
-constexpr mpd_ssize_t MINALLOC = 4;
+/* Template for contexts of arithmetic operators with precision_policy::operand_digits, only prec differs. */
+constexpr mpd_context_t OPERAND_CONTEXT{
+    1,                          /* prec */
+    MPD_MAX_EMAX,               /* emax */
+    MPD_MIN_EMIN,               /* emin */
+    MPD_IEEE_Invalid_operation, /* traps */
+    0,                          /* status */
+    0,                          /* newtrap */
+    MPD_ROUND_HALF_EVEN,        /* round */
+    0,                          /* clamp */
+    0                           /* allcr */
+};
+
+namespace detail {
+/* fixed-point output precision values */
+constexpr int FMT_ALL_DIGITS = -1;
+constexpr int FMT_NOT_FIXED = -2;
+
+/* precision of "f" (FMT_ALL_DIGITS) or ".<precision>f" format, FMT_NOT_FIXED for others */
+BIGMATHPP_API int fixed_precision(const char* fmt);
+BIGMATHPP_API std::to_chars_result to_chars_fixed(char* first, char* last, const mpd_t* a, int precision, const bd_context& c);
+BIGMATHPP_API void append_fixed(std::string& out, const mpd_t* a, int precision, const bd_context& c);
+} // namespace detail
+
+/// \brief Decimal number with coefficient of up to InlineWords words (19 digits each) stored inside the object.
+/// Larger coefficients spill to heap. bigmath::bigdecimal is basic_bigdecimal<MINALLOC> (76 digits),
+/// smaller capacity makes objects smaller, larger one avoids heap for long values.
+template<mpd_ssize_t InlineWords>
+class basic_bigdecimal {
+    static_assert(InlineWords >= MINALLOC_MIN, "inline coefficient can't be smaller than MPD_MINALLOC_MIN words");
 
-class BIGMATHPP_API bigdecimal {
 private:
-    mpd_uint_t data[MINALLOC] = {0};
+    template<mpd_ssize_t>
+    friend class basic_bigdecimal;
+
+    mpd_uint_t data[InlineWords] = {0};
 
     mpd_t value{
         MPD_STATIC | MPD_STATIC_DATA | MPD_SNAN, /* flags */
         0,                                       /* exp */
         0,                                       /* digits */
         0,                                       /* len */
-        MINALLOC,                                /* alloc */
+        InlineWords,                             /* alloc */
         data                                     /* data */
     };
 
@@ -92,11 +129,31 @@ private:
             0,                                       /* exp */
             0,                                       /* digits */
             0,                                       /* len */
-            MINALLOC,                                /* alloc */
+            InlineWords,                             /* alloc */
             data                                     /* data */
         };
     }
 
+    /* counts coefficient that moved from inline buffer to heap during operation, see stats::counters */
+    ALWAYS_INLINE void count_spill(const bool was_inline) const {
+        if (was_inline && mpd_isdynamic_data(&value)) {
+            BIGMATH_STATS_ADD(DECIMAL_SPILLS);
+        }
+    }
+
+    /* mpd_qcopy_cxx that counts spill. mpdecimal 2.4 copies through bigmath::mpd_switch_to_dyn_cxx,
+     * that counts it itself, newer versions allocate inside of libmpdec */
+    ALWAYS_INLINE int copy_counted(const mpd_t* const src) {
+#if (MPD_MINOR_VERSION == 4)
+        return mpd_qcopy_cxx(&value, src);
+#else
+        const bool was_inline = isstatic();
+        const int ok = mpd_qcopy_cxx(&value, src);
+        count_spill(was_inline);
+        return ok;
+#endif
+    }
+
     /* Copy flags, preserving memory attributes of result. */
     ALWAYS_INLINE
     uint8_t copy_flags(const uint8_t rflags, const uint8_t aflags) {
@@ -104,24 +161,32 @@ private:
                (aflags & ~(MPD_STATIC | MPD_DATAFLAGS));
     }
 
+    /* copy of len words, without resizing result if it has enough room */
+    ALWAYS_INLINE
+    void copy_words(const mpd_t* const src, const bool fastcopy) {
+        if (fastcopy && isstatic()) {
+            // whole inline array, fixed size copy is cheaper than len-dependent one
+            for (mpd_ssize_t i = 0; i < InlineWords; i++) {
+                data[i] = src->data[i];
+            }
+        } else {
+            std::memcpy(value.data, src->data, size_t(src->len) * sizeof(mpd_uint_t));
+        }
+        value.flags = copy_flags(value.flags, src->flags);
+        value.exp = src->exp;
+        value.digits = src->digits;
+        value.len = src->len;
+    }
+
+    /* fastcopy: src data is its inline array of InlineWords words */
     ALWAYS_INLINE
     void copy_value(const mpd_t* const src, const bool fastcopy) {
         assert(mpd_isstatic(&value));
         assert(mpd_isstatic(src));
-        assert(value.alloc >= MINALLOC);
-        assert(src->alloc >= MINALLOC);
-        assert(MPD_MINALLOC == MINALLOC);
-        if (fastcopy) {
-            value.data[0] = src->data[0];
-            value.data[1] = src->data[1];
-            value.data[2] = src->data[2];
-            value.data[3] = src->data[3];
-            value.flags = copy_flags(value.flags, src->flags);
-            value.exp = src->exp;
-            value.digits = src->digits;
-            value.len = src->len;
+        if (src->len <= value.alloc) {
+            copy_words(src, fastcopy);
         } else {
-            if (!mpd_qcopy_cxx(&value, src)) {
+            if (!copy_counted(src)) {
                 context.raise(MPD_Malloc_error);
             }
         }
@@ -133,19 +198,9 @@ private:
             return;
         }
         assert(mpd_isstatic(&value));
-        assert(mpd_isstatic(src));
-        assert(value.alloc >= MINALLOC);
-        assert(src->alloc >= MINALLOC);
-        assert(MPD_MINALLOC == MINALLOC);
         if (fastcopy) {
-            value.data[0] = src->data[0];
-            value.data[1] = src->data[1];
-            value.data[2] = src->data[2];
-            value.data[3] = src->data[3];
-            value.flags = copy_flags(value.flags, src->flags);
-            value.exp = src->exp;
-            value.digits = src->digits;
-            value.len = src->len;
+            /* heap buffer of value can be smaller than inline array of src */
+            copy_value(src, fastcopy);
         } else {
             assert(mpd_isdynamic_data(src));
             if (mpd_isdynamic_data(&value)) {
@@ -157,9 +212,9 @@ private:
         }
     }
 
-    ALWAYS_INLINE bigdecimal unary_func_status(
+    ALWAYS_INLINE basic_bigdecimal unary_func_status(
         int (*func)(mpd_t*, const mpd_t*, uint32_t*)) const {
-        bigdecimal result;
+        basic_bigdecimal result;
         uint32_t status = 0;
         if (!func(result.get(), getconst(), &status)) {
             throw malloc_error("out of memory");
@@ -167,80 +222,140 @@ private:
         return result;
     }
 
-    ALWAYS_INLINE bigdecimal unary_func(
+    ALWAYS_INLINE basic_bigdecimal unary_func(
         void (*func)(mpd_t*, const mpd_t*, const mpd_context_t*, uint32_t*),
         bd_context& c = context) const {
-        bigdecimal result;
+        basic_bigdecimal result;
         uint32_t status = 0;
+        BIGMATH_STATS_OP(func);
         func(result.get(), getconst(), c.getconst(), &status);
+        result.count_spill(true);
         c.raise(status);
         return result;
     }
 
-    ALWAYS_INLINE bigdecimal binary_func_noctx(
+    ALWAYS_INLINE basic_bigdecimal binary_func_noctx(
         int (*func)(mpd_t*, const mpd_t*, const mpd_t*),
-        const bigdecimal& other) const {
-        bigdecimal result;
+        const basic_bigdecimal& other) const {
+        basic_bigdecimal result;
         (void) func(result.get(), getconst(), other.getconst());
         return result;
     }
 
-    ALWAYS_INLINE bigdecimal int_binary_func(
+    ALWAYS_INLINE basic_bigdecimal int_binary_func(
         int (*func)(mpd_t*, const mpd_t*, const mpd_t*, const mpd_context_t*, uint32_t*),
-        const bigdecimal& other,
+        const basic_bigdecimal& other,
         bd_context& c = context) const {
-        bigdecimal result;
+        basic_bigdecimal result;
         uint32_t status = 0;
+        BIGMATH_STATS_OP(func);
         (void) func(result.get(), getconst(), other.getconst(), c.getconst(), &status);
+        result.count_spill(true);
         c.raise(status);
         return result;
     }
 
-    ALWAYS_INLINE bigdecimal binary_func(
+    ALWAYS_INLINE basic_bigdecimal binary_func(
         void (*func)(mpd_t*, const mpd_t*, const mpd_t*, const mpd_context_t*, uint32_t*),
-        const bigdecimal& other,
+        const basic_bigdecimal& other,
         bd_context& c = context) const {
-        bigdecimal result;
+        basic_bigdecimal result;
         uint32_t status = 0;
+        BIGMATH_STATS_OP(func);
         func(result.get(), getconst(), other.getconst(), c.getconst(), &status);
+        result.count_spill(true);
         c.raise(status);
         return result;
     }
 
-    ALWAYS_INLINE bigdecimal binary_func(
+    ENABLE_IF_STATIC_CONTEXT(Ctx)
+    ALWAYS_INLINE basic_bigdecimal unary_func(
+        void (*func)(mpd_t*, const mpd_t*, const mpd_context_t*, uint32_t*),
+        Ctx) const {
+        basic_bigdecimal result;
+        uint32_t status = 0;
+        BIGMATH_STATS_OP(func);
+        func(result.get(), getconst(), Ctx::getconst(), &status);
+        result.count_spill(true);
+        Ctx::raise(status);
+        return result;
+    }
+
+    ENABLE_IF_STATIC_CONTEXT(Ctx)
+    ALWAYS_INLINE basic_bigdecimal binary_func(
+        void (*func)(mpd_t*, const mpd_t*, const mpd_t*, const mpd_context_t*, uint32_t*),
+        const basic_bigdecimal& other,
+        Ctx) const {
+        basic_bigdecimal result;
+        uint32_t status = 0;
+        BIGMATH_STATS_OP(func);
+        func(result.get(), getconst(), other.getconst(), Ctx::getconst(), &status);
+        result.count_spill(true);
+        Ctx::raise(status);
+        return result;
+    }
+
+    ALWAYS_INLINE basic_bigdecimal binary_func(
         // func
         void (*func)(mpd_t*, const mpd_t*, const mpd_t*, const mpd_context_t*, uint32_t*),
         // other
-        const bigdecimal& other,
+        const basic_bigdecimal& other,
         // context
         bd_context&& c) const {
-        bigdecimal result;
+        basic_bigdecimal result;
         uint32_t status = 0;
+        BIGMATH_STATS_OP(func);
         func(result.get(), getconst(), other.getconst(), c.getconst(), &status);
+        result.count_spill(true);
         c.raise(status);
         return result;
     }
-    ALWAYS_INLINE bigdecimal& inplace_binary_func_move_ctx(
+    ALWAYS_INLINE basic_bigdecimal& inplace_binary_func_move_ctx(
         void (*func)(mpd_t*, const mpd_t*, const mpd_t*, const mpd_context_t*, uint32_t*),
-        const bigdecimal& other,
+        const basic_bigdecimal& other,
         bd_context&& c) {
         uint32_t status = 0;
+        const bool was_inline = isstatic();
+        BIGMATH_STATS_OP(func);
         func(get(), getconst(), other.getconst(), c.getconst(), &status);
+        count_spill(was_inline);
         c.raise(status);
         return *this;
     }
 
-    ALWAYS_INLINE bigdecimal& inplace_binary_func(
+    ALWAYS_INLINE basic_bigdecimal& inplace_binary_func(
         void (*func)(mpd_t*, const mpd_t*, const mpd_t*, const mpd_context_t*, uint32_t*),
-        const bigdecimal& other,
+        const basic_bigdecimal& other,
         bd_context& c = context) {
         uint32_t status = 0;
+        const bool was_inline = isstatic();
+        BIGMATH_STATS_OP(func);
         func(get(), getconst(), other.getconst(), c.getconst(), &status);
+        count_spill(was_inline);
         c.raise(status);
         return *this;
     }
 
-    ALWAYS_INLINE bigdecimal inplace_shiftl(const int64_t n, bd_context& c = context) {
+    /* arithmetic operators: precision depends on bigmath::precision_policy of the thread context */
+    ALWAYS_INLINE basic_bigdecimal arith_func(
+        void (*func)(mpd_t*, const mpd_t*, const mpd_t*, const mpd_context_t*, uint32_t*),
+        const basic_bigdecimal& other) const {
+        if (context.policy() == precision_policy::fixed) {
+            return binary_func(func, other, context);
+        }
+        return binary_func(func, other, calc_precision(*this, other));
+    }
+
+    ALWAYS_INLINE basic_bigdecimal& inplace_arith_func(
+        void (*func)(mpd_t*, const mpd_t*, const mpd_t*, const mpd_context_t*, uint32_t*),
+        const basic_bigdecimal& other) {
+        if (context.policy() == precision_policy::fixed) {
+            return inplace_binary_func(func, other, context);
+        }
+        return inplace_binary_func_move_ctx(func, other, calc_precision(*this, other));
+    }
+
+    ALWAYS_INLINE basic_bigdecimal inplace_shiftl(const int64_t n, bd_context& c = context) {
         uint32_t status = 0;
         mpd_ssize_t nn = bigmath::safe_downcast<mpd_ssize_t, int64_t>(n);
         mpd_qshiftl(get(), getconst(), nn, &status);
@@ -248,7 +363,7 @@ private:
         return *this;
     }
 
-    ALWAYS_INLINE bigdecimal inplace_shiftr(const int64_t n, bd_context& c = context) {
+    ALWAYS_INLINE basic_bigdecimal inplace_shiftr(const int64_t n, bd_context& c = context) {
         uint32_t status = 0;
         mpd_ssize_t nn = bigmath::safe_downcast<mpd_ssize_t, int64_t>(n);
         mpd_qshiftr(get(), getconst(), nn, &status);
@@ -262,17 +377,17 @@ public:
     /***********************************************************************/
 
     /* Implicit */
-    bigdecimal() {
+    basic_bigdecimal() {
     }
-    bigdecimal(const bigdecimal& other) {
+    basic_bigdecimal(const basic_bigdecimal& other) {
         *this = other;
     }
-    bigdecimal(bigdecimal&& other) noexcept {
+    basic_bigdecimal(basic_bigdecimal&& other) noexcept {
         *this = std::move(other);
     }
 
     ENABLE_IF_SIGNED(T)
-    explicit bigdecimal(const T& other) {
+    explicit basic_bigdecimal(const T& other) {
         ASSERT_SIGNED(T);
         uint32_t status = 0;
         mpd_qset_i64_exact(&value, other, &status);
@@ -280,39 +395,52 @@ public:
     }
 
     ENABLE_IF_UNSIGNED(T)
-    explicit bigdecimal(const T& other) {
+    explicit basic_bigdecimal(const T& other) {
         ASSERT_UNSIGNED(T);
         uint32_t status = 0;
         mpd_qset_u64_exact(&value, other, &status);
         context.raise(status);
     }
 
-    explicit bigdecimal(double value) {
+    explicit basic_bigdecimal(double value) {
         std::stringstream ss;
         ss << value;
         set_str(ss.str());
     }
 
     /* Explicit */
-    explicit bigdecimal(const char* const s) {
+    explicit basic_bigdecimal(const char* const s) {
         if (s == nullptr) {
             throw value_error("bigdecimal: string argument in constructor is NULL");
         }
         set_str(s);
     }
 
-    explicit bigdecimal(const std::string& s) {
+    explicit basic_bigdecimal(const std::string& s) {
         set_str(s);
     }
 
-    explicit bigdecimal(const bigmath::bigint& s) {
-        set_str(s.str());
+    explicit basic_bigdecimal(std::string_view s) {
+        set_str(s);
+    }
+
+    /// \brief Exact conversion with the same digits as for integer string: "123" becomes 123.0
+    explicit basic_bigdecimal(const bigmath::bigint& s) {
+        detail::bigint_to_decimal(&value, s);
+    }
+
+    /// \brief Exact conversion from decimal with other inline capacity
+    template<mpd_ssize_t OtherWords>
+    explicit basic_bigdecimal(const basic_bigdecimal<OtherWords>& other) {
+        if (!copy_counted(other.getconst())) {
+            context.raise(MPD_Malloc_error);
+        }
     }
 
     /***********************************************************************/
     /*                inexact_error conversions that use a context               */
     /***********************************************************************/
-    explicit bigdecimal(const bigdecimal& other, bd_context& c) {
+    explicit basic_bigdecimal(const basic_bigdecimal& other, bd_context& c) {
         const mpd_context_t* ctx = c.getconst();
 
         *this = other;
@@ -329,7 +457,7 @@ public:
     }
 
     ENABLE_IF_SIGNED(T)
-    explicit bigdecimal(const T& other, bd_context& c) {
+    explicit basic_bigdecimal(const T& other, bd_context& c) {
         ASSERT_SIGNED(T);
         uint32_t status = 0;
         mpd_qset_i64(&value, other, c.getconst(), &status);
@@ -337,14 +465,14 @@ public:
     }
 
     ENABLE_IF_UNSIGNED(T)
-    explicit bigdecimal(const T& other, bd_context& c) {
+    explicit basic_bigdecimal(const T& other, bd_context& c) {
         ASSERT_UNSIGNED(T);
         uint32_t status = 0;
         mpd_qset_u64(&value, other, c.getconst(), &status);
         c.raise(status);
     }
 
-    explicit bigdecimal(const char* const s, bd_context& c) {
+    explicit basic_bigdecimal(const char* const s, bd_context& c) {
         uint32_t status = 0;
         if (s == nullptr) {
             throw value_error("bigdecimal: string argument in constructor is NULL");
@@ -353,7 +481,7 @@ public:
         c.raise(status);
     }
 
-    explicit bigdecimal(const std::string& s, bd_context& c) {
+    explicit basic_bigdecimal(const std::string& s, bd_context& c) {
         uint32_t status = 0;
         mpd_qset_string(&value, s.c_str(), c.getconst(), &status);
         c.raise(status);
@@ -373,12 +501,12 @@ public:
         return mpd_isnegative(&value) ? -1 : 1;
     }
 
-    ALWAYS_INLINE bigdecimal coeff() const {
+    ALWAYS_INLINE basic_bigdecimal coeff() const {
         if (isspecial()) {
             throw value_error("coefficient is undefined for special values");
         }
 
-        bigdecimal result = *this;
+        basic_bigdecimal result = *this;
         mpd_set_positive(&result.value);
         result.value.exp = 0;
         return result;
@@ -392,63 +520,67 @@ public:
         return value.exp;
     }
 
-    ALWAYS_INLINE bigdecimal payload() const {
+    ALWAYS_INLINE basic_bigdecimal payload() const {
         if (!isnan()) {
             throw value_error("payload is only defined for NaNs");
         }
         if (value.len == 0) {
-            return bigdecimal(0);
+            return basic_bigdecimal(0);
         }
 
-        bigdecimal result = *this;
+        basic_bigdecimal result = *this;
         mpd_set_flags(&result.value, 0);
         result.value.exp = 0;
         return result;
     }
 
     void set_str(const std::string& s) {
-        set_str(s.c_str());
+        set_str(std::string_view(s));
     }
 
     void set_str(const char* s) {
-        mpd_context_t maxcontext;
+        set_str(std::string_view(s));
+    }
 
-        uint32_t status = 0;
-        mpd_maxcontext(&maxcontext);
+    /// \brief Parses exact value in single pass, string doesn't have to be null-terminated.
+    /// Format is [sign] digits [. digits] [(e|E) [sign] digits]. Integer without point gets one zero digit
+    /// after point ("123" is 123.0) and can't have exponent, NaN and Infinity are not accepted.
+    /// \throws conversion_syntax_error if bigmath::context traps invalid operation (default)
+    void set_str(std::string_view s) {
+        detail::decimal_set_str(&value, s);
+    }
 
-        if (has_dec_point(s)) {
-            mpd_qset_string(&value, s, &maxcontext, &status);
-        } else {
-            auto ss = std::string(s);
-            ss += ".0";
-            mpd_qset_string(&value, ss.c_str(), &maxcontext, &status);
-        }
+    /// \brief Same as set_str(), for ranges of external buffers like JSON documents
+    static basic_bigdecimal from_chars(const char* first, const char* last) {
+        basic_bigdecimal result;
+        result.set_str(std::string_view(first, size_t(last - first)));
+        return result;
+    }
 
-        if (status & (MPD_Inexact | MPD_Rounded | MPD_Clamped)) {
-            /* we want exact results */
-            mpd_seterror(&value, MPD_Invalid_operation, &status);
-        }
-        status &= MPD_Errors;
-        context.raise(status);
+    static basic_bigdecimal from_chars(std::string_view s) {
+        basic_bigdecimal result;
+        result.set_str(s);
+        return result;
     }
 
     /***********************************************************************/
     /*                             Destructor                              */
     /***********************************************************************/
-    ~bigdecimal() {
-        if (value.data != data)
+    ~basic_bigdecimal() {
+        if (value.data != data) {
             mpd_del(&value);
+        }
     }
 
     /***********************************************************************/
     /*                         Assignment operators                        */
     /***********************************************************************/
-    ALWAYS_INLINE bigdecimal& operator=(const bigdecimal& other) {
+    ALWAYS_INLINE basic_bigdecimal& operator=(const basic_bigdecimal& other) {
         copy_value(other.getconst(), other.isstatic());
         return *this;
     }
 
-    ALWAYS_INLINE bigdecimal& operator=(bigdecimal&& other) noexcept {
+    ALWAYS_INLINE basic_bigdecimal& operator=(basic_bigdecimal&& other) noexcept {
         if (this != &other) {
             move_value(other.getconst(), other.isstatic());
             other.reset();
@@ -456,26 +588,26 @@ public:
         return *this;
     };
 
-    ALWAYS_INLINE bigdecimal& operator+=(const bigdecimal& other) {
-        return inplace_binary_func_move_ctx(mpd_qadd, other, calc_precision(*this, other));
+    ALWAYS_INLINE basic_bigdecimal& operator+=(const basic_bigdecimal& other) {
+        return inplace_arith_func(mpd_qadd, other);
     }
-    ALWAYS_INLINE bigdecimal& operator-=(const bigdecimal& other) {
+    ALWAYS_INLINE basic_bigdecimal& operator-=(const basic_bigdecimal& other) {
         return inplace_binary_func(mpd_qsub, other);
     }
-    ALWAYS_INLINE bigdecimal& operator*=(const bigdecimal& other) {
-        return inplace_binary_func_move_ctx(mpd_qmul, other, calc_precision(*this, other));
+    ALWAYS_INLINE basic_bigdecimal& operator*=(const basic_bigdecimal& other) {
+        return inplace_arith_func(mpd_qmul, other);
     }
-    ALWAYS_INLINE bigdecimal& operator/=(const bigdecimal& other) {
-        return inplace_binary_func_move_ctx(mpd_qdiv, other, calc_precision(*this, other));
+    ALWAYS_INLINE basic_bigdecimal& operator/=(const basic_bigdecimal& other) {
+        return inplace_arith_func(mpd_qdiv, other);
     }
-    ALWAYS_INLINE bigdecimal& operator%=(const bigdecimal& other) {
+    ALWAYS_INLINE basic_bigdecimal& operator%=(const basic_bigdecimal& other) {
         return inplace_binary_func(mpd_qrem, other);
     }
 
     /***********************************************************************/
     /*                         Comparison operators                        */
     /***********************************************************************/
-    ALWAYS_INLINE bool operator==(const bigdecimal& other) const {
+    ALWAYS_INLINE bool operator==(const basic_bigdecimal& other) const {
         uint32_t status = 0;
         const int r = mpd_qcmp(getconst(), other.getconst(), &status);
         if (r == INT_MAX) {
@@ -487,7 +619,7 @@ public:
         return r == 0;
     }
 
-    ALWAYS_INLINE bool operator!=(const bigdecimal& other) const {
+    ALWAYS_INLINE bool operator!=(const basic_bigdecimal& other) const {
         uint32_t status = 0;
         const int r = mpd_qcmp(getconst(), other.getconst(), &status);
         if (r == INT_MAX) {
@@ -499,7 +631,7 @@ public:
         return r != 0;
     }
 
-    ALWAYS_INLINE bool operator<(const bigdecimal& other) const {
+    ALWAYS_INLINE bool operator<(const basic_bigdecimal& other) const {
         uint32_t status = 0;
         const int r = mpd_qcmp(getconst(), other.getconst(), &status);
         if (r == INT_MAX) {
@@ -509,7 +641,7 @@ public:
         return r < 0;
     }
 
-    ALWAYS_INLINE bool operator<=(const bigdecimal& other) const {
+    ALWAYS_INLINE bool operator<=(const basic_bigdecimal& other) const {
         uint32_t status = 0;
         const int r = mpd_qcmp(getconst(), other.getconst(), &status);
         if (r == INT_MAX) {
@@ -519,7 +651,7 @@ public:
         return r <= 0;
     }
 
-    ALWAYS_INLINE bool operator>=(const bigdecimal& other) const {
+    ALWAYS_INLINE bool operator>=(const basic_bigdecimal& other) const {
         uint32_t status = 0;
         const int r = mpd_qcmp(getconst(), other.getconst(), &status);
         if (r == INT_MAX) {
@@ -529,7 +661,7 @@ public:
         return r >= 0;
     }
 
-    ALWAYS_INLINE bool operator>(const bigdecimal& other) const {
+    ALWAYS_INLINE bool operator>(const basic_bigdecimal& other) const {
         uint32_t status = 0;
         const int r = mpd_qcmp(getconst(), other.getconst(), &status);
         if (r == INT_MAX) {
@@ -542,42 +674,40 @@ public:
     /***********************************************************************/
     /*                      Unary arithmetic operators                     */
     /***********************************************************************/
-    ALWAYS_INLINE bigdecimal operator-() const {
+    ALWAYS_INLINE basic_bigdecimal operator-() const {
         return unary_func(mpd_qminus);
     }
-    ALWAYS_INLINE bigdecimal operator+() const {
+    ALWAYS_INLINE basic_bigdecimal operator+() const {
         return unary_func(mpd_qplus);
     }
 
     /***********************************************************************/
     /*                      Binary arithmetic operators                    */
     /***********************************************************************/
-    ALWAYS_INLINE bigdecimal operator+(const bigdecimal& other) const {
-        return binary_func(mpd_qadd, other, calc_precision(*this, other));
+    ALWAYS_INLINE basic_bigdecimal operator+(const basic_bigdecimal& other) const {
+        return arith_func(mpd_qadd, other);
     }
-    ALWAYS_INLINE bigdecimal operator-(const bigdecimal& other) const {
-        return binary_func(mpd_qsub, other, calc_precision(*this, other));
+    ALWAYS_INLINE basic_bigdecimal operator-(const basic_bigdecimal& other) const {
+        return arith_func(mpd_qsub, other);
     }
-    ALWAYS_INLINE bigdecimal operator*(const bigdecimal& other) const {
-        return binary_func(mpd_qmul, other, calc_precision(*this, other));
+    ALWAYS_INLINE basic_bigdecimal operator*(const basic_bigdecimal& other) const {
+        return arith_func(mpd_qmul, other);
     }
-    ALWAYS_INLINE bigdecimal operator/(const bigdecimal& other) const {
-        return binary_func(mpd_qdiv, other, calc_precision(*this, other));
+    ALWAYS_INLINE basic_bigdecimal operator/(const basic_bigdecimal& other) const {
+        return arith_func(mpd_qdiv, other);
     }
-    ALWAYS_INLINE bigdecimal operator%(const bigdecimal& other) const {
+    ALWAYS_INLINE basic_bigdecimal operator%(const basic_bigdecimal& other) const {
         return binary_func(mpd_qrem, other);
     }
 
-    bd_context calc_precision(const bigdecimal& a, const bigdecimal& b) const {
-        bd_context maxcontext{
-            std::max(a.getconst()->digits, b.getconst()->digits),
-            MPD_MAX_EMAX,
-            MPD_MIN_EMIN,
-            MPD_ROUND_HALF_EVEN,
-            MPD_IEEE_Invalid_operation,
-            0,
-            0};
-        return maxcontext;
+    /// \brief Context for precision_policy::operand_digits: prec is max(digits) of operands
+    /// Built from a constant template without validating setters, as it's called on every operator
+    ALWAYS_INLINE bd_context calc_precision(const basic_bigdecimal& a, const basic_bigdecimal& b) const {
+        mpd_context_t ctx = OPERAND_CONTEXT;
+        const mpd_ssize_t digits = std::max(a.getconst()->digits, b.getconst()->digits);
+        /* digits are 0 for NaN payload-less values, keep prec in valid range [1, MAX_PREC] */
+        ctx.prec = std::min<mpd_ssize_t>(std::max<mpd_ssize_t>(digits, 1), MPD_MAX_PREC);
+        return bd_context(ctx);
     }
 
     /***********************************************************************/
@@ -634,16 +764,16 @@ public:
         return mpd_adjexp(getconst());
     }
 
-    ALWAYS_INLINE bigdecimal canonical() const {
+    ALWAYS_INLINE basic_bigdecimal canonical() const {
         return *this;
     }
-    ALWAYS_INLINE bigdecimal copy() const {
+    ALWAYS_INLINE basic_bigdecimal copy() const {
         return unary_func_status(mpd_qcopy);
     }
-    ALWAYS_INLINE bigdecimal copy_abs() const {
+    ALWAYS_INLINE basic_bigdecimal copy_abs() const {
         return unary_func_status(mpd_qcopy_abs);
     }
-    ALWAYS_INLINE bigdecimal copy_negate() const {
+    ALWAYS_INLINE basic_bigdecimal copy_negate() const {
         return unary_func_status(mpd_qcopy_negate);
     }
 
@@ -652,61 +782,63 @@ public:
         return mpd_class(getconst(), c.getconst());
     }
 
-    ALWAYS_INLINE bigdecimal abs(bd_context& c = context) const {
+    ALWAYS_INLINE basic_bigdecimal abs(bd_context& c = context) const {
         return unary_func(mpd_qabs, c);
     }
-    ALWAYS_INLINE bigdecimal ceil(bd_context& c = context) const {
+    ALWAYS_INLINE basic_bigdecimal ceil(bd_context& c = context) const {
         return unary_func(mpd_qceil, c);
     }
-    ALWAYS_INLINE bigdecimal exp(bd_context& c = context) const {
+    ALWAYS_INLINE basic_bigdecimal exp(bd_context& c = context) const {
         return unary_func(mpd_qexp, c);
     }
-    ALWAYS_INLINE bigdecimal floor(bd_context& c = context) const {
+    ALWAYS_INLINE basic_bigdecimal floor(bd_context& c = context) const {
         return unary_func(mpd_qfloor, c);
     }
-    ALWAYS_INLINE bigdecimal invroot(bd_context& c = context) const {
+    ALWAYS_INLINE basic_bigdecimal invroot(bd_context& c = context) const {
         return unary_func(mpd_qinvroot, c);
     }
-    ALWAYS_INLINE bigdecimal logical_invert(bd_context& c = context) const {
+    ALWAYS_INLINE basic_bigdecimal logical_invert(bd_context& c = context) const {
         return unary_func(mpd_qinvert, c);
     }
-    ALWAYS_INLINE bigdecimal ln(bd_context& c = context) const {
+    ALWAYS_INLINE basic_bigdecimal ln(bd_context& c = context) const {
         return unary_func(mpd_qln, c);
     }
-    ALWAYS_INLINE bigdecimal log10(bd_context& c = context) const {
+    ALWAYS_INLINE basic_bigdecimal log10(bd_context& c = context) const {
         return unary_func(mpd_qlog10, c);
     }
-    ALWAYS_INLINE bigdecimal logb(bd_context& c = context) const {
+    ALWAYS_INLINE basic_bigdecimal logb(bd_context& c = context) const {
         return unary_func(mpd_qlogb, c);
     }
-    ALWAYS_INLINE bigdecimal minus(bd_context& c = context) const {
+    ALWAYS_INLINE basic_bigdecimal minus(bd_context& c = context) const {
         return unary_func(mpd_qminus, c);
     }
-    ALWAYS_INLINE bigdecimal next_minus(bd_context& c = context) const {
+    ALWAYS_INLINE basic_bigdecimal next_minus(bd_context& c = context) const {
         return unary_func(mpd_qnext_minus, c);
     }
-    ALWAYS_INLINE bigdecimal next_plus(bd_context& c = context) const {
+    ALWAYS_INLINE basic_bigdecimal next_plus(bd_context& c = context) const {
         return unary_func(mpd_qnext_plus, c);
     }
-    ALWAYS_INLINE bigdecimal plus(bd_context& c = context) const {
+    ALWAYS_INLINE basic_bigdecimal plus(bd_context& c = context) const {
         return unary_func(mpd_qplus, c);
     }
-    ALWAYS_INLINE bigdecimal reduce(bd_context& c = context) const {
+    ALWAYS_INLINE basic_bigdecimal reduce(bd_context& c = context) const {
         return unary_func(mpd_qreduce, c);
     }
-    ALWAYS_INLINE bigdecimal to_integral(bd_context& c = context) const {
+    ALWAYS_INLINE basic_bigdecimal to_integral(bd_context& c = context) const {
         return unary_func(mpd_qround_to_int, c);
     }
-    ALWAYS_INLINE bigint to_bigint(bd_context& c = context) const {
-        return bigint(to_integral(c).format("f"));
+    /// \brief Rounds value to integer using context rounding and converts it to bigint
+    /// \throws value_error for NaN and Infinity
+    bigint to_bigint(bd_context& c = context) const {
+        return detail::decimal_to_bigint(&value, c);
     }
-    ALWAYS_INLINE bigdecimal to_integral_exact(bd_context& c = context) const {
+    ALWAYS_INLINE basic_bigdecimal to_integral_exact(bd_context& c = context) const {
         return unary_func(mpd_qround_to_intx, c);
     }
-    ALWAYS_INLINE bigdecimal sqrt(bd_context& c = context) const {
+    ALWAYS_INLINE basic_bigdecimal sqrt(bd_context& c = context) const {
         return unary_func(mpd_qsqrt, c);
     }
-    ALWAYS_INLINE bigdecimal trunc(bd_context& c = context) const {
+    ALWAYS_INLINE basic_bigdecimal trunc(bd_context& c = context) const {
         return unary_func(mpd_qtrunc, c);
     }
 
@@ -714,86 +846,89 @@ public:
     /*                           Binary functions                          */
     /***********************************************************************/
     /* Binary functions, no context arg */
-    ALWAYS_INLINE bigdecimal compare_total(const bigdecimal& other) const {
+    ALWAYS_INLINE basic_bigdecimal compare_total(const basic_bigdecimal& other) const {
         return binary_func_noctx(mpd_compare_total, other);
     }
-    ALWAYS_INLINE bigdecimal compare_total_mag(const bigdecimal& other) const {
+    ALWAYS_INLINE basic_bigdecimal compare_total_mag(const basic_bigdecimal& other) const {
         return binary_func_noctx(mpd_compare_total_mag, other);
     }
 
     /* Binary arithmetic functions, optional context arg */
-    ALWAYS_INLINE bigdecimal add(const bigdecimal& other, bd_context& c = context) const {
+    ALWAYS_INLINE basic_bigdecimal add(const basic_bigdecimal& other, bd_context& c = context) const {
         return binary_func(mpd_qadd, other, c);
     }
-    ALWAYS_INLINE bigdecimal div(const bigdecimal& other, bd_context& c = context) const {
+    ALWAYS_INLINE basic_bigdecimal div(const basic_bigdecimal& other, bd_context& c = context) const {
         return binary_func(mpd_qdiv, other, c);
     }
-    ALWAYS_INLINE bigdecimal divint(const bigdecimal& other, bd_context& c = context) const {
+    ALWAYS_INLINE basic_bigdecimal divint(const basic_bigdecimal& other, bd_context& c = context) const {
         return binary_func(mpd_qdivint, other, c);
     }
-    ALWAYS_INLINE bigdecimal compare(const bigdecimal& other, bd_context& c = context) const {
+    ALWAYS_INLINE basic_bigdecimal compare(const basic_bigdecimal& other, bd_context& c = context) const {
         return int_binary_func(mpd_qcompare, other, c);
     }
-    ALWAYS_INLINE bigdecimal compare_signal(const bigdecimal& other, bd_context& c = context) const {
+    ALWAYS_INLINE basic_bigdecimal compare_signal(const basic_bigdecimal& other, bd_context& c = context) const {
         return int_binary_func(mpd_qcompare_signal, other, c);
     }
-    ALWAYS_INLINE bigdecimal logical_and(const bigdecimal& other, bd_context& c = context) const {
+    ALWAYS_INLINE basic_bigdecimal logical_and(const basic_bigdecimal& other, bd_context& c = context) const {
         return binary_func(mpd_qand, other, c);
     }
-    ALWAYS_INLINE bigdecimal logical_or(const bigdecimal& other, bd_context& c = context) const {
+    ALWAYS_INLINE basic_bigdecimal logical_or(const basic_bigdecimal& other, bd_context& c = context) const {
         return binary_func(mpd_qor, other, c);
     }
-    ALWAYS_INLINE bigdecimal logical_xor(const bigdecimal& other, bd_context& c = context) const {
+    ALWAYS_INLINE basic_bigdecimal logical_xor(const basic_bigdecimal& other, bd_context& c = context) const {
         return binary_func(mpd_qxor, other, c);
     }
-    ALWAYS_INLINE bigdecimal max(const bigdecimal& other, bd_context& c = context) const {
+    ALWAYS_INLINE basic_bigdecimal max(const basic_bigdecimal& other, bd_context& c = context) const {
         return binary_func(mpd_qmax, other, c);
     }
-    ALWAYS_INLINE bigdecimal max_mag(const bigdecimal& other, bd_context& c = context) const {
+    ALWAYS_INLINE basic_bigdecimal max_mag(const basic_bigdecimal& other, bd_context& c = context) const {
         return binary_func(mpd_qmax_mag, other, c);
     }
-    ALWAYS_INLINE bigdecimal min(const bigdecimal& other, bd_context& c = context) const {
+    ALWAYS_INLINE basic_bigdecimal min(const basic_bigdecimal& other, bd_context& c = context) const {
         return binary_func(mpd_qmin, other, c);
     }
-    ALWAYS_INLINE bigdecimal min_mag(const bigdecimal& other, bd_context& c = context) const {
+    ALWAYS_INLINE basic_bigdecimal min_mag(const basic_bigdecimal& other, bd_context& c = context) const {
         return binary_func(mpd_qmin_mag, other, c);
     }
-    ALWAYS_INLINE bigdecimal mul(const bigdecimal& other, bd_context& c = context) const {
+    ALWAYS_INLINE basic_bigdecimal mul(const basic_bigdecimal& other, bd_context& c = context) const {
         return binary_func(mpd_qmul, other, c);
     }
-    ALWAYS_INLINE bigdecimal next_toward(const bigdecimal& other, bd_context& c = context) const {
+    ALWAYS_INLINE basic_bigdecimal next_toward(const basic_bigdecimal& other, bd_context& c = context) const {
         return binary_func(mpd_qnext_toward, other, c);
     }
-    ALWAYS_INLINE bigdecimal pow(const bigdecimal& other, bd_context& c = context) const {
+    ALWAYS_INLINE basic_bigdecimal pow(const basic_bigdecimal& other, bd_context& c = context) const {
         return binary_func(mpd_qpow, other, c);
     }
-    ALWAYS_INLINE bigdecimal quantize(const bigdecimal& other, bd_context& c = context) const {
+    ALWAYS_INLINE basic_bigdecimal quantize(const basic_bigdecimal& other, bd_context& c = context) const {
         return binary_func(mpd_qquantize, other, c);
     }
-    ALWAYS_INLINE bigdecimal rem(const bigdecimal& other, bd_context& c = context) const {
+    ALWAYS_INLINE basic_bigdecimal rem(const basic_bigdecimal& other, bd_context& c = context) const {
         return binary_func(mpd_qrem, other, c);
     }
-    ALWAYS_INLINE bigdecimal rem_near(const bigdecimal& other, bd_context& c = context) const {
+    ALWAYS_INLINE basic_bigdecimal rem_near(const basic_bigdecimal& other, bd_context& c = context) const {
         return binary_func(mpd_qrem_near, other, c);
     }
-    ALWAYS_INLINE bigdecimal rotate(const bigdecimal& other, bd_context& c = context) const {
+    ALWAYS_INLINE basic_bigdecimal rotate(const basic_bigdecimal& other, bd_context& c = context) const {
         return binary_func(mpd_qrotate, other, c);
     }
-    ALWAYS_INLINE bigdecimal scaleb(const bigdecimal& other, bd_context& c = context) const {
+    ALWAYS_INLINE basic_bigdecimal scaleb(const basic_bigdecimal& other, bd_context& c = context) const {
         return binary_func(mpd_qscaleb, other, c);
     }
-    ALWAYS_INLINE bigdecimal shift(const bigdecimal& other, bd_context& c = context) const {
+    ALWAYS_INLINE basic_bigdecimal shift(const basic_bigdecimal& other, bd_context& c = context) const {
         return binary_func(mpd_qshift, other, c);
     }
-    ALWAYS_INLINE bigdecimal sub(const bigdecimal& other, bd_context& c = context) const {
+    ALWAYS_INLINE basic_bigdecimal sub(const basic_bigdecimal& other, bd_context& c = context) const {
         return binary_func(mpd_qsub, other, c);
     }
 
     /* Binary arithmetic function, two return values */
-    ALWAYS_INLINE std::pair<bigdecimal, bigdecimal> divmod(const bigdecimal& other, bd_context& c = context) const {
-        std::pair<bigdecimal, bigdecimal> result;
+    ALWAYS_INLINE std::pair<basic_bigdecimal, basic_bigdecimal> divmod(const basic_bigdecimal& other, bd_context& c = context) const {
+        std::pair<basic_bigdecimal, basic_bigdecimal> result;
         uint32_t status = 0;
+        BIGMATH_STATS_OP(mpd_qdivmod);
         mpd_qdivmod(result.first.get(), result.second.get(), getconst(), other.getconst(), c.getconst(), &status);
+        result.first.count_spill(true);
+        result.second.count_spill(true);
         c.raise(status);
         return result;
     }
@@ -801,49 +936,162 @@ public:
     /***********************************************************************/
     /*                          Ternary functions                          */
     /***********************************************************************/
-    ALWAYS_INLINE bigdecimal fma(const bigdecimal& other, const bigdecimal& third, bd_context& c = context) const {
-        bigdecimal result;
+    ALWAYS_INLINE basic_bigdecimal fma(const basic_bigdecimal& other, const basic_bigdecimal& third, bd_context& c = context) const {
+        basic_bigdecimal result;
         uint32_t status = 0;
+        BIGMATH_STATS_OP(mpd_qfma);
         mpd_qfma(result.get(), getconst(), other.getconst(), third.getconst(), c.getconst(), &status);
+        result.count_spill(true);
         c.raise(status);
         return result;
     }
 
-    ALWAYS_INLINE bigdecimal powmod(const bigdecimal& other, const bigdecimal& third, bd_context& c = context) const {
-        bigdecimal result;
+    ALWAYS_INLINE basic_bigdecimal powmod(const basic_bigdecimal& other, const basic_bigdecimal& third, bd_context& c = context) const {
+        basic_bigdecimal result;
         uint32_t status = 0;
+        BIGMATH_STATS_OP(mpd_qpowmod);
         mpd_qpowmod(result.get(), getconst(), other.getconst(), third.getconst(), c.getconst(), &status);
+        result.count_spill(true);
         c.raise(status);
         return result;
     }
 
+    /***********************************************************************/
+    /*                  Functions with compile-time context                */
+    /***********************************************************************/
+    /* Same as functions above, with bigmath::static_context instead of bd_context */
+    ENABLE_IF_STATIC_CONTEXT(Ctx)
+    ALWAYS_INLINE basic_bigdecimal abs(Ctx c) const {
+        return unary_func(mpd_qabs, c);
+    }
+    ENABLE_IF_STATIC_CONTEXT(Ctx)
+    ALWAYS_INLINE basic_bigdecimal exp(Ctx c) const {
+        return unary_func(mpd_qexp, c);
+    }
+    ENABLE_IF_STATIC_CONTEXT(Ctx)
+    ALWAYS_INLINE basic_bigdecimal ln(Ctx c) const {
+        return unary_func(mpd_qln, c);
+    }
+    ENABLE_IF_STATIC_CONTEXT(Ctx)
+    ALWAYS_INLINE basic_bigdecimal log10(Ctx c) const {
+        return unary_func(mpd_qlog10, c);
+    }
+    ENABLE_IF_STATIC_CONTEXT(Ctx)
+    ALWAYS_INLINE basic_bigdecimal minus(Ctx c) const {
+        return unary_func(mpd_qminus, c);
+    }
+    ENABLE_IF_STATIC_CONTEXT(Ctx)
+    ALWAYS_INLINE basic_bigdecimal plus(Ctx c) const {
+        return unary_func(mpd_qplus, c);
+    }
+    ENABLE_IF_STATIC_CONTEXT(Ctx)
+    ALWAYS_INLINE basic_bigdecimal reduce(Ctx c) const {
+        return unary_func(mpd_qreduce, c);
+    }
+    ENABLE_IF_STATIC_CONTEXT(Ctx)
+    ALWAYS_INLINE basic_bigdecimal to_integral(Ctx c) const {
+        return unary_func(mpd_qround_to_int, c);
+    }
+    ENABLE_IF_STATIC_CONTEXT(Ctx)
+    ALWAYS_INLINE basic_bigdecimal sqrt(Ctx c) const {
+        return unary_func(mpd_qsqrt, c);
+    }
+
+    ENABLE_IF_STATIC_CONTEXT(Ctx)
+    ALWAYS_INLINE basic_bigdecimal add(const basic_bigdecimal& other, Ctx c) const {
+        return binary_func(mpd_qadd, other, c);
+    }
+    ENABLE_IF_STATIC_CONTEXT(Ctx)
+    ALWAYS_INLINE basic_bigdecimal sub(const basic_bigdecimal& other, Ctx c) const {
+        return binary_func(mpd_qsub, other, c);
+    }
+    ENABLE_IF_STATIC_CONTEXT(Ctx)
+    ALWAYS_INLINE basic_bigdecimal mul(const basic_bigdecimal& other, Ctx c) const {
+        return binary_func(mpd_qmul, other, c);
+    }
+    ENABLE_IF_STATIC_CONTEXT(Ctx)
+    ALWAYS_INLINE basic_bigdecimal div(const basic_bigdecimal& other, Ctx c) const {
+        return binary_func(mpd_qdiv, other, c);
+    }
+    ENABLE_IF_STATIC_CONTEXT(Ctx)
+    ALWAYS_INLINE basic_bigdecimal divint(const basic_bigdecimal& other, Ctx c) const {
+        return binary_func(mpd_qdivint, other, c);
+    }
+    ENABLE_IF_STATIC_CONTEXT(Ctx)
+    ALWAYS_INLINE basic_bigdecimal rem(const basic_bigdecimal& other, Ctx c) const {
+        return binary_func(mpd_qrem, other, c);
+    }
+    ENABLE_IF_STATIC_CONTEXT(Ctx)
+    ALWAYS_INLINE basic_bigdecimal max(const basic_bigdecimal& other, Ctx c) const {
+        return binary_func(mpd_qmax, other, c);
+    }
+    ENABLE_IF_STATIC_CONTEXT(Ctx)
+    ALWAYS_INLINE basic_bigdecimal min(const basic_bigdecimal& other, Ctx c) const {
+        return binary_func(mpd_qmin, other, c);
+    }
+    ENABLE_IF_STATIC_CONTEXT(Ctx)
+    ALWAYS_INLINE basic_bigdecimal pow(const basic_bigdecimal& other, Ctx c) const {
+        return binary_func(mpd_qpow, other, c);
+    }
+    ENABLE_IF_STATIC_CONTEXT(Ctx)
+    ALWAYS_INLINE basic_bigdecimal quantize(const basic_bigdecimal& other, Ctx c) const {
+        return binary_func(mpd_qquantize, other, c);
+    }
+
+    ENABLE_IF_STATIC_CONTEXT(Ctx)
+    ALWAYS_INLINE basic_bigdecimal fma(const basic_bigdecimal& other, const basic_bigdecimal& third, Ctx) const {
+        basic_bigdecimal result;
+        uint32_t status = 0;
+        BIGMATH_STATS_OP(mpd_qfma);
+        mpd_qfma(result.get(), getconst(), other.getconst(), third.getconst(), Ctx::getconst(), &status);
+        result.count_spill(true);
+        Ctx::raise(status);
+        return result;
+    }
+
+    /// \brief Rounds value to precision of Ctx
+    ENABLE_IF_STATIC_CONTEXT(Ctx)
+    ALWAYS_INLINE basic_bigdecimal apply(Ctx) const {
+        basic_bigdecimal result = *this;
+        uint32_t status = 0;
+        const bool was_inline = result.isstatic();
+        BIGMATH_STATS_OP(mpd_qfinalize);
+        mpd_qfinalize(result.get(), Ctx::getconst(), &status);
+        result.count_spill(was_inline);
+        Ctx::raise(status);
+        return result;
+    }
+
     /***********************************************************************/
     /*                         Irregular functions                         */
     /***********************************************************************/
-    ALWAYS_INLINE bigdecimal apply(bd_context& c = context) const {
-        bigdecimal result = *this;
+    ALWAYS_INLINE basic_bigdecimal apply(bd_context& c = context) const {
+        basic_bigdecimal result = *this;
         uint32_t status = 0;
+        const bool was_inline = result.isstatic();
 
+        BIGMATH_STATS_OP(mpd_qfinalize);
         mpd_qfinalize(result.get(), c.getconst(), &status);
+        result.count_spill(was_inline);
         c.raise(status);
         return result;
     }
 
-    ALWAYS_INLINE int cmp(const bigdecimal& other) const {
+    ALWAYS_INLINE int cmp(const basic_bigdecimal& other) const {
         uint32_t status = 0;
         return mpd_qcmp(getconst(), other.getconst(), &status);
     }
 
-    ALWAYS_INLINE int cmp_total(const bigdecimal& other) const {
+    ALWAYS_INLINE int cmp_total(const basic_bigdecimal& other) const {
         return mpd_cmp_total(getconst(), other.getconst());
     }
 
-    ALWAYS_INLINE int cmp_total_mag(const bigdecimal& other) const {
+    ALWAYS_INLINE int cmp_total_mag(const basic_bigdecimal& other) const {
         return mpd_cmp_total_mag(getconst(), other.getconst());
     }
 
-    ALWAYS_INLINE bigdecimal copy_sign(const bigdecimal& other) const {
-        bigdecimal result;
+    ALWAYS_INLINE basic_bigdecimal copy_sign(const basic_bigdecimal& other) const {
+        basic_bigdecimal result;
         uint32_t status = 0;
         if (!mpd_qcopy_sign(result.get(), getconst(), other.getconst(), &status)) {
             throw malloc_error("out of memory");
@@ -851,8 +1099,8 @@ public:
         return result;
     }
 
-    ALWAYS_INLINE bigdecimal rescale(const int64_t exp, bd_context& c = context) const {
-        bigdecimal result;
+    ALWAYS_INLINE basic_bigdecimal rescale(const int64_t exp, bd_context& c = context) const {
+        basic_bigdecimal result;
         uint32_t status = 0;
         mpd_ssize_t xexp = bigmath::safe_downcast<mpd_ssize_t, int64_t>(exp);
         mpd_qrescale(result.get(), getconst(), xexp, c.getconst(), &status);
@@ -860,12 +1108,12 @@ public:
         return result;
     }
 
-    ALWAYS_INLINE bool same_quantum(const bigdecimal& other) const {
+    ALWAYS_INLINE bool same_quantum(const basic_bigdecimal& other) const {
         return mpd_same_quantum(getconst(), other.getconst());
     }
 
-    ALWAYS_INLINE bigdecimal shiftn(const int64_t n, bd_context& c = context) const {
-        bigdecimal result;
+    ALWAYS_INLINE basic_bigdecimal shiftn(const int64_t n, bd_context& c = context) const {
+        basic_bigdecimal result;
         uint32_t status = 0;
         mpd_ssize_t nn = bigmath::safe_downcast<mpd_ssize_t, int64_t>(n);
         mpd_qshiftn(result.get(), getconst(), nn, c.getconst(), &status);
@@ -873,8 +1121,8 @@ public:
         return result;
     }
 
-    ALWAYS_INLINE bigdecimal shiftl(const int64_t n, bd_context& c = context) const {
-        bigdecimal result;
+    ALWAYS_INLINE basic_bigdecimal shiftl(const int64_t n, bd_context& c = context) const {
+        basic_bigdecimal result;
         uint32_t status = 0;
         mpd_ssize_t nn = bigmath::safe_downcast<mpd_ssize_t, int64_t>(n);
         mpd_qshiftl(result.get(), getconst(), nn, &status);
@@ -882,8 +1130,8 @@ public:
         return result;
     }
 
-    ALWAYS_INLINE bigdecimal shiftr(const int64_t n, bd_context& c = context) const {
-        bigdecimal result;
+    ALWAYS_INLINE basic_bigdecimal shiftr(const int64_t n, bd_context& c = context) const {
+        basic_bigdecimal result;
         uint32_t status = 0;
         mpd_ssize_t nn = bigmath::safe_downcast<mpd_ssize_t, int64_t>(n);
         mpd_qshiftr(result.get(), getconst(), nn, &status);
@@ -891,10 +1139,37 @@ public:
         return result;
     }
 
-    static bigdecimal exact(const char* const s, bd_context& c);
-    static bigdecimal exact(const std::string& s, bd_context& c);
-    static bigdecimal ln10(int64_t n, bd_context& c = context);
-    static int32_t radix();
+    static basic_bigdecimal exact(const char* const s, bd_context& c) {
+        basic_bigdecimal result;
+        uint32_t status = 0;
+
+        if (s == nullptr) {
+            throw value_error("bigdecimal::exact: string argument is NULL");
+        }
+
+        mpd_qset_string_exact(result.get(), s, &status);
+        c.raise(status);
+        return result;
+    }
+
+    static basic_bigdecimal exact(const std::string& s, bd_context& c) {
+        return exact(s.c_str(), c);
+    }
+
+    static basic_bigdecimal ln10(int64_t n, bd_context& c = context) {
+        basic_bigdecimal result;
+        uint32_t status = 0;
+
+        mpd_ssize_t nn = bigmath::safe_downcast<mpd_ssize_t, int64_t>(n);
+        mpd_qln10(result.get(), nn, &status);
+
+        c.raise(status);
+        return result;
+    }
+
+    static int32_t radix() {
+        return 10;
+    }
 
     /***********************************************************************/
     /*                          Integer conversion                         */
@@ -939,7 +1214,9 @@ public:
     /*                          String conversion                          */
     /***********************************************************************/
     /* String representations */
-    std::string repr(bool capitals = true) const;
+    std::string repr(bool capitals = true) const {
+        return "bigmath::bigdecimal(\"" + to_sci(capitals) + "\")";
+    }
 
     inline std::string to_sci(bool capitals = true) const {
         const char* cp = mpd_to_sci(getconst(), capitals);
@@ -970,6 +1247,14 @@ public:
             throw value_error("bigdecimal.format: fmt argument is NULL");
         }
 
+        /* "f" and ".<precision>f" are written without mpd_qformat */
+        const int precision = detail::fixed_precision(fmt);
+        if (precision != detail::FMT_NOT_FIXED) {
+            std::string out;
+            detail::append_fixed(out, &value, precision, c);
+            return out;
+        }
+
         mpd_maxcontext(&ctx);
         ctx.round = c.getconst()->round;
         ctx.traps = 0;
@@ -991,70 +1276,151 @@ public:
         return format(s.c_str(), c);
     }
 
-    friend std::ostream& operator<<(std::ostream& os, const bigdecimal& self);
+    /// \brief Writes format("f") output to [first, last) without heap allocation, no null terminator is written
+    /// \return ptr past last written char, or last with std::errc::value_too_large if range is too small
+    std::to_chars_result to_chars(char* first, char* last) const {
+        return detail::to_chars_fixed(first, last, &value, detail::FMT_ALL_DIGITS, context);
+    }
+
+    /// \brief Writes format(".<precision>f") output to [first, last), rounding with context rounding mode.
+    /// Heap is not used unless value has more than 76 digits after rounding
+    std::to_chars_result to_chars(char* first, char* last, int precision, const bd_context& c = context) const {
+        if (precision < 0) {
+            throw value_error("bigdecimal.to_chars: precision can't be negative");
+        }
+        return detail::to_chars_fixed(first, last, &value, precision, c);
+    }
+
+    /// \brief Appends format("f") output to the end of string
+    void append_to(std::string& out) const {
+        detail::append_fixed(out, &value, detail::FMT_ALL_DIGITS, context);
+    }
+
+    /// \brief Appends format(".<precision>f") output to the end of string
+    void append_to(std::string& out, int precision, const bd_context& c = context) const {
+        if (precision < 0) {
+            throw value_error("bigdecimal.append_to: precision can't be negative");
+        }
+        detail::append_fixed(out, &value, precision, c);
+    }
+
+    /***********************************************************************/
+    /*                         Binary serialization                        */
+    /***********************************************************************/
+    /* Encoding: header byte (bit 0 - sign, bits 1-2 - 0 finite, 1 infinity, 2 NaN, 3 sNaN),
+     * exponent as zigzag varint, count of coefficient words as varint, zero padding to multiple of 8 bytes,
+     * then words in base 10^19, 8 bytes little-endian each, least significant first. Infinity has no words,
+     * NaN keeps its payload. Size of encoding is multiple of 8, so values written one after another into
+     * 8-byte aligned buffer keep words aligned for bigdecimal_view. */
+
+    /// \brief Returns size of binary encoding in bytes
+    size_t serialized_size() const {
+        return detail::decimal_serialized_size(&value);
+    }
+
+    /// \brief Writes binary encoding to buffer
+    /// \return count of written bytes
+    /// \throws value_error if buffer is smaller than serialized_size()
+    size_t serialize_to(uint8_t* buffer, size_t size) const {
+        return detail::decimal_serialize(&value, buffer, size);
+    }
+
+    /// \brief Appends binary encoding to the end of vector
+    void serialize_to(std::vector<uint8_t>& out) const {
+        const size_t pos = out.size();
+        out.resize(pos + serialized_size());
+        detail::decimal_serialize(&value, out.data() + pos, out.size() - pos);
+    }
+
+    /// \brief Reads binary encoding written by serialize_to()
+    /// \param consumed if not null, receives count of read bytes
+    /// \throws value_error if encoding is truncated or malformed
+    static basic_bigdecimal deserialize(const uint8_t* data, size_t size, size_t* consumed = nullptr) {
+        basic_bigdecimal result;
+        const size_t n = detail::decimal_deserialize(result.get(), data, size);
+        if (consumed != nullptr) {
+            *consumed = n;
+        }
+        return result;
+    }
+
+    friend std::ostream& operator<<(std::ostream& os, const basic_bigdecimal& self) {
+        char buf[128];
+        const std::to_chars_result res = self.to_chars(buf, buf + sizeof(buf));
+        if (res.ec == std::errc()) {
+            os.write(buf, res.ptr - buf);
+        } else {
+            os << self.format("f");
+        }
+        return os;
+    }
 };
 
+#define ENABLE_IF_INTEGRAL_DECIMAL(T, N) \
+    template<typename T, mpd_ssize_t N,     \
+             typename = typename std::enable_if<bigmath::int64_compat<T>::value || bigmath::uint64_compat<T>::value>::type>
+
 /***********************************************************************/
 /*                      Reverse comparison operators                   */
 /***********************************************************************/
-ENABLE_IF_INTEGRAL(T)
-ALWAYS_INLINE bool operator==(const T& other, const bigdecimal& self) {
+ENABLE_IF_INTEGRAL_DECIMAL(T, N)
+ALWAYS_INLINE bool operator==(const T& other, const basic_bigdecimal<N>& self) {
     ASSERT_INTEGRAL(T);
-    return bigdecimal(other) == self;
+    return basic_bigdecimal<N>(other) == self;
 }
-ENABLE_IF_INTEGRAL(T)
-ALWAYS_INLINE bool operator!=(const T& other, const bigdecimal& self) {
+ENABLE_IF_INTEGRAL_DECIMAL(T, N)
+ALWAYS_INLINE bool operator!=(const T& other, const basic_bigdecimal<N>& self) {
     ASSERT_INTEGRAL(T);
-    return bigdecimal(other) != self;
+    return basic_bigdecimal<N>(other) != self;
 }
-ENABLE_IF_INTEGRAL(T)
-ALWAYS_INLINE bool operator<(const T& other, const bigdecimal& self) {
+ENABLE_IF_INTEGRAL_DECIMAL(T, N)
+ALWAYS_INLINE bool operator<(const T& other, const basic_bigdecimal<N>& self) {
     ASSERT_INTEGRAL(T);
-    return bigdecimal(other) < self;
+    return basic_bigdecimal<N>(other) < self;
 }
-ENABLE_IF_INTEGRAL(T)
-ALWAYS_INLINE bool operator<=(const T& other, const bigdecimal& self) {
+ENABLE_IF_INTEGRAL_DECIMAL(T, N)
+ALWAYS_INLINE bool operator<=(const T& other, const basic_bigdecimal<N>& self) {
     ASSERT_INTEGRAL(T);
-    return bigdecimal(other) <= self;
+    return basic_bigdecimal<N>(other) <= self;
 }
-ENABLE_IF_INTEGRAL(T)
-ALWAYS_INLINE bool operator>=(const T& other, const bigdecimal& self) {
+ENABLE_IF_INTEGRAL_DECIMAL(T, N)
+ALWAYS_INLINE bool operator>=(const T& other, const basic_bigdecimal<N>& self) {
     ASSERT_INTEGRAL(T);
-    return bigdecimal(other) >= self;
+    return basic_bigdecimal<N>(other) >= self;
 }
-ENABLE_IF_INTEGRAL(T)
-ALWAYS_INLINE bool operator>(const T& other, const bigdecimal& self) {
+ENABLE_IF_INTEGRAL_DECIMAL(T, N)
+ALWAYS_INLINE bool operator>(const T& other, const basic_bigdecimal<N>& self) {
     ASSERT_INTEGRAL(T);
-    return bigdecimal(other) > self;
+    return basic_bigdecimal<N>(other) > self;
 }
 
 /***********************************************************************/
 /*                      Reverse arithmetic operators                   */
 /***********************************************************************/
-ENABLE_IF_INTEGRAL(T)
-ALWAYS_INLINE bigdecimal operator+(const T& other, const bigdecimal& self) {
+ENABLE_IF_INTEGRAL_DECIMAL(T, N)
+ALWAYS_INLINE basic_bigdecimal<N> operator+(const T& other, const basic_bigdecimal<N>& self) {
     ASSERT_INTEGRAL(T);
-    return bigdecimal(other) + self;
+    return basic_bigdecimal<N>(other) + self;
 }
-ENABLE_IF_INTEGRAL(T)
-ALWAYS_INLINE bigdecimal operator-(const T& other, const bigdecimal& self) {
+ENABLE_IF_INTEGRAL_DECIMAL(T, N)
+ALWAYS_INLINE basic_bigdecimal<N> operator-(const T& other, const basic_bigdecimal<N>& self) {
     ASSERT_INTEGRAL(T);
-    return bigdecimal(other) - self;
+    return basic_bigdecimal<N>(other) - self;
 }
-ENABLE_IF_INTEGRAL(T)
-ALWAYS_INLINE bigdecimal operator*(const T& other, const bigdecimal& self) {
+ENABLE_IF_INTEGRAL_DECIMAL(T, N)
+ALWAYS_INLINE basic_bigdecimal<N> operator*(const T& other, const basic_bigdecimal<N>& self) {
     ASSERT_INTEGRAL(T);
-    return bigdecimal(other) * self;
+    return basic_bigdecimal<N>(other) * self;
 }
-ENABLE_IF_INTEGRAL(T)
-ALWAYS_INLINE bigdecimal operator/(const T& other, const bigdecimal& self) {
+ENABLE_IF_INTEGRAL_DECIMAL(T, N)
+ALWAYS_INLINE basic_bigdecimal<N> operator/(const T& other, const basic_bigdecimal<N>& self) {
     ASSERT_INTEGRAL(T);
-    return bigdecimal(other) / self;
+    return basic_bigdecimal<N>(other) / self;
 }
-ENABLE_IF_INTEGRAL(T)
-ALWAYS_INLINE bigdecimal operator%(const T& other, const bigdecimal& self) {
+ENABLE_IF_INTEGRAL_DECIMAL(T, N)
+ALWAYS_INLINE basic_bigdecimal<N> operator%(const T& other, const basic_bigdecimal<N>& self) {
     ASSERT_INTEGRAL(T);
-    return bigdecimal(other) % self;
+    return basic_bigdecimal<N>(other) % self;
 }
 
 #undef INT64_SUBSET
@@ -1062,6 +1428,7 @@ ALWAYS_INLINE bigdecimal operator%(const T& other, const bigdecimal& self) {
 #undef ENABLE_IF_SIGNED
 #undef ENABLE_IF_UNSIGNED
 #undef ENABLE_IF_INTEGRAL
+#undef ENABLE_IF_INTEGRAL_DECIMAL
 #undef ASSERT_SIGNED
 #undef ASSERT_UNSIGNED
 #undef ASSERT_INTEGRAL
@@ -0,0 +1,49 @@
+/*!
+ * bigmath.
+ * bigdecimal_fwd.h
+ *
+ * \date 10/17/2026
+ * \author Eduard Maximovich (edward.vstock@gmail.com)
+ * \link   https://github.com/edwardstock
+ */
+#ifndef BIGMATHPP_BIGDECIMAL_FWD_H
+#define BIGMATHPP_BIGDECIMAL_FWD_H
+
+#include "bigmath_config.h"
+#include "mpdecimal_backport.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace bigmath {
+
+/* default count of coefficient words stored inside bigdecimal object: 76 digits */
+constexpr mpd_ssize_t MINALLOC = 4;
+/* smallest inline coefficient, set as MPD_MINALLOC, so mpdecimal doesn't grow any inline coefficient to heap */
+constexpr mpd_ssize_t MINALLOC_MIN = MPD_MINALLOC_MIN;
+
+template<mpd_ssize_t InlineWords>
+class basic_bigdecimal;
+
+using bigdecimal = basic_bigdecimal<MINALLOC>;
+
+class bigint;
+class bd_context;
+
+namespace detail {
+/* coefficient conversions and parsing shared by all basic_bigdecimal types */
+BIGMATHPP_API void bigint_to_decimal(mpd_t* result, const bigint& v);
+BIGMATHPP_API bigint decimal_to_bigint(const mpd_t* a, bd_context& c);
+BIGMATHPP_API void decimal_set_str(mpd_t* result, std::string_view s);
+/* same as decimal_set_str, status is added to *status instead of raising it through context */
+BIGMATHPP_API void decimal_parse(mpd_t* result, std::string_view s, uint32_t* status);
+/* binary encoding, see basic_bigdecimal::serialize_to() */
+BIGMATHPP_API size_t decimal_serialized_size(const mpd_t* a);
+BIGMATHPP_API size_t decimal_serialize(const mpd_t* a, uint8_t* out, size_t size);
+BIGMATHPP_API size_t decimal_deserialize(mpd_t* result, const uint8_t* data, size_t size);
+} // namespace detail
+
+} // namespace bigmath
+
+#endif //BIGMATHPP_BIGDECIMAL_FWD_H
@@ -0,0 +1,84 @@
+/*!
+ * bigmath.
+ * bigdecimal_view.h
+ *
+ * \date 10/17/2026
+ * \author Eduard Maximovich (edward.vstock@gmail.com)
+ * \link   https://github.com/edwardstock
+ */
+#ifndef BIGMATHPP_BIGDECIMAL_VIEW_H
+#define BIGMATHPP_BIGDECIMAL_VIEW_H
+
+#include "bigdecimal.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace bigmath {
+
+/// \brief Read-only decimal over binary encoding of basic_bigdecimal::serialize_to(), e.g. inside of mmap'd file.
+/// Constructor parses header only, coefficient words stay in buffer and are read in place, so buffer must outlive
+/// the view. Words are padded to 8 bytes from start of encoding, so comparisons pass them to mpdecimal directly
+/// if encoding starts at 8-byte aligned address on little-endian host. Otherwise coefficient is copied to stack
+/// (or heap if it has more than 8 words).
+class BIGMATHPP_API bigdecimal_view {
+public:
+    /// \throws value_error if encoding is truncated or malformed
+    bigdecimal_view(const uint8_t* data, size_t size);
+
+    /// \brief Returns count of bytes of encoding, offset of the next value in buffer
+    size_t encoded_size() const;
+
+    bool issigned() const;
+    bool isspecial() const;
+    bool isnan() const;
+    bool isinfinite() const;
+    bool iszero() const;
+    mpd_ssize_t exponent() const;
+    mpd_ssize_t digits() const;
+
+    /// \brief Returns count of coefficient words in base 10^19
+    size_t word_count() const;
+    /// \brief Returns coefficient word, least significant first
+    mpd_uint_t word(size_t i) const;
+    /// \brief Returns coefficient words inside of buffer, or nullptr if they are misaligned and must be copied
+    const mpd_uint_t* inplace_words() const;
+
+    /// \brief Copies value to decimal
+    template<mpd_ssize_t N = MINALLOC>
+    basic_bigdecimal<N> to_bigdecimal() const {
+        return basic_bigdecimal<N>::deserialize(m_data, m_size);
+    }
+
+    /// \brief Compares as mpd_qcmp: -1, 0 or 1. As with comparison operators, NaN raises invalid operation
+    /// through thread context and compares as unordered: INT_MAX.
+    int compare(const bigdecimal_view& other) const;
+    template<mpd_ssize_t N>
+    int compare(const basic_bigdecimal<N>& other) const {
+        return compare(other.getconst());
+    }
+    int compare(const mpd_t* other) const;
+
+    /* comparison operators behave as bigdecimal ones, including NaN handling */
+    bool operator==(const bigdecimal_view& other) const;
+    bool operator!=(const bigdecimal_view& other) const;
+    bool operator<(const bigdecimal_view& other) const;
+    bool operator<=(const bigdecimal_view& other) const;
+    bool operator>(const bigdecimal_view& other) const;
+    bool operator>=(const bigdecimal_view& other) const;
+
+private:
+    friend struct view_access;
+
+    const uint8_t* m_data;
+    const uint8_t* m_words;
+    size_t m_size;
+    mpd_ssize_t m_exp;
+    mpd_ssize_t m_len;
+    mpd_ssize_t m_digits;
+    uint8_t m_flags;
+};
+
+} // namespace bigmath
+
+#endif //BIGMATHPP_BIGDECIMAL_VIEW_H
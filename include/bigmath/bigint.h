@@ -9,10 +9,14 @@
 #ifndef BIGMATHPP_BIGINT_H
 #define BIGMATHPP_BIGINT_H
 
+#include "bigdecimal_fwd.h"
 #include "bigmath_config.h"
 #include "utils.h"
 
+#include <algorithm>
+#include <charconv>
 #include <string>
+#include <type_traits>
 #include <vector>
 
 #if defined(HAVE_GMP)
@@ -25,13 +29,150 @@
 
 namespace bigmath {
 
-class bigdecimal;
+namespace detail {
+/* lazy bigint expressions are defined in bigint_expr.h */
+template<typename T>
+struct is_bigint_expr : std::false_type {};
+struct bigint_access;
+} // namespace detail
+
+/// \brief Byte order of bigint::export_to() and bigint::import_from()
+enum class endian {
+    big,
+    little,
+};
 
 class BIGMATHPP_API bigint {
+    /* direct coefficient conversion */
+    friend void detail::bigint_to_decimal(mpd_t* result, const bigint& v);
+    friend bigint detail::decimal_to_bigint(const mpd_t* a, bd_context& c);
+    friend struct detail::bigint_access;
+
 private:
-    mpz_class m_val;
+    /* limbs stored inside object: values up to 128 bits (64-bit limbs) don't touch heap */
+    static constexpr int INLINE_LIMBS = 2;
+
+    mp_limb_t m_limbs[INLINE_LIMBS];
+    /* _mp_d points to m_limbs until value grows, then it's a regular GMP heap buffer */
+    mpz_t m_val{{INLINE_LIMBS, 0, m_limbs}};
     int32_t m_base = 10;
 
+    ALWAYS_INLINE bool is_inline() const noexcept {
+        return m_val->_mp_d == m_limbs;
+    }
+
+    /* GMP reallocates output operand if it's smaller than worst case result size,
+     * that can't be done with inline buffer, so every write reserves space first */
+    ALWAYS_INLINE void ensure(size_t n) {
+        if (n > (size_t) m_val->_mp_alloc) {
+            reserve(n);
+        }
+    }
+
+    void reserve(size_t n);
+    void set_str(const std::string& val, int32_t radix);
+
+    /* truncating quotient size, as mpz_tdiv_q reserves it */
+    static ALWAYS_INLINE size_t quot_size(mpz_srcptr n, mpz_srcptr d) {
+        const size_t nn = mpz_size(n), dn = mpz_size(d);
+        return nn >= dn ? nn - dn + 1 : 1;
+    }
+
+    /* primitive operand split to absolute value and sign, to pass it to GMP *_ui functions without temporary bigint */
+    struct prim_operand {
+        unsigned long int abs;
+        bool neg;
+    };
+
+    ENABLE_IF_CONVERTIBLE(T)
+    static ALWAYS_INLINE prim_operand to_prim(const T& other) {
+        if (bigmath::int64_compat<T>::value) {
+            const auto v = (signed long int) other;
+            if (v < 0) {
+                return {0UL - (unsigned long int) v, true};
+            }
+            return {(unsigned long int) v, false};
+        }
+        return {(unsigned long int) other, false};
+    }
+
+    static ALWAYS_INLINE void add_prim(bigint& res, mpz_srcptr a, prim_operand b) {
+        mpz_ptr out = res.m_val;
+        res.ensure(mpz_size(a) + 1);
+        if (b.neg) {
+            mpz_sub_ui(out, a, b.abs);
+        } else {
+            mpz_add_ui(out, a, b.abs);
+        }
+    }
+
+    static ALWAYS_INLINE void sub_prim(bigint& res, mpz_srcptr a, prim_operand b) {
+        mpz_ptr out = res.m_val;
+        res.ensure(mpz_size(a) + 1);
+        if (b.neg) {
+            mpz_add_ui(out, a, b.abs);
+        } else {
+            mpz_sub_ui(out, a, b.abs);
+        }
+    }
+
+    static ALWAYS_INLINE void mul_prim(bigint& res, mpz_srcptr a, prim_operand b) {
+        mpz_ptr out = res.m_val;
+        res.ensure(mpz_size(a) + 1);
+        mpz_mul_ui(out, a, b.abs);
+        if (b.neg) {
+            mpz_neg(out, out);
+        }
+    }
+
+    /* truncating division, as mpz_class operator/ does */
+    static ALWAYS_INLINE void div_prim(bigint& res, mpz_srcptr a, prim_operand b) {
+        mpz_ptr out = res.m_val;
+        res.ensure(mpz_size(a));
+        mpz_tdiv_q_ui(out, a, b.abs);
+        if (b.neg) {
+            mpz_neg(out, out);
+        }
+    }
+
+    /* remainder has the sign of dividend, as mpz_class operator% does */
+    static ALWAYS_INLINE void mod_prim(bigint& res, mpz_srcptr a, prim_operand b) {
+        mpz_tdiv_r_ui(res.m_val, a, b.abs);
+    }
+
+    static ALWAYS_INLINE int cmp_prim(mpz_srcptr a, prim_operand b) {
+        if (b.neg) {
+            // -abs can't be represented as long for LONG_MIN, so compare magnitudes instead
+            if (mpz_sgn(a) >= 0) {
+                return 1;
+            }
+            return -mpz_cmpabs_ui(a, b.abs);
+        }
+        return mpz_cmp_ui(a, b.abs);
+    }
+
+    /* primitive divided by bigint: quotient and remainder always fit into primitive (single limb) */
+    static ALWAYS_INLINE void prim_divmod(mpz_ptr q, mpz_ptr r, prim_operand a, mpz_srcptr b) {
+        unsigned long int qv = 0, rv = a.abs;
+        if (mpz_cmpabs_ui(b, a.abs) <= 0) {
+            const unsigned long int d = mpz_get_ui(b);
+            qv = a.abs / d;
+            rv = a.abs % d;
+        }
+        if (q != nullptr) {
+            mpz_set_ui(q, qv);
+            if (a.neg != (mpz_sgn(b) < 0)) {
+                mpz_neg(q, q);
+            }
+        }
+        if (r != nullptr) {
+            mpz_set_ui(r, rv);
+            if (a.neg) {
+                mpz_neg(r, r);
+            }
+        }
+    }
+
 public:
     bigint();
     explicit bigint(const std::string& val);
@@ -41,28 +182,51 @@ public:
     bigint(const bigint& other);
     bigint(const bigdecimal& other);
     bigint(bigint&& other) noexcept;
+    ~bigint();
 
     ENABLE_IF_CONVERTIBLE(T)
     bigint(const T& other) {
         ASSERT_CONVERTIBLE(T);
         if (bigmath::int64_compat<T>::value) {
-            mpz_set_si(m_val.get_mpz_t(), (signed long int) other);
+            mpz_set_si(m_val, (signed long int) other);
         } else if (bigmath::uint64_compat<T>::value) {
-            mpz_set_ui(m_val.get_mpz_t(), (unsigned long int) other);
+            mpz_set_ui(m_val, (unsigned long int) other);
         } else if (std::is_enum<T>::value) {
-            mpz_set_ui(m_val.get_mpz_t(), static_cast<unsigned long int>(other));
+            mpz_set_ui(m_val, static_cast<unsigned long int>(other));
         }
     }
 
     bigint& operator=(const bigint& other) noexcept {
-        m_val = other.m_val;
+        ensure(mpz_size(other.m_val));
+        mpz_set(m_val, other.m_val);
         m_base = other.m_base;
         return *this;
     }
 
-    bigint& operator=(bigint&& other) noexcept {
-        m_val = std::move(other.m_val);
-        m_base = other.m_base;
+    bigint& operator=(bigint&& other) noexcept;
+
+    /// \brief Evaluates lazy expression (see bigint_expr.h), e.g. lazy(a) * b + c * d, into limbs of this value
+    template<typename E, typename std::enable_if<detail::is_bigint_expr<E>::value, int>::type = 0>
+    bigint(const E& e) {
+        assign_expr(*this, e);
+    }
+
+    template<typename E, typename std::enable_if<detail::is_bigint_expr<E>::value, int>::type = 0>
+    bigint& operator=(const E& e) {
+        assign_expr(*this, e);
+        return *this;
+    }
+
+    /// \brief Adds lazy expression terms to this value one by one: products with mpz_addmul, without temporaries
+    template<typename E, typename std::enable_if<detail::is_bigint_expr<E>::value, int>::type = 0>
+    bigint& operator+=(const E& e) {
+        add_expr(*this, e, false);
+        return *this;
+    }
+
+    template<typename E, typename std::enable_if<detail::is_bigint_expr<E>::value, int>::type = 0>
+    bigint& operator-=(const E& e) {
+        add_expr(*this, e, true);
         return *this;
     }
 
@@ -71,59 +235,63 @@ public:
     }
 
     operator bool() const noexcept {
-        return mpz_get_si(m_val.get_mpz_t()) != 0;
+        return mpz_sgn(m_val) != 0;
     }
 
     operator int8_t() const {
-        return int8_t(mpz_get_si(m_val.get_mpz_t()));
+        return int8_t(mpz_get_si(m_val));
     }
 
     operator uint8_t() const {
-        return uint8_t(mpz_get_ui(m_val.get_mpz_t()));
+        return uint8_t(mpz_get_ui(m_val));
     }
 
     operator int16_t() const {
-        return int16_t(mpz_get_si(m_val.get_mpz_t()));
+        return int16_t(mpz_get_si(m_val));
     }
 
     operator uint16_t() const {
-        return uint16_t(mpz_get_ui(m_val.get_mpz_t()));
+        return uint16_t(mpz_get_ui(m_val));
     }
 
     operator int32_t() const {
-        return uint32_t(mpz_get_si(m_val.get_mpz_t()));
+        return uint32_t(mpz_get_si(m_val));
     }
 
     operator uint32_t() const {
-        return uint32_t(mpz_get_ui(m_val.get_mpz_t()));
+        return uint32_t(mpz_get_ui(m_val));
     }
 
     operator int64_t() const {
-        return int64_t(mpz_get_si(m_val.get_mpz_t()));
+        return int64_t(mpz_get_si(m_val));
     }
 
     operator uint64_t() const {
-        return uint64_t(mpz_get_ui(m_val.get_mpz_t()));
+        return uint64_t(mpz_get_ui(m_val));
     }
 
     bigint& operator++() noexcept {
-        ++m_val;
+        ensure(mpz_size(m_val) + 1);
+        mpz_add_ui(m_val, m_val, 1);
         return *this;
     }
 
     bigint operator++(int) noexcept {
-        m_val++;
-        return *this - bigint("1");
+        bigint out(*this);
+        ++(*this);
+        return out;
     }
 
     bigint& operator--() noexcept {
-        --m_val;
+        ensure(mpz_size(m_val) + 1);
+        mpz_sub_ui(m_val, m_val, 1);
         return *this;
     }
 
     bigint operator--(int) noexcept {
-        m_val--;
-        return *this + bigint("1");
+        bigint out(*this);
+        --(*this);
+        return out;
     }
 
     bigint operator<<(int bits) const {
@@ -131,8 +299,10 @@ public:
     }
 
     bigint operator<<(mp_bitcnt_t bits) const {
-        bigint out(m_val, m_base);
-        mpz_mul_2exp(out.m_val.get_mpz_t(), out.m_val.get_mpz_t(), bits);
+        bigint out;
+        out.m_base = m_base;
+        out.ensure(mpz_size(m_val) + bits / GMP_NUMB_BITS + 1);
+        mpz_mul_2exp(out.m_val, m_val, bits);
         return out;
     }
 
@@ -141,7 +311,8 @@ public:
     }
 
     bigint& operator<<=(mp_bitcnt_t bits) {
-        mpz_mul_2exp(m_val.get_mpz_t(), m_val.get_mpz_t(), bits);
+        ensure(mpz_size(m_val) + bits / GMP_NUMB_BITS + 1);
+        mpz_mul_2exp(m_val, m_val, bits);
         return *this;
     }
 
@@ -150,8 +321,8 @@ public:
     }
 
     bigint operator>>(mp_bitcnt_t bits) const {
-        bigint out(m_val, m_base);
-        mpz_tdiv_q_2exp(out.m_val.get_mpz_t(), out.m_val.get_mpz_t(), bits);
+        bigint out(*this);
+        mpz_tdiv_q_2exp(out.m_val, out.m_val, bits);
         return out;
     }
 
@@ -160,7 +331,7 @@ public:
     }
 
     bigint& operator>>=(mp_bitcnt_t bits) {
-        mpz_tdiv_q_2exp(m_val.get_mpz_t(), m_val.get_mpz_t(), bits);
+        mpz_tdiv_q_2exp(m_val, m_val, bits);
         return *this;
     }
 
@@ -168,7 +339,8 @@ public:
     bigint& operator|=(const T& other) {
         ASSERT_CONVERTIBLE(T);
         auto tmp = bigint(other);
-        mpz_ior(m_val.get_mpz_t(), m_val.get_mpz_t(), tmp.m_val.get_mpz_t());
+        ensure(std::max(mpz_size(m_val), mpz_size(tmp.m_val)) + 1);
+        mpz_ior(m_val, m_val, tmp.m_val);
         return *this;
     }
 
@@ -177,18 +349,21 @@ public:
         ASSERT_CONVERTIBLE(T);
         bigint out(*this);
         auto tmp = bigint(other);
-        mpz_ior(out.m_val.get_mpz_t(), out.m_val.get_mpz_t(), tmp.m_val.get_mpz_t());
+        out.ensure(std::max(mpz_size(m_val), mpz_size(tmp.m_val)) + 1);
+        mpz_ior(out.m_val, out.m_val, tmp.m_val);
         return out;
     }
 
     bigint& operator|=(const bigint& other) {
-        mpz_ior(m_val.get_mpz_t(), m_val.get_mpz_t(), other.m_val.get_mpz_t());
+        ensure(std::max(mpz_size(m_val), mpz_size(other.m_val)) + 1);
+        mpz_ior(m_val, m_val, other.m_val);
         return *this;
     }
 
     bigint operator|(const bigint& other) {
         bigint out(*this);
-        mpz_ior(out.m_val.get_mpz_t(), out.m_val.get_mpz_t(), other.m_val.get_mpz_t());
+        out.ensure(std::max(mpz_size(m_val), mpz_size(other.m_val)) + 1);
+        mpz_ior(out.m_val, out.m_val, other.m_val);
         return out;
     }
 
@@ -196,7 +371,8 @@ public:
     bigint& operator&=(const T& other) {
         ASSERT_CONVERTIBLE(T);
         auto tmp = bigint(other);
-        mpz_and(m_val.get_mpz_t(), m_val.get_mpz_t(), tmp.m_val.get_mpz_t());
+        ensure(std::max(mpz_size(m_val), mpz_size(tmp.m_val)) + 1);
+        mpz_and(m_val, m_val, tmp.m_val);
         return *this;
     }
 
@@ -205,204 +381,367 @@ public:
         ASSERT_CONVERTIBLE(T);
         bigint out(*this);
         auto tmp = bigint(other);
-        mpz_and(out.m_val.get_mpz_t(), out.m_val.get_mpz_t(), tmp.m_val.get_mpz_t());
+        out.ensure(std::max(mpz_size(m_val), mpz_size(tmp.m_val)) + 1);
+        mpz_and(out.m_val, out.m_val, tmp.m_val);
         return out;
     }
 
     bigint& operator&=(const bigint& other) {
-        mpz_and(m_val.get_mpz_t(), m_val.get_mpz_t(), other.m_val.get_mpz_t());
+        ensure(std::max(mpz_size(m_val), mpz_size(other.m_val)) + 1);
+        mpz_and(m_val, m_val, other.m_val);
         return *this;
     }
 
     bigint operator&(const bigint& other) {
         bigint out(*this);
-        mpz_and(out.m_val.get_mpz_t(), out.m_val.get_mpz_t(), other.m_val.get_mpz_t());
+        out.ensure(std::max(mpz_size(m_val), mpz_size(other.m_val)) + 1);
+        mpz_and(out.m_val, out.m_val, other.m_val);
         return out;
     }
 
     bigint operator+(const bigint& other) const {
-        bigint out(m_val);
-        out.m_val += other.m_val;
+        bigint out;
+        out.ensure(std::max(mpz_size(m_val), mpz_size(other.m_val)) + 1);
+        mpz_add(out.m_val, m_val, other.m_val);
         return out;
     }
 
     ENABLE_IF_CONVERTIBLE(T)
     bigint& operator+=(const T& other) {
-        return *this += bigint(other);
+        ASSERT_CONVERTIBLE(T);
+        add_prim(*this, m_val, to_prim(other));
+        return *this;
     }
 
     bigint& operator+=(const bigint& other) {
-
-        m_val += other.m_val;
+        ensure(std::max(mpz_size(m_val), mpz_size(other.m_val)) + 1);
+        mpz_add(m_val, m_val, other.m_val);
         return *this;
     }
 
     bigint operator-(const bigint& other) const {
-        bigint out(m_val);
-        out.m_val -= other.m_val;
+        bigint out;
+        out.ensure(std::max(mpz_size(m_val), mpz_size(other.m_val)) + 1);
+        mpz_sub(out.m_val, m_val, other.m_val);
         return out;
     }
 
     ENABLE_IF_CONVERTIBLE(T)
     bigint& operator-=(const T& other) {
-        return *this -= bigint(other);
+        ASSERT_CONVERTIBLE(T);
+        sub_prim(*this, m_val, to_prim(other));
+        return *this;
     }
 
     bigint& operator-=(const bigint& other) {
-        m_val -= other.m_val;
+        ensure(std::max(mpz_size(m_val), mpz_size(other.m_val)) + 1);
+        mpz_sub(m_val, m_val, other.m_val);
         return *this;
     }
 
     bigint operator%(const bigint& other) const {
-        bigint out(m_val);
-        out.m_val %= other.m_val;
+        bigint out;
+        out.ensure(std::min(mpz_size(m_val), mpz_size(other.m_val)));
+        mpz_tdiv_r(out.m_val, m_val, other.m_val);
         return out;
     }
 
     ENABLE_IF_CONVERTIBLE(T)
     bigint& operator%=(const T& other) {
-        return *this %= bigint(other);
+        ASSERT_CONVERTIBLE(T);
+        mod_prim(*this, m_val, to_prim(other));
+        return *this;
     }
 
     bigint& operator%=(const bigint& other) {
-        m_val %= other.m_val;
+        ensure(std::min(mpz_size(m_val), mpz_size(other.m_val)));
+        mpz_tdiv_r(m_val, m_val, other.m_val);
         return *this;
     }
 
     bigint operator*(const bigint& other) const {
-        bigint out(m_val);
-        out.m_val *= other.m_val;
+        bigint out;
+        out.ensure(mpz_size(m_val) + mpz_size(other.m_val));
+        mpz_mul(out.m_val, m_val, other.m_val);
         return out;
     }
 
     ENABLE_IF_CONVERTIBLE(T)
     bigint& operator*=(const T& other) {
-        return *this *= bigint(other);
+        ASSERT_CONVERTIBLE(T);
+        mul_prim(*this, m_val, to_prim(other));
+        return *this;
     }
 
     bigint& operator*=(const bigint& other) {
-        m_val *= other.m_val;
+        ensure(mpz_size(m_val) + mpz_size(other.m_val));
+        mpz_mul(m_val, m_val, other.m_val);
         return *this;
     }
 
     bigint operator/(const bigint& other) const {
-        bigint out(m_val);
-
-        out.m_val /= other.m_val;
+        bigint out;
+        out.ensure(quot_size(m_val, other.m_val));
+        mpz_tdiv_q(out.m_val, m_val, other.m_val);
         return out;
     }
 
     ENABLE_IF_CONVERTIBLE(T)
     bigint& operator/=(const T& other) {
-        return *this /= bigint(other);
+        ASSERT_CONVERTIBLE(T);
+        div_prim(*this, m_val, to_prim(other));
+        return *this;
     }
 
     bigint& operator/=(const bigint& other) {
-        m_val /= other.m_val;
+        ensure(quot_size(m_val, other.m_val));
+        mpz_tdiv_q(m_val, m_val, other.m_val);
         return *this;
     }
 
     bool operator>(const bigint& other) const {
-        return m_val > other.m_val;
+        return mpz_cmp(m_val, other.m_val) > 0;
     }
 
     bool operator>=(const bigint& other) const {
-        return m_val >= other.m_val;
+        return mpz_cmp(m_val, other.m_val) >= 0;
     }
 
     bool operator<(const bigint& other) const {
-        return m_val < other.m_val;
+        return mpz_cmp(m_val, other.m_val) < 0;
     }
 
     bool operator<=(const bigint& other) const {
-        return m_val <= other.m_val;
+        return mpz_cmp(m_val, other.m_val) <= 0;
     }
 
     bool operator==(const bigint& other) const {
-        return m_val == other.m_val;
+        return mpz_cmp(m_val, other.m_val) == 0;
     }
 
     bool operator!=(const bigint& other) const {
-        return m_val != other.m_val;
+        return mpz_cmp(m_val, other.m_val) != 0;
     }
 
     /***********************************************************************/
     /*                      Comparison operators                   */
     /***********************************************************************/
     ENABLE_IF_CONVERTIBLE(T)
-    ALWAYS_INLINE bool operator==(const T& other) {
+    ALWAYS_INLINE bool operator==(const T& other) const {
         ASSERT_CONVERTIBLE(T);
-        return bigint(other) == (*this);
+        return cmp_prim(m_val, to_prim(other)) == 0;
     }
     ENABLE_IF_CONVERTIBLE(T)
-    ALWAYS_INLINE bool operator!=(const T& other) {
+    ALWAYS_INLINE bool operator!=(const T& other) const {
         ASSERT_CONVERTIBLE(T);
-        return bigint(other) != (*this);
+        return cmp_prim(m_val, to_prim(other)) != 0;
     }
     ENABLE_IF_CONVERTIBLE(T)
-    ALWAYS_INLINE bool operator<(const T& other) {
+    ALWAYS_INLINE bool operator<(const T& other) const {
         ASSERT_CONVERTIBLE(T);
-        return (*this) < bigint(other);
+        return cmp_prim(m_val, to_prim(other)) < 0;
     }
     ENABLE_IF_CONVERTIBLE(T)
-    ALWAYS_INLINE bool operator<=(const T& other) {
+    ALWAYS_INLINE bool operator<=(const T& other) const {
         ASSERT_CONVERTIBLE(T);
-        return (*this) >= bigint(other);
+        return cmp_prim(m_val, to_prim(other)) <= 0;
     }
     ENABLE_IF_CONVERTIBLE(T)
-    ALWAYS_INLINE bool operator>=(const T& other) {
+    ALWAYS_INLINE bool operator>=(const T& other) const {
         ASSERT_CONVERTIBLE(T);
-        return (*this) >= bigint(other);
+        return cmp_prim(m_val, to_prim(other)) >= 0;
     }
     ENABLE_IF_CONVERTIBLE(T)
-    ALWAYS_INLINE bool operator>(const T& other) {
+    ALWAYS_INLINE bool operator>(const T& other) const {
         ASSERT_CONVERTIBLE(T);
-        return (*this) > bigint(other);
+        return cmp_prim(m_val, to_prim(other)) > 0;
     }
 
     /***********************************************************************/
     /*                      Arithmetic operators                   */
     /***********************************************************************/
     ENABLE_IF_CONVERTIBLE(T)
-    ALWAYS_INLINE bigint operator+(const T& other) {
+    ALWAYS_INLINE bigint operator+(const T& other) const {
         ASSERT_CONVERTIBLE(T);
-        return bigint(other) + (*this);
+        bigint out;
+        add_prim(out, m_val, to_prim(other));
+        return out;
     }
     ENABLE_IF_CONVERTIBLE(T)
-    ALWAYS_INLINE bigint operator-(const T& other) {
+    ALWAYS_INLINE bigint operator-(const T& other) const {
         ASSERT_CONVERTIBLE(T);
-        return bigint(other) - (*this);
+        bigint out;
+        sub_prim(out, m_val, to_prim(other));
+        return out;
     }
     ENABLE_IF_CONVERTIBLE(T)
-    ALWAYS_INLINE bigint operator*(const T& other) {
+    ALWAYS_INLINE bigint operator*(const T& other) const {
         ASSERT_CONVERTIBLE(T);
-        return bigint(other) * (*this);
+        bigint out;
+        mul_prim(out, m_val, to_prim(other));
+        return out;
     }
     ENABLE_IF_CONVERTIBLE(T)
-    ALWAYS_INLINE bigint operator/(const T& other) {
+    ALWAYS_INLINE bigint operator/(const T& other) const {
         ASSERT_CONVERTIBLE(T);
-        return bigint(other) / (*this);
+        bigint out;
+        div_prim(out, m_val, to_prim(other));
+        return out;
     }
     ENABLE_IF_CONVERTIBLE(T)
-    ALWAYS_INLINE bigint operator%(const T& other) {
+    ALWAYS_INLINE bigint operator%(const T& other) const {
         ASSERT_CONVERTIBLE(T);
-        return bigint(other) % (*this);
+        bigint out;
+        mod_prim(out, m_val, to_prim(other));
+        return out;
+    }
+
+    /***********************************************************************/
+    /*                 Reverse operators with primitive operand            */
+    /***********************************************************************/
+    ENABLE_IF_CONVERTIBLE(T)
+    friend ALWAYS_INLINE bool operator==(const T& other, const bigint& self) {
+        return self == other;
+    }
+    ENABLE_IF_CONVERTIBLE(T)
+    friend ALWAYS_INLINE bool operator!=(const T& other, const bigint& self) {
+        return self != other;
+    }
+    ENABLE_IF_CONVERTIBLE(T)
+    friend ALWAYS_INLINE bool operator<(const T& other, const bigint& self) {
+        return self > other;
+    }
+    ENABLE_IF_CONVERTIBLE(T)
+    friend ALWAYS_INLINE bool operator<=(const T& other, const bigint& self) {
+        return self >= other;
+    }
+    ENABLE_IF_CONVERTIBLE(T)
+    friend ALWAYS_INLINE bool operator>=(const T& other, const bigint& self) {
+        return self <= other;
+    }
+    ENABLE_IF_CONVERTIBLE(T)
+    friend ALWAYS_INLINE bool operator>(const T& other, const bigint& self) {
+        return self < other;
     }
 
+    ENABLE_IF_CONVERTIBLE(T)
+    friend ALWAYS_INLINE bigint operator+(const T& other, const bigint& self) {
+        return self + other;
+    }
+    ENABLE_IF_CONVERTIBLE(T)
+    friend ALWAYS_INLINE bigint operator-(const T& other, const bigint& self) {
+        ASSERT_CONVERTIBLE(T);
+        bigint out;
+        sub_prim(out, self.m_val, to_prim(other));
+        mpz_neg(out.m_val, out.m_val);
+        return out;
+    }
+    ENABLE_IF_CONVERTIBLE(T)
+    friend ALWAYS_INLINE bigint operator*(const T& other, const bigint& self) {
+        return self * other;
+    }
+    ENABLE_IF_CONVERTIBLE(T)
+    friend ALWAYS_INLINE bigint operator/(const T& other, const bigint& self) {
+        ASSERT_CONVERTIBLE(T);
+        bigint out;
+        prim_divmod(out.m_val, nullptr, to_prim(other), self.m_val);
+        return out;
+    }
+    ENABLE_IF_CONVERTIBLE(T)
+    friend ALWAYS_INLINE bigint operator%(const T& other, const bigint& self) {
+        ASSERT_CONVERTIBLE(T);
+        bigint out;
+        prim_divmod(nullptr, out.m_val, to_prim(other), self.m_val);
+        return out;
+    }
+
+    /***********************************************************************/
+    /*                 Arithmetic with output parameters                   */
+    /***********************************************************************/
+    /* Results are written into existing limbs of out, that are grown only if value doesn't fit,
+     * so values reused across iterations of a loop stop allocating. Output may be one of operands. */
+
+    /// \brief out = a + b
+    static ALWAYS_INLINE void add(bigint& out, const bigint& a, const bigint& b) {
+        out.ensure(std::max(mpz_size(a.m_val), mpz_size(b.m_val)) + 1);
+        mpz_add(out.m_val, a.m_val, b.m_val);
+    }
+
+    /// \brief out = a - b
+    static ALWAYS_INLINE void sub(bigint& out, const bigint& a, const bigint& b) {
+        out.ensure(std::max(mpz_size(a.m_val), mpz_size(b.m_val)) + 1);
+        mpz_sub(out.m_val, a.m_val, b.m_val);
+    }
+
+    /// \brief out = a * b
+    static ALWAYS_INLINE void mul(bigint& out, const bigint& a, const bigint& b) {
+        out.ensure(mpz_size(a.m_val) + mpz_size(b.m_val));
+        mpz_mul(out.m_val, a.m_val, b.m_val);
+    }
+
+    /// \brief out += a * b
+    static ALWAYS_INLINE void addmul(bigint& out, const bigint& a, const bigint& b) {
+        out.ensure(std::max(mpz_size(out.m_val), mpz_size(a.m_val) + mpz_size(b.m_val)) + 1);
+        mpz_addmul(out.m_val, a.m_val, b.m_val);
+    }
+
+    /// \brief out -= a * b
+    static ALWAYS_INLINE void submul(bigint& out, const bigint& a, const bigint& b) {
+        out.ensure(std::max(mpz_size(out.m_val), mpz_size(a.m_val) + mpz_size(b.m_val)) + 1);
+        mpz_submul(out.m_val, a.m_val, b.m_val);
+    }
+
+    /// \brief Truncating quotient and remainder in one call: q = n / d, r = n % d, same as operator/ and operator%
+    /// \param q must be different object than r
+    /// \param d must not be zero, as for operator/
+    static ALWAYS_INLINE void tdiv_qr(bigint& q, bigint& r, const bigint& n, const bigint& d) {
+        const size_t qn = quot_size(n.m_val, d.m_val);
+        const size_t rn = mpz_size(d.m_val);
+        q.ensure(qn);
+        r.ensure(rn);
+        mpz_tdiv_qr(q.m_val, r.m_val, n.m_val, d.m_val);
+    }
+
+    /// \brief out = base ^ exp
+    static void pow_ui(bigint& out, const bigint& base, unsigned long int exp);
+
+    /// \brief Integer square root with remainder: s = floor(sqrt(n)), r = n - s * s
+    /// \param s must be different object than r
+    /// \throws value_error if n is negative
+    static void sqrt_rem(bigint& s, bigint& r, const bigint& n);
+
     int32_t get_radix() const;
 
     mp_bitcnt_t get_precision() const;
 
     std::string str() const;
 
+    /// \brief Writes str() output to [first, last), no null terminator is written.
+    /// Heap is not used if range is large enough or value has less than 150 digits
+    /// \return ptr past last written char, or last with std::errc::value_too_large if range is too small
+    std::to_chars_result to_chars(char* first, char* last) const;
+
+    /// \brief Appends str() output to the end of string
+    void append_to(std::string& out) const;
+
     std::vector<uint8_t> export_bytes() const;
 
     void import_bytes(const std::vector<uint8_t>& input);
 
-    friend std::ostream& operator<<(std::ostream& os, const bigint& val) {
-        os << val.str();
-        return os;
-    }
+    /// \brief Returns count of bytes written by export_to() without fixed_width: bytes of absolute value, 1 for zero
+    size_t byte_size() const;
+
+    /// \brief Writes absolute value to out, as export_bytes() does, without allocation.
+    /// \param fixed_width if true, value is padded with zeros to len bytes (e.g. 32 bytes of uint256),
+    /// otherwise byte_size() bytes are written
+    /// \return count of written bytes
+    /// \throws value_error if len is less than byte_size()
+    size_t export_to(uint8_t* out, size_t len, endian order = endian::big, bool fixed_width = false) const;
+
+    /// \brief Sets value from len bytes of unsigned integer, leading zeros are allowed
+    void import_from(const uint8_t* data, size_t len, endian order = endian::big);
+
+    friend std::ostream& operator<<(std::ostream& os, const bigint& val);
 };
 
 BIGMATHPP_API extern const bigint ZERO;
@@ -410,69 +749,6 @@ BIGMATHPP_API extern const bigint ONE;
 BIGMATHPP_API extern const bigint TWO;
 BIGMATHPP_API extern const bigint THREE;
 
-/***********************************************************************/
-/*                      Reverse comparison operators                   */
-/***********************************************************************/
-ENABLE_IF_CONVERTIBLE(T)
-ALWAYS_INLINE bool operator==(const T& other, const bigint& self) {
-    ASSERT_CONVERTIBLE(T);
-    return bigint(other) == self;
-}
-ENABLE_IF_CONVERTIBLE(T)
-ALWAYS_INLINE bool operator!=(const T& other, const bigint& self) {
-    ASSERT_CONVERTIBLE(T);
-    return bigint(other) != self;
-}
-ENABLE_IF_CONVERTIBLE(T)
-ALWAYS_INLINE bool operator<(const T& other, const bigint& self) {
-    ASSERT_CONVERTIBLE(T);
-    return bigint(other) < self;
-}
-ENABLE_IF_CONVERTIBLE(T)
-ALWAYS_INLINE bool operator<=(const T& other, const bigint& self) {
-    ASSERT_CONVERTIBLE(T);
-    return bigint(other) <= self;
-}
-ENABLE_IF_CONVERTIBLE(T)
-ALWAYS_INLINE bool operator>=(const T& other, const bigint& self) {
-    ASSERT_CONVERTIBLE(T);
-    return bigint(other) >= self;
-}
-ENABLE_IF_CONVERTIBLE(T)
-ALWAYS_INLINE bool operator>(const T& other, const bigint& self) {
-    ASSERT_CONVERTIBLE(T);
-    return bigint(other) > self;
-}
-
-/***********************************************************************/
-/*                      Reverse arithmetic operators                   */
-/***********************************************************************/
-ENABLE_IF_CONVERTIBLE(T)
-ALWAYS_INLINE bigint operator+(const T& other, const bigint& self) {
-    ASSERT_CONVERTIBLE(T);
-    return bigint(other) + self;
-}
-ENABLE_IF_CONVERTIBLE(T)
-ALWAYS_INLINE bigint operator-(const T& other, const bigint& self) {
-    ASSERT_CONVERTIBLE(T);
-    return bigint(other) - self;
-}
-ENABLE_IF_CONVERTIBLE(T)
-ALWAYS_INLINE bigint operator*(const T& other, const bigint& self) {
-    ASSERT_CONVERTIBLE(T);
-    return bigint(other) * self;
-}
-ENABLE_IF_CONVERTIBLE(T)
-ALWAYS_INLINE bigint operator/(const T& other, const bigint& self) {
-    ASSERT_CONVERTIBLE(T);
-    return bigint(other) / self;
-}
-ENABLE_IF_CONVERTIBLE(T)
-ALWAYS_INLINE bigint operator%(const T& other, const bigint& self) {
-    ASSERT_CONVERTIBLE(T);
-    return bigint(other) % self;
-}
-
 } // namespace bigmath
 
 #endif // BIGMATHPP_BIGINT_H
@@ -0,0 +1,236 @@
+/*!
+ * bigmath.
+ * bigint_expr.h
+ *
+ * \date 10/17/2026
+ * \author Eduard Maximovich (edward.vstock@gmail.com)
+ * \link   https://github.com/edwardstock
+ */
+#ifndef BIGMATHPP_BIGINT_EXPR_H
+#define BIGMATHPP_BIGINT_EXPR_H
+
+#include "bigint.h"
+
+#include <algorithm>
+#include <type_traits>
+#include <utility>
+
+namespace bigmath {
+
+/* Lazy bigint expressions: lazy(a) * b + c * d builds a tree of references to operands, that is computed
+ * when assigned or added to bigint. Destination limbs are reserved once for the whole expression, then first
+ * term is written to destination and others are accumulated into it: products with mpz_addmul/mpz_submul,
+ * so sum of products doesn't create temporaries. Only products of subexpressions, like (a + b) * c,
+ * compute their factors into scratch values. */
+namespace expr {
+
+enum class int_op {
+    add,
+    sub,
+    mul,
+};
+
+struct int_leaf {
+    const bigint& value;
+};
+
+template<int_op Op, typename L, typename R>
+struct int_node {
+    L left;
+    R right;
+};
+
+template<typename T>
+struct is_int_expr : std::false_type {};
+template<>
+struct is_int_expr<int_leaf> : std::true_type {};
+template<int_op Op, typename L, typename R>
+struct is_int_expr<int_node<Op, L, R>> : std::true_type {};
+
+template<typename T>
+struct int_wrapped {
+    using type = T;
+    static const T& wrap(const T& v) {
+        return v;
+    }
+};
+template<>
+struct int_wrapped<bigint> {
+    using type = int_leaf;
+    static int_leaf wrap(const bigint& v) {
+        return int_leaf{v};
+    }
+};
+
+/* at least one operand is an expression, so plain bigint operators are not affected */
+template<typename L, typename R>
+using enable_if_int_expr = typename std::enable_if<(is_int_expr<L>::value || is_int_expr<R>::value) &&
+                                                   (is_int_expr<L>::value || std::is_same<L, bigint>::value) &&
+                                                   (is_int_expr<R>::value || std::is_same<R, bigint>::value)>::type;
+
+#define BIGMATH_INT_EXPR_OPERATOR(SYMBOL, OP)                                                         \
+    template<typename L, typename R, typename = enable_if_int_expr<L, R>>                             \
+    ALWAYS_INLINE int_node<OP, typename int_wrapped<L>::type, typename int_wrapped<R>::type> operator SYMBOL( \
+        const L& left, const R& right) {                                                              \
+        return {int_wrapped<L>::wrap(left), int_wrapped<R>::wrap(right)};                             \
+    }
+
+BIGMATH_INT_EXPR_OPERATOR(+, int_op::add)
+BIGMATH_INT_EXPR_OPERATOR(-, int_op::sub)
+BIGMATH_INT_EXPR_OPERATOR(*, int_op::mul)
+
+#undef BIGMATH_INT_EXPR_OPERATOR
+
+} // namespace expr
+
+namespace detail {
+
+template<>
+struct is_bigint_expr<expr::int_leaf> : std::true_type {};
+template<expr::int_op Op, typename L, typename R>
+struct is_bigint_expr<expr::int_node<Op, L, R>> : std::true_type {};
+
+struct bigint_access {
+    static ALWAYS_INLINE mpz_ptr val(bigint& v) {
+        return v.m_val;
+    }
+    static ALWAYS_INLINE mpz_srcptr val(const bigint& v) {
+        return v.m_val;
+    }
+    static ALWAYS_INLINE void ensure(bigint& v, size_t n) {
+        v.ensure(n);
+    }
+};
+
+} // namespace detail
+
+namespace expr {
+
+/* upper bound of result size in limbs */
+ALWAYS_INLINE size_t limbs(const int_leaf& e) {
+    return mpz_size(detail::bigint_access::val(e.value));
+}
+
+template<int_op Op, typename L, typename R>
+ALWAYS_INLINE size_t limbs(const int_node<Op, L, R>& e) {
+    if (Op == int_op::mul) {
+        return limbs(e.left) + limbs(e.right);
+    }
+    return std::max(limbs(e.left), limbs(e.right)) + 1;
+}
+
+ALWAYS_INLINE bool uses(const int_leaf& e, const bigint& v) {
+    return &e.value == &v;
+}
+
+template<int_op Op, typename L, typename R>
+ALWAYS_INLINE bool uses(const int_node<Op, L, R>& e, const bigint& v) {
+    return uses(e.left, v) || uses(e.right, v);
+}
+
+/* result = e, result has room for limbs(e) and isn't used by e */
+ALWAYS_INLINE void assign_to(mpz_ptr result, const int_leaf& e) {
+    mpz_set(result, detail::bigint_access::val(e.value));
+}
+
+template<int_op Op, typename L, typename R>
+void assign_to(mpz_ptr result, const int_node<Op, L, R>& e);
+
+/* result += e or result -= e */
+ALWAYS_INLINE void accumulate(mpz_ptr result, const int_leaf& e, bool neg) {
+    if (neg) {
+        mpz_sub(result, result, detail::bigint_access::val(e.value));
+    } else {
+        mpz_add(result, result, detail::bigint_access::val(e.value));
+    }
+}
+
+template<int_op Op, typename L, typename R>
+void accumulate(mpz_ptr result, const int_node<Op, L, R>& e, bool neg);
+
+/* factor of product: leaf is used as is, subexpression is computed into scratch */
+ALWAYS_INLINE mpz_srcptr factor(const int_leaf& e, bigint&) {
+    return detail::bigint_access::val(e.value);
+}
+
+template<int_op Op, typename L, typename R>
+ALWAYS_INLINE mpz_srcptr factor(const int_node<Op, L, R>& e, bigint& scratch) {
+    detail::bigint_access::ensure(scratch, limbs(e) + 1);
+    assign_to(detail::bigint_access::val(scratch), e);
+    return detail::bigint_access::val(scratch);
+}
+
+template<int_op Op, typename L, typename R>
+void assign_to(mpz_ptr result, const int_node<Op, L, R>& e) {
+    if constexpr (Op == int_op::mul) {
+        bigint tmp_l, tmp_r;
+        mpz_mul(result, factor(e.left, tmp_l), factor(e.right, tmp_r));
+    } else {
+        assign_to(result, e.left);
+        accumulate(result, e.right, Op == int_op::sub);
+    }
+}
+
+template<int_op Op, typename L, typename R>
+void accumulate(mpz_ptr result, const int_node<Op, L, R>& e, bool neg) {
+    if constexpr (Op == int_op::mul) {
+        bigint tmp_l, tmp_r;
+        mpz_srcptr a = factor(e.left, tmp_l);
+        mpz_srcptr b = factor(e.right, tmp_r);
+        if (neg) {
+            mpz_submul(result, a, b);
+        } else {
+            mpz_addmul(result, a, b);
+        }
+    } else {
+        accumulate(result, e.left, neg);
+        accumulate(result, e.right, neg != (Op == int_op::sub));
+    }
+}
+
+/* found by ADL from bigint constructor and assignment operators */
+template<typename E>
+void assign_expr(bigint& result, const E& e) {
+    if (uses(e, result)) {
+        bigint tmp;
+        assign_expr(tmp, e);
+        result = std::move(tmp);
+        return;
+    }
+    detail::bigint_access::ensure(result, limbs(e) + 1);
+    assign_to(detail::bigint_access::val(result), e);
+}
+
+template<typename E>
+void add_expr(bigint& result, const E& e, bool neg) {
+    if (uses(e, result)) {
+        bigint tmp(e);
+        if (neg) {
+            result -= tmp;
+        } else {
+            result += tmp;
+        }
+        return;
+    }
+    mpz_srcptr r = detail::bigint_access::val(result);
+    detail::bigint_access::ensure(result, std::max(mpz_size(r), limbs(e)) + 2);
+    accumulate(detail::bigint_access::val(result), e, neg);
+}
+
+} // namespace expr
+
+/// \brief Starts lazy expression: lazy(a) * b + c * d is computed when assigned or added to bigint
+/// Expression keeps references to operands, so it must not outlive them.
+ALWAYS_INLINE expr::int_leaf lazy(const bigint& v) {
+    return expr::int_leaf{v};
+}
+
+/// \brief Computes lazy bigint expression into new value
+template<typename E, typename = typename std::enable_if<detail::is_bigint_expr<E>::value>::type>
+bigint eval(const E& e) {
+    return bigint(e);
+}
+
+} // namespace bigmath
+
+#endif //BIGMATHPP_BIGINT_EXPR_H
@@ -0,0 +1,260 @@
+/*!
+ * bigmath.
+ * checked.h
+ *
+ * \date 10/17/2026
+ * \author Eduard Maximovich (edward.vstock@gmail.com)
+ * \link   https://github.com/edwardstock
+ */
+#ifndef BIGMATHPP_CHECKED_H
+#define BIGMATHPP_CHECKED_H
+
+#include "bigdecimal.h"
+#include "bigint.h"
+#include "bigint_expr.h"
+
+#include <cstdint>
+#include <string_view>
+#include <utility>
+
+namespace bigmath {
+
+/// \brief Value with mpdecimal status flags of operation that computed it. Returned by bigmath::checked
+/// functions instead of raising traps, so errors are handled without exceptions.
+template<typename T>
+struct result {
+    /// \brief Flags that make result not ok(): default traps of context and malloc error
+    static constexpr uint32_t ERRORS = MPD_Traps | MPD_Malloc_error;
+
+    T value;
+    uint32_t status = 0;
+
+    /// \brief false if status has invalid operation (including conversion syntax), division by zero,
+    /// overflow, underflow or malloc error. Inexact or rounded results are ok.
+    bool ok() const noexcept {
+        return (status & ERRORS) == 0;
+    }
+    explicit operator bool() const noexcept {
+        return ok();
+    }
+
+    /// \brief true if any of flags is set, e.g. has(MPD_Division_by_zero)
+    bool has(uint32_t flags) const noexcept {
+        return (status & flags) != 0;
+    }
+
+    /// \brief Adds status to context, as function with context argument would do, and returns value
+    /// \throws bigdecimal_exception if context traps any of flags
+    T& raise(bd_context& c = context) & {
+        c.raise(status);
+        return value;
+    }
+    T raise(bd_context& c = context) && {
+        c.raise(status);
+        return std::move(value);
+    }
+};
+
+/* Functions that report errors in result::status instead of exceptions. Context is never modified: status
+ * is not added to it and its traps are ignored. Functions without context argument use precision of
+ * arithmetic operators, see bigmath::precision_policy. Only failed heap allocation of bigint may still throw. */
+namespace checked {
+
+namespace detail {
+
+using binary_fn = void (*)(mpd_t*, const mpd_t*, const mpd_t*, const mpd_context_t*, uint32_t*);
+
+template<mpd_ssize_t N>
+ALWAYS_INLINE result<basic_bigdecimal<N>> binary(binary_fn fn, const basic_bigdecimal<N>& a, const basic_bigdecimal<N>& b,
+                                                 const mpd_context_t& ctx) {
+    result<basic_bigdecimal<N>> r;
+    fn(r.value.get(), a.getconst(), b.getconst(), &ctx, &r.status);
+    return r;
+}
+
+/* context of arithmetic operators */
+template<mpd_ssize_t N>
+ALWAYS_INLINE mpd_context_t operator_context(const basic_bigdecimal<N>& a, const basic_bigdecimal<N>& b) {
+    if (context.policy() == precision_policy::fixed) {
+        return *context.getconst();
+    }
+    return *a.calc_precision(a, b).getconst();
+}
+
+ALWAYS_INLINE bool is_zero(const bigint& v) {
+    return mpz_sgn(bigmath::detail::bigint_access::val(v)) == 0;
+}
+
+} // namespace detail
+
+/***********************************************************************/
+/*                         bigdecimal arithmetic                       */
+/***********************************************************************/
+template<mpd_ssize_t N>
+result<basic_bigdecimal<N>> add(const basic_bigdecimal<N>& a, const basic_bigdecimal<N>& b, const bd_context& c) {
+    return detail::binary(mpd_qadd, a, b, *c.getconst());
+}
+/// \brief Same precision as a + b
+template<mpd_ssize_t N>
+result<basic_bigdecimal<N>> add(const basic_bigdecimal<N>& a, const basic_bigdecimal<N>& b) {
+    return detail::binary(mpd_qadd, a, b, detail::operator_context(a, b));
+}
+
+template<mpd_ssize_t N>
+result<basic_bigdecimal<N>> sub(const basic_bigdecimal<N>& a, const basic_bigdecimal<N>& b, const bd_context& c) {
+    return detail::binary(mpd_qsub, a, b, *c.getconst());
+}
+/// \brief Same precision as a - b
+template<mpd_ssize_t N>
+result<basic_bigdecimal<N>> sub(const basic_bigdecimal<N>& a, const basic_bigdecimal<N>& b) {
+    return detail::binary(mpd_qsub, a, b, detail::operator_context(a, b));
+}
+
+template<mpd_ssize_t N>
+result<basic_bigdecimal<N>> mul(const basic_bigdecimal<N>& a, const basic_bigdecimal<N>& b, const bd_context& c) {
+    return detail::binary(mpd_qmul, a, b, *c.getconst());
+}
+/// \brief Same precision as a * b
+template<mpd_ssize_t N>
+result<basic_bigdecimal<N>> mul(const basic_bigdecimal<N>& a, const basic_bigdecimal<N>& b) {
+    return detail::binary(mpd_qmul, a, b, detail::operator_context(a, b));
+}
+
+/// \brief Quotient, status has MPD_Division_by_zero (or MPD_Division_undefined for 0 / 0) if b is zero
+template<mpd_ssize_t N>
+result<basic_bigdecimal<N>> div(const basic_bigdecimal<N>& a, const basic_bigdecimal<N>& b, const bd_context& c) {
+    return detail::binary(mpd_qdiv, a, b, *c.getconst());
+}
+/// \brief Same precision as a / b
+template<mpd_ssize_t N>
+result<basic_bigdecimal<N>> div(const basic_bigdecimal<N>& a, const basic_bigdecimal<N>& b) {
+    return detail::binary(mpd_qdiv, a, b, detail::operator_context(a, b));
+}
+
+template<mpd_ssize_t N>
+result<basic_bigdecimal<N>> divint(const basic_bigdecimal<N>& a, const basic_bigdecimal<N>& b, const bd_context& c = context) {
+    return detail::binary(mpd_qdivint, a, b, *c.getconst());
+}
+
+/// \brief Remainder, context is the same as of a % b by default
+template<mpd_ssize_t N>
+result<basic_bigdecimal<N>> rem(const basic_bigdecimal<N>& a, const basic_bigdecimal<N>& b, const bd_context& c = context) {
+    return detail::binary(mpd_qrem, a, b, *c.getconst());
+}
+
+template<mpd_ssize_t N>
+result<basic_bigdecimal<N>> quantize(const basic_bigdecimal<N>& a, const basic_bigdecimal<N>& exp, const bd_context& c = context) {
+    return detail::binary(mpd_qquantize, a, exp, *c.getconst());
+}
+
+/// \brief a * b + addend, rounded once
+template<mpd_ssize_t N>
+result<basic_bigdecimal<N>> fma(const basic_bigdecimal<N>& a,
+                                const basic_bigdecimal<N>& b,
+                                const basic_bigdecimal<N>& addend,
+                                const bd_context& c = context) {
+    result<basic_bigdecimal<N>> r;
+    mpd_qfma(r.value.get(), a.getconst(), b.getconst(), addend.getconst(), c.getconst(), &r.status);
+    return r;
+}
+
+template<mpd_ssize_t N>
+result<basic_bigdecimal<N>> sqrt(const basic_bigdecimal<N>& a, const bd_context& c = context) {
+    result<basic_bigdecimal<N>> r;
+    mpd_qsqrt(r.value.get(), a.getconst(), c.getconst(), &r.status);
+    return r;
+}
+
+/***********************************************************************/
+/*                               Parsing                               */
+/***********************************************************************/
+/// \brief Parses s as basic_bigdecimal::set_str() does, status has MPD_Conversion_syntax for invalid string
+template<mpd_ssize_t N = MINALLOC>
+result<basic_bigdecimal<N>> parse(std::string_view s) {
+    result<basic_bigdecimal<N>> r;
+    bigmath::detail::decimal_parse(r.value.get(), s, &r.status);
+    return r;
+}
+
+/// \brief Parses s exactly as basic_bigdecimal::exact() does, full syntax including NaN and Infinity
+template<mpd_ssize_t N = MINALLOC>
+result<basic_bigdecimal<N>> exact(const char* s) {
+    result<basic_bigdecimal<N>> r;
+    mpd_qset_string_exact(r.value.get(), s, &r.status);
+    return r;
+}
+
+/// \brief Parses [-]digits in radix 2..36, status has MPD_Conversion_syntax for invalid string
+BIGMATHPP_API result<bigint> parse_bigint(std::string_view s, int32_t radix = 10);
+
+/***********************************************************************/
+/*                          Integer conversion                         */
+/***********************************************************************/
+/* MPD_Invalid_operation if value is not integer or out of range, as i64() and others throw value_error */
+template<mpd_ssize_t N>
+result<int64_t> to_i64(const basic_bigdecimal<N>& a) {
+    result<int64_t> r;
+    r.value = mpd_qget_i64(a.getconst(), &r.status);
+    return r;
+}
+
+template<mpd_ssize_t N>
+result<int32_t> to_i32(const basic_bigdecimal<N>& a) {
+    result<int32_t> r;
+    r.value = mpd_qget_i32(a.getconst(), &r.status);
+    return r;
+}
+
+template<mpd_ssize_t N>
+result<uint64_t> to_u64(const basic_bigdecimal<N>& a) {
+    result<uint64_t> r;
+    r.value = mpd_qget_u64(a.getconst(), &r.status);
+    return r;
+}
+
+template<mpd_ssize_t N>
+result<uint32_t> to_u32(const basic_bigdecimal<N>& a) {
+    result<uint32_t> r;
+    r.value = mpd_qget_u32(a.getconst(), &r.status);
+    return r;
+}
+
+/// \brief Rounds value to integer with context rounding, as basic_bigdecimal::to_bigint().
+/// MPD_Invalid_operation for NaN and Infinity.
+template<mpd_ssize_t N>
+result<bigint> to_bigint(const basic_bigdecimal<N>& a, const bd_context& c = context) {
+    result<bigint> r;
+    if (a.isspecial()) {
+        r.status = MPD_Invalid_operation;
+        return r;
+    }
+    bd_context quiet(*c.getconst());
+    quiet.get()->traps = 0;
+    quiet.clear_status();
+    r.value = bigmath::detail::decimal_to_bigint(a.getconst(), quiet);
+    r.status = quiet.status();
+    return r;
+}
+
+/* MPD_Invalid_operation if value is out of range: builtin conversion operators of bigint truncate it */
+BIGMATHPP_API result<int64_t> to_i64(const bigint& a);
+BIGMATHPP_API result<uint64_t> to_u64(const bigint& a);
+
+/***********************************************************************/
+/*                           bigint arithmetic                         */
+/***********************************************************************/
+/* GMP aborts on division by zero, these functions report MPD_Division_by_zero instead */
+
+/// \brief Truncating quotient, as a / b
+BIGMATHPP_API result<bigint> div(const bigint& a, const bigint& b);
+/// \brief Remainder with sign of a, as a % b
+BIGMATHPP_API result<bigint> mod(const bigint& a, const bigint& b);
+/// \brief Quotient and remainder, as bigint::tdiv_qr()
+BIGMATHPP_API result<std::pair<bigint, bigint>> divmod(const bigint& a, const bigint& b);
+/// \brief Integer square root, MPD_Invalid_operation if a is negative
+BIGMATHPP_API result<bigint> sqrt(const bigint& a);
+
+} // namespace checked
+} // namespace bigmath
+
+#endif //BIGMATHPP_CHECKED_H
@@ -0,0 +1,122 @@
+/*!
+ * bigmath.
+ * decimal_column.h
+ *
+ * \date 10/17/2026
+ * \author Eduard Maximovich (edward.vstock@gmail.com)
+ * \link   https://github.com/edwardstock
+ */
+#ifndef BIGMATHPP_DECIMAL_COLUMN_H
+#define BIGMATHPP_DECIMAL_COLUMN_H
+
+#include "bigdecimal.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace bigmath {
+
+/// \brief Columnar storage of decimals: flags, exponents, digit counts and coefficient words are kept
+/// in separate contiguous arrays. Coefficient of up to INLINE_WORDS words (38 digits with 64-bit words) is stored
+/// in place, larger ones are moved to a side array. Element takes 1 + 2 * sizeof(mpd_ssize_t) +
+/// INLINE_WORDS * sizeof(mpd_uint_t) bytes instead of sizeof(bigdecimal), and arrays hold plain integers without pointers to themselves,
+/// so column is copied and moved as a few memcpy.
+///
+/// sum, add and compare kernels handle finite small values with common exponent (usual for amounts with fixed
+/// count of digits after point) with integer arithmetic on coefficient words, other values go through mpdecimal.
+class BIGMATHPP_API decimal_column {
+public:
+    static constexpr mpd_ssize_t INLINE_WORDS = 2;
+
+    decimal_column() = default;
+
+    template<mpd_ssize_t N>
+    explicit decimal_column(const std::vector<basic_bigdecimal<N>>& values) {
+        reserve(values.size());
+        for (const auto& v : values) {
+            push_back(v);
+        }
+    }
+
+    size_t size() const;
+    bool empty() const;
+    void reserve(size_t n);
+    void clear();
+
+    void push_back(const mpd_t* v);
+    template<mpd_ssize_t N>
+    void push_back(const basic_bigdecimal<N>& v) {
+        push_back(v.getconst());
+    }
+
+    /// \brief Replaces element. Side array is not compacted when large coefficient is replaced.
+    void set(size_t i, const mpd_t* v);
+    template<mpd_ssize_t N>
+    void set(size_t i, const basic_bigdecimal<N>& v) {
+        set(i, v.getconst());
+    }
+
+    /// \brief Returns read-only decimal that points to coefficient inside of column, without copying.
+    /// It can be passed to mpd_* functions as operand, and it's valid until column is modified.
+    mpd_t view(size_t i) const;
+
+    /// \brief Returns copy of element
+    template<mpd_ssize_t N = MINALLOC>
+    basic_bigdecimal<N> get(size_t i) const {
+        basic_bigdecimal<N> result;
+        const mpd_t v = view(i);
+        if (!mpd_qcopy_cxx(result.get(), &v)) {
+            context.raise(MPD_Malloc_error);
+        }
+        return result;
+    }
+    bigdecimal operator[](size_t i) const {
+        return get(i);
+    }
+
+    bool issigned(size_t i) const;
+    mpd_ssize_t exponent(size_t i) const;
+    mpd_ssize_t digits(size_t i) const;
+
+    /// \brief Sum of all elements, computed exactly and rounded once with context c
+    bigdecimal sum(bd_context& c) const;
+    /// \brief Sum with precision of arithmetic operators, as batch::sum()
+    bigdecimal sum() const;
+
+    /// \brief out[i] = a[i] + b[i], each result is rounded with context c, status is raised once.
+    /// out is resized to size of operands and may be the same column as a or b.
+    /// \throws value_error if sizes of a and b differ
+    static void add(const decimal_column& a, const decimal_column& b, decimal_column& out, bd_context& c);
+    /// \brief out[i] = a[i] + b[i] with precision of operator+
+    static void add(const decimal_column& a, const decimal_column& b, decimal_column& out);
+
+    /// \brief out[i] = mpd_qcmp(a[i], b[i]): -1, 0 or 1, INT_MAX if any of operands is NaN.
+    /// As with comparison operators, NaN raises invalid operation through thread context, once for all elements.
+    /// \throws value_error if sizes of a and b differ
+    static void compare(const decimal_column& a, const decimal_column& b, std::vector<int>& out);
+
+private:
+    /* mpd flags without memory attributes: sign and special */
+    std::vector<uint8_t> m_flags;
+    std::vector<mpd_ssize_t> m_exp;
+    std::vector<mpd_ssize_t> m_digits;
+    /* INLINE_WORDS per element, unused words are 0. First word of large coefficient is offset in m_spill */
+    std::vector<mpd_uint_t> m_words;
+    std::vector<mpd_uint_t> m_spill;
+
+    void store(size_t i, const mpd_t* v);
+    void resize(size_t n);
+
+    /* operand_prec: precision of every element is max(digits) of operands, as in operator+ */
+    static void add_impl(const decimal_column& a,
+                         const decimal_column& b,
+                         decimal_column& out,
+                         mpd_context_t ctx,
+                         bool operand_prec,
+                         uint32_t* status);
+};
+
+} // namespace bigmath
+
+#endif //BIGMATHPP_DECIMAL_COLUMN_H
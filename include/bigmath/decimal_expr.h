@@ -0,0 +1,276 @@
+/*!
+ * bigmath.
+ * decimal_expr.h
+ *
+ * \date 10/17/2026
+ * \author Eduard Maximovich (edward.vstock@gmail.com)
+ * \link   https://github.com/edwardstock
+ */
+#ifndef BIGMATHPP_DECIMAL_EXPR_H
+#define BIGMATHPP_DECIMAL_EXPR_H
+
+#include "bigdecimal.h"
+
+#include <algorithm>
+#include <type_traits>
+
+namespace bigmath {
+
+/* Lazy bigdecimal expressions: lazy(a) * b / c + d builds a tree of references to operands, that is computed
+ * by eval() into a single result. Intermediate add, sub and mul are exact, intermediate division keeps
+ * GUARD_DIGITS extra digits with ROUND_05UP. Add or sub of rounded values can cancel leading digits and
+ * consume the guard, then expression is computed again with more guard digits (Ziv loop), at most MAX_PASSES
+ * times. Result is correctly rounded, unless exact value is closer to rounding boundary than error of
+ * rounded intermediates, then it can differ by one unit in the last place. Rounded values that cancel
+ * completely (1 / 3 * 3 - 1) are computed MAX_PASSES times and give tiny nonzero result instead of zero.
+ * Left subexpression is computed in place of its parent, so scratch values are needed only for right ones. */
+namespace expr {
+
+enum class op {
+    add,
+    sub,
+    mul,
+    div,
+};
+
+template<mpd_ssize_t N>
+struct leaf {
+    static constexpr mpd_ssize_t words = N;
+    const basic_bigdecimal<N>& value;
+};
+
+template<op Op, typename L, typename R>
+struct node {
+    static_assert(L::words == R::words, "operands of expression must have same bigdecimal type");
+    static constexpr mpd_ssize_t words = L::words;
+    L left;
+    R right;
+};
+
+template<typename T>
+struct is_expr : std::false_type {};
+template<mpd_ssize_t N>
+struct is_expr<leaf<N>> : std::true_type {};
+template<op Op, typename L, typename R>
+struct is_expr<node<Op, L, R>> : std::true_type {};
+
+template<typename T>
+struct is_operand : is_expr<T> {};
+template<mpd_ssize_t N>
+struct is_operand<basic_bigdecimal<N>> : std::true_type {};
+
+template<typename T>
+struct wrapped {
+    using type = T;
+    static const T& wrap(const T& v) {
+        return v;
+    }
+};
+template<mpd_ssize_t N>
+struct wrapped<basic_bigdecimal<N>> {
+    using type = leaf<N>;
+    static leaf<N> wrap(const basic_bigdecimal<N>& v) {
+        return leaf<N>{v};
+    }
+};
+
+/* at least one operand is an expression, so plain bigdecimal operators are not affected */
+template<typename L, typename R>
+using enable_if_expr = typename std::enable_if<(is_expr<L>::value || is_expr<R>::value) &&
+                                               is_operand<L>::value && is_operand<R>::value>::type;
+
+#define BIGMATH_EXPR_OPERATOR(SYMBOL, OP)                                                                        \
+    template<typename L, typename R, typename = enable_if_expr<L, R>>                                            \
+    ALWAYS_INLINE node<OP, typename wrapped<L>::type, typename wrapped<R>::type> operator SYMBOL(const L& left,   \
+                                                                                                const R& right) { \
+        return {wrapped<L>::wrap(left), wrapped<R>::wrap(right)};                                                \
+    }
+
+BIGMATH_EXPR_OPERATOR(+, op::add)
+BIGMATH_EXPR_OPERATOR(-, op::sub)
+BIGMATH_EXPR_OPERATOR(*, op::mul)
+BIGMATH_EXPR_OPERATOR(/, op::div)
+
+#undef BIGMATH_EXPR_OPERATOR
+
+/***********************************************************************/
+/*                              Evaluation                             */
+/***********************************************************************/
+
+/* ROUND_05UP keeps information for correct second rounding with at least one extra digit */
+constexpr mpd_ssize_t GUARD_DIGITS = 3;
+/* complete cancellation loses all digits on every pass, so count of passes is limited */
+constexpr int MAX_PASSES = 4;
+
+struct eval_state {
+    /* exact intermediate add, sub and mul */
+    mpd_context_t exact;
+    /* intermediate division */
+    mpd_context_t work;
+    uint32_t status;
+    /* leading digits of rounded operands cancelled by add or sub */
+    mpd_ssize_t lost;
+
+    eval_state(const mpd_context_t& final, mpd_ssize_t guard) {
+        mpd_maxcontext(&exact);
+        exact.traps = 0;
+        exact.emax = final.emax;
+        exact.emin = final.emin;
+        work = exact;
+        work.prec = std::min<mpd_ssize_t>(final.prec + guard, MPD_MAX_PREC);
+        work.round = MPD_ROUND_05UP;
+        status = 0;
+        lost = 0;
+    }
+};
+
+template<mpd_ssize_t N>
+ALWAYS_INLINE mpd_ssize_t max_digits(const leaf<N>& e) {
+    return e.value.getconst()->digits;
+}
+
+template<op Op, typename L, typename R>
+ALWAYS_INLINE mpd_ssize_t max_digits(const node<Op, L, R>& e) {
+    return std::max(max_digits(e.left), max_digits(e.right));
+}
+
+template<op Op>
+ALWAYS_INLINE void apply(mpd_t* result, const mpd_t* a, const mpd_t* b, const mpd_context_t* ctx, uint32_t* status) {
+    switch (Op) {
+        case op::add:
+            mpd_qadd(result, a, b, ctx, status);
+            break;
+        case op::sub:
+            mpd_qsub(result, a, b, ctx, status);
+            break;
+        case op::mul:
+            mpd_qmul(result, a, b, ctx, status);
+            break;
+        case op::div:
+            mpd_qdiv(result, a, b, ctx, status);
+            break;
+    }
+}
+
+template<op Op, typename L, typename R>
+bool eval_node(mpd_t* result, const node<Op, L, R>& e, eval_state& st, const mpd_context_t* ctx);
+
+/* operand value: leaf is used as is, subexpression is computed into scratch. inexact is set if value is rounded */
+template<mpd_ssize_t N>
+ALWAYS_INLINE const mpd_t* operand(const leaf<N>& e, mpd_t*, eval_state&, bool&) {
+    return e.value.getconst();
+}
+
+template<op Op, typename L, typename R>
+ALWAYS_INLINE const mpd_t* operand(const node<Op, L, R>& e, mpd_t* scratch, eval_state& st, bool& inexact) {
+    inexact |= eval_node(scratch, e, st, Op == op::div ? &st.work : &st.exact);
+    return scratch;
+}
+
+/* top: exponent of leading digit of larger operand. Zero is treated as loss of all digits of rounded operand */
+ALWAYS_INLINE void track_loss(const mpd_t* result, mpd_ssize_t top, eval_state& st) {
+    if (!mpd_isfinite(result)) {
+        return;
+    }
+    st.lost = std::max(st.lost, mpd_iszerocoeff(result) ? st.work.prec : top - mpd_adjexp(result));
+}
+
+template<typename T>
+struct is_mul : std::false_type {};
+template<typename L, typename R>
+struct is_mul<node<op::mul, L, R>> : std::true_type {};
+
+/* a * b + c and c + a * b as fma: product is not rounded */
+template<typename M, typename C>
+ALWAYS_INLINE bool eval_fma(mpd_t* result, const M& m, const C& c, eval_state& st, const mpd_context_t* ctx) {
+    basic_bigdecimal<M::words> tmp_b, tmp_c;
+    bool inexact = false;
+    const mpd_t* a = operand(m.left, result, st, inexact);
+    const mpd_t* b = operand(m.right, tmp_b.get(), st, inexact);
+    const mpd_t* addend = operand(c, tmp_c.get(), st, inexact);
+    const mpd_ssize_t top = std::max(mpd_adjexp(a) + mpd_adjexp(b) + 1, mpd_adjexp(addend));
+    uint32_t status = 0;
+    mpd_qfma(result, a, b, addend, ctx, &status);
+    st.status |= status;
+    if (inexact) {
+        track_loss(result, top, st);
+    }
+    return inexact || (status & MPD_Inexact);
+}
+
+/* returns true if result is rounded or computed from rounded operands */
+template<op Op, typename L, typename R>
+bool eval_node(mpd_t* result, const node<Op, L, R>& e, eval_state& st, const mpd_context_t* ctx) {
+    if constexpr (Op == op::add && is_mul<L>::value) {
+        return eval_fma(result, e.left, e.right, st, ctx);
+    } else if constexpr (Op == op::add && is_mul<R>::value) {
+        return eval_fma(result, e.right, e.left, st, ctx);
+    } else {
+        basic_bigdecimal<node<Op, L, R>::words> tmp;
+        bool inexact = false;
+        const mpd_t* a = operand(e.left, result, st, inexact);
+        const mpd_t* b = operand(e.right, tmp.get(), st, inexact);
+        /* a can share result, its leading digit is taken before operation */
+        const bool cancels = inexact && (Op == op::add || Op == op::sub);
+        const mpd_ssize_t top = cancels ? std::max(mpd_adjexp(a), mpd_adjexp(b)) : 0;
+        uint32_t status = 0;
+        apply<Op>(result, a, b, ctx, &status);
+        st.status |= status;
+        if (cancels) {
+            track_loss(result, top, st);
+        }
+        return inexact || (status & MPD_Inexact);
+    }
+}
+
+template<mpd_ssize_t N>
+ALWAYS_INLINE bool eval_node(mpd_t* result, const leaf<N>& e, eval_state& st, const mpd_context_t* ctx) {
+    mpd_qplus(result, e.value.getconst(), ctx, &st.status);
+    return false;
+}
+
+} // namespace expr
+
+/// \brief Starts lazy expression: lazy(a) * b / c + d is computed only by eval()
+/// Expression keeps references to operands, so it must not outlive them.
+template<mpd_ssize_t N>
+ALWAYS_INLINE expr::leaf<N> lazy(const basic_bigdecimal<N>& v) {
+    return expr::leaf<N>{v};
+}
+
+/// \brief Computes lazy expression into a single result with context c. Result is correctly rounded, or
+/// differs by one unit in the last place if exact value is very close to rounding boundary
+template<typename E, typename = typename std::enable_if<expr::is_expr<E>::value>::type>
+basic_bigdecimal<E::words> eval(const E& e, bd_context& c) {
+    basic_bigdecimal<E::words> result;
+    const mpd_context_t* ctx = c.getconst();
+    mpd_ssize_t guard = expr::GUARD_DIGITS;
+    for (int pass = 1;; pass++) {
+        expr::eval_state st(*ctx, guard);
+        expr::eval_node(result.get(), e, st, ctx);
+        /* cancellation consumed guard digits: compute again with more of them */
+        const mpd_ssize_t need = st.lost + expr::GUARD_DIGITS;
+        if (need <= guard || pass == expr::MAX_PASSES || ctx->prec + guard >= MPD_MAX_PREC) {
+            c.raise(st.status);
+            return result;
+        }
+        guard = need;
+    }
+}
+
+/// \brief Computes lazy expression with precision of arithmetic operators: max(digits) of all operands
+/// for precision_policy::operand_digits, thread context for precision_policy::fixed
+template<typename E, typename = typename std::enable_if<expr::is_expr<E>::value>::type>
+basic_bigdecimal<E::words> eval(const E& e) {
+    if (context.policy() == precision_policy::fixed) {
+        return eval(e, context);
+    }
+    mpd_context_t ctx = OPERAND_CONTEXT;
+    ctx.prec = std::min<mpd_ssize_t>(std::max<mpd_ssize_t>(expr::max_digits(e), 1), MPD_MAX_PREC);
+    bd_context c(ctx);
+    return eval(e, c);
+}
+
+} // namespace bigmath
+
+#endif //BIGMATHPP_DECIMAL_EXPR_H
@@ -187,6 +187,10 @@ public:
     }
 };
 
+class arena_escape_error : public runtime_error {
+    using runtime_error::runtime_error;
+};
+
 class malloc_error : public std::exception {
 private:
     std::string m_msg;
@@ -0,0 +1,322 @@
+/*!
+ * bigmath.
+ * fixed_decimal.h
+ *
+ * \date 10/17/2026
+ * \author Eduard Maximovich (edward.vstock@gmail.com)
+ * \link   https://github.com/edwardstock
+ */
+#ifndef BIGMATHPP_FIXED_DECIMAL_H
+#define BIGMATHPP_FIXED_DECIMAL_H
+
+#include "bigdecimal.h"
+#include "bigint.h"
+#include "bigmath_config.h"
+#include "errors.h"
+
+#include <charconv>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#ifdef HAVE_UINT128_T
+
+namespace bigmath {
+
+/* __extension__ keeps -Wpedantic quiet about compiler-provided 128-bit integers */
+__extension__ typedef __int128 int128_t;
+__extension__ typedef unsigned __int128 uint128_t;
+
+namespace detail {
+
+constexpr int128_t pow10_i128(int n) {
+    int128_t r = 1;
+    for (int i = 0; i < n; i++) {
+        r *= 10;
+    }
+    return r;
+}
+
+/* round(a * b / c) with mpdecimal rounding mode, false if result is out of 128-bit signed range */
+BIGMATHPP_API bool fixed_muldiv(int128_t a, int128_t b, int128_t c, int round, int128_t& result);
+/* same rounded result as exact decimal value * 10^-scale, for any magnitude */
+BIGMATHPP_API void fixed_muldiv_decimal(mpd_t* result, int128_t a, int128_t b, int128_t c, int round, int scale);
+
+BIGMATHPP_API int128_t fixed_parse(std::string_view s, int scale);
+BIGMATHPP_API int128_t fixed_from_decimal(const mpd_t* a, int scale);
+BIGMATHPP_API void fixed_to_decimal(mpd_t* result, int128_t raw, int scale);
+BIGMATHPP_API std::to_chars_result fixed_to_chars(char* first, char* last, int128_t raw, int scale);
+
+} // namespace detail
+
+/// \brief Decimal with exactly Scale digits after point, stored inline as 128-bit integer value * 10^Scale.
+/// Range is about ±1.7e38 / 10^Scale (±1.7e20 for Scale 18). Add and sub are exact, mul and div round
+/// to Scale digits with rounding mode of context. Operators throw overflow_error if result is out of range,
+/// try_* functions report it without exceptions and promote_* ones compute result as bigdecimal instead.
+template<int Scale>
+class fixed_decimal {
+    static_assert(Scale >= 0 && Scale <= 38, "fixed_decimal scale must be in range [0, 38]");
+
+public:
+    using raw_type = int128_t;
+
+    /// \brief raw value of 1
+    static constexpr raw_type ONE = detail::pow10_i128(Scale);
+    /// \brief longest str() output: sign, 39 digits, leading zero and point
+    static constexpr size_t MAX_CHARS = 42;
+
+private:
+    raw_type m_raw = 0;
+
+    static ALWAYS_INLINE raw_type checked_scale(raw_type v) {
+        raw_type raw;
+        if (__builtin_mul_overflow(v, ONE, &raw)) {
+            throw overflow_error("fixed_decimal: value is out of range");
+        }
+        return raw;
+    }
+
+    static ALWAYS_INLINE fixed_decimal checked(bool ok, const fixed_decimal& result) {
+        if (!ok) {
+            throw overflow_error("fixed_decimal: result is out of range");
+        }
+        return result;
+    }
+
+    static ALWAYS_INLINE void check_divisor(const fixed_decimal& other) {
+        if (other.m_raw == 0) {
+            throw division_by_zero("fixed_decimal: division by zero");
+        }
+    }
+
+public:
+    constexpr fixed_decimal() = default;
+
+    template<typename T, typename = typename std::enable_if<std::is_integral<T>::value>::type>
+    explicit fixed_decimal(T v)
+        : m_raw(checked_scale(raw_type(v))) {
+    }
+
+    /// \brief Parses [sign] digits [. digits] exactly, string doesn't have to be null-terminated
+    /// \throws conversion_syntax_error for invalid string, inexact_error if it has non-zero digits after Scale ones
+    /// \throws overflow_error if value is out of range
+    explicit fixed_decimal(std::string_view s)
+        : m_raw(detail::fixed_parse(s, Scale)) {
+    }
+
+    explicit fixed_decimal(const char* s)
+        : fixed_decimal(std::string_view(s)) {
+    }
+
+    explicit fixed_decimal(const std::string& s)
+        : fixed_decimal(std::string_view(s)) {
+    }
+
+    /// \brief Exact conversion
+    /// \throws value_error for NaN and Infinity, inexact_error if value has non-zero digits after Scale ones
+    /// \throws overflow_error if value is out of range
+    template<mpd_ssize_t N>
+    explicit fixed_decimal(const basic_bigdecimal<N>& d)
+        : m_raw(detail::fixed_from_decimal(d.getconst(), Scale)) {
+    }
+
+    /// \brief Exact conversion
+    /// \throws overflow_error if value is out of range
+    explicit fixed_decimal(const bigint& v)
+        : fixed_decimal(bigdecimal(v)) {
+    }
+
+    /// \brief Value from raw integer: raw * 10^-Scale
+    static constexpr fixed_decimal from_raw(raw_type raw) {
+        fixed_decimal result;
+        result.m_raw = raw;
+        return result;
+    }
+
+    constexpr raw_type raw() const {
+        return m_raw;
+    }
+
+    /// \brief Exact conversion, result has exponent -Scale
+    bigdecimal to_bigdecimal() const {
+        bigdecimal result;
+        detail::fixed_to_decimal(result.get(), m_raw, Scale);
+        return result;
+    }
+
+    /// \brief Rounds value to integer using context rounding, same as bigdecimal::to_bigint()
+    bigint to_bigint(bd_context& c = context) const {
+        return to_bigdecimal().to_bigint(c);
+    }
+
+    /// \brief Writes value with all Scale digits after point, no null terminator is written
+    std::to_chars_result to_chars(char* first, char* last) const {
+        return detail::fixed_to_chars(first, last, m_raw, Scale);
+    }
+
+    std::string str() const {
+        char buf[MAX_CHARS];
+        const std::to_chars_result res = to_chars(buf, buf + sizeof(buf));
+        return std::string(buf, res.ptr);
+    }
+
+    friend std::ostream& operator<<(std::ostream& os, const fixed_decimal& self) {
+        char buf[MAX_CHARS];
+        const std::to_chars_result res = self.to_chars(buf, buf + sizeof(buf));
+        os.write(buf, res.ptr - buf);
+        return os;
+    }
+
+    constexpr int sign() const {
+        return m_raw < 0 ? -1 : 1;
+    }
+
+    constexpr bool iszero() const {
+        return m_raw == 0;
+    }
+
+    /***********************************************************************/
+    /*                     Arithmetic without exceptions                   */
+    /***********************************************************************/
+    /// \return false if result is out of range, result is unchanged then
+    ALWAYS_INLINE bool try_add(const fixed_decimal& other, fixed_decimal& result) const noexcept {
+        raw_type r;
+        if (__builtin_add_overflow(m_raw, other.m_raw, &r)) {
+            return false;
+        }
+        result.m_raw = r;
+        return true;
+    }
+
+    ALWAYS_INLINE bool try_sub(const fixed_decimal& other, fixed_decimal& result) const noexcept {
+        raw_type r;
+        if (__builtin_sub_overflow(m_raw, other.m_raw, &r)) {
+            return false;
+        }
+        result.m_raw = r;
+        return true;
+    }
+
+    /// \brief Product rounded to Scale digits with rounding mode bigmath::ROUND_*
+    ALWAYS_INLINE bool try_mul(const fixed_decimal& other, fixed_decimal& result, int round = context.round()) const {
+        return detail::fixed_muldiv(m_raw, other.m_raw, ONE, round, result.m_raw);
+    }
+
+    /// \brief Quotient rounded to Scale digits with rounding mode bigmath::ROUND_*
+    /// \throws division_by_zero
+    ALWAYS_INLINE bool try_div(const fixed_decimal& other, fixed_decimal& result, int round = context.round()) const {
+        check_divisor(other);
+        return detail::fixed_muldiv(m_raw, ONE, other.m_raw, round, result.m_raw);
+    }
+
+    /***********************************************************************/
+    /*                   Arithmetic with bigdecimal result                 */
+    /***********************************************************************/
+    /// \brief Same result as operator+, as bigdecimal with exponent -Scale, without range limit
+    bigdecimal promote_add(const fixed_decimal& other) const {
+        fixed_decimal r;
+        if (try_add(other, r)) {
+            return r.to_bigdecimal();
+        }
+        bd_context c = exact_context();
+        return to_bigdecimal().add(other.to_bigdecimal(), c);
+    }
+
+    bigdecimal promote_sub(const fixed_decimal& other) const {
+        fixed_decimal r;
+        if (try_sub(other, r)) {
+            return r.to_bigdecimal();
+        }
+        bd_context c = exact_context();
+        return to_bigdecimal().sub(other.to_bigdecimal(), c);
+    }
+
+    bigdecimal promote_mul(const fixed_decimal& other, int round = context.round()) const {
+        bigdecimal result;
+        detail::fixed_muldiv_decimal(result.get(), m_raw, other.m_raw, ONE, round, Scale);
+        return result;
+    }
+
+    bigdecimal promote_div(const fixed_decimal& other, int round = context.round()) const {
+        check_divisor(other);
+        bigdecimal result;
+        detail::fixed_muldiv_decimal(result.get(), m_raw, ONE, other.m_raw, round, Scale);
+        return result;
+    }
+
+    /***********************************************************************/
+    /*                        Arithmetic operators                         */
+    /***********************************************************************/
+    ALWAYS_INLINE fixed_decimal operator+(const fixed_decimal& other) const {
+        fixed_decimal r;
+        return checked(try_add(other, r), r);
+    }
+    ALWAYS_INLINE fixed_decimal operator-(const fixed_decimal& other) const {
+        fixed_decimal r;
+        return checked(try_sub(other, r), r);
+    }
+    ALWAYS_INLINE fixed_decimal operator*(const fixed_decimal& other) const {
+        fixed_decimal r;
+        return checked(try_mul(other, r), r);
+    }
+    ALWAYS_INLINE fixed_decimal operator/(const fixed_decimal& other) const {
+        fixed_decimal r;
+        return checked(try_div(other, r), r);
+    }
+    ALWAYS_INLINE fixed_decimal operator-() const {
+        return fixed_decimal() - *this;
+    }
+    ALWAYS_INLINE fixed_decimal abs() const {
+        return m_raw < 0 ? -*this : *this;
+    }
+
+    ALWAYS_INLINE fixed_decimal& operator+=(const fixed_decimal& other) {
+        return *this = *this + other;
+    }
+    ALWAYS_INLINE fixed_decimal& operator-=(const fixed_decimal& other) {
+        return *this = *this - other;
+    }
+    ALWAYS_INLINE fixed_decimal& operator*=(const fixed_decimal& other) {
+        return *this = *this * other;
+    }
+    ALWAYS_INLINE fixed_decimal& operator/=(const fixed_decimal& other) {
+        return *this = *this / other;
+    }
+
+    /***********************************************************************/
+    /*                         Comparison operators                        */
+    /***********************************************************************/
+    constexpr bool operator==(const fixed_decimal& other) const {
+        return m_raw == other.m_raw;
+    }
+    constexpr bool operator!=(const fixed_decimal& other) const {
+        return m_raw != other.m_raw;
+    }
+    constexpr bool operator<(const fixed_decimal& other) const {
+        return m_raw < other.m_raw;
+    }
+    constexpr bool operator<=(const fixed_decimal& other) const {
+        return m_raw <= other.m_raw;
+    }
+    constexpr bool operator>(const fixed_decimal& other) const {
+        return m_raw > other.m_raw;
+    }
+    constexpr bool operator>=(const fixed_decimal& other) const {
+        return m_raw >= other.m_raw;
+    }
+
+private:
+    /* sum of two fixed values is exact with 40 digits */
+    static bd_context exact_context() {
+        mpd_context_t ctx = OPERAND_CONTEXT;
+        ctx.prec = 2 * MPD_RDIGITS + 2;
+        return bd_context(ctx);
+    }
+};
+
+} // namespace bigmath
+
+#endif // HAVE_UINT128_T
+
+#endif //BIGMATHPP_FIXED_DECIMAL_H
@@ -0,0 +1,158 @@
+/*!
+ * bigmath.
+ * parallel.h
+ *
+ * \date 10/17/2026
+ * \author Eduard Maximovich (edward.vstock@gmail.com)
+ * \link   https://github.com/edwardstock
+ */
+#ifndef BIGMATHPP_PARALLEL_H
+#define BIGMATHPP_PARALLEL_H
+
+#include "bd_context.h"
+#include "bigmath_config.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace bigmath {
+
+/// \brief Work-stealing thread pool for parallel::reduce and parallel::transform.
+/// Every worker has own task queue and steals from others when it's empty. Thread that calls run()
+/// executes tasks too until its batch is done, so run() can be called from inside of a task.
+class BIGMATHPP_API thread_pool {
+public:
+    /// \param threads count of worker threads, 0 is std::thread::hardware_concurrency() - 1
+    explicit thread_pool(size_t threads = 0);
+    thread_pool(const thread_pool& other) = delete;
+    thread_pool& operator=(const thread_pool& other) = delete;
+    ~thread_pool();
+
+    /// \brief Returns count of worker threads
+    size_t size() const;
+
+    /// \brief Calls task(i) for every i in [0, count) and waits for all of them.
+    /// \throws exception of the task with lowest index, after all tasks are finished
+    void run(size_t count, const std::function<void(size_t)>& task);
+
+    /// \brief Process-wide pool, created on first use
+    static thread_pool& shared();
+
+private:
+    struct state;
+    state* m_state;
+};
+
+/* Parallel algorithms over random access ranges. Range is split into chunks of grain elements, boundaries depend
+ * only on range size and grain, not on count of threads, and partial results are combined in order of chunks,
+ * so result is the same on every run. Each chunk runs with a copy of the calling thread's bigmath::context,
+ * status flags of all chunks are merged into calling thread's context after all chunks are finished. */
+namespace parallel {
+
+constexpr size_t DEFAULT_GRAIN = 4096;
+
+namespace detail {
+
+/* runs f(chunk, begin, end) for every chunk with a copy of caller's context, status is merged in caller's context */
+template<typename F>
+void for_chunks(size_t size, size_t grain, thread_pool& pool, F&& f) {
+    const size_t chunks = (size + grain - 1) / grain;
+    const bd_context base = context;
+    std::vector<uint32_t> status(chunks, 0);
+    pool.run(chunks, [&](size_t chunk) {
+        const bd_context saved = context;
+        context = base;
+        context.clear_status();
+        try {
+            f(chunk, chunk * grain, std::min(size, (chunk + 1) * grain));
+        } catch (...) {
+            status[chunk] = context.status();
+            context = saved;
+            throw;
+        }
+        status[chunk] = context.status();
+        context = saved;
+    });
+    uint32_t merged = 0;
+    for (uint32_t s : status) {
+        merged |= s;
+    }
+    context.add_status(merged);
+}
+
+/* op(acc, x) that updates acc in place, like [](bigint& acc, const bigint& x) { acc += x; } */
+template<typename Op, typename T, typename V, typename = void>
+struct is_inplace_op : std::false_type {};
+template<typename Op, typename T, typename V>
+struct is_inplace_op<Op, T, V, typename std::enable_if<std::is_void<decltype(std::declval<Op&>()(std::declval<T&>(), std::declval<const V&>()))>::value>::type>
+    : std::true_type {};
+
+template<typename T, typename Op, typename V>
+ALWAYS_INLINE void fold(T& acc, Op& op, const V& v) {
+    if constexpr (is_inplace_op<Op, T, V>::value) {
+        op(acc, v);
+    } else {
+        acc = op(std::move(acc), v);
+    }
+}
+
+} // namespace detail
+
+/// \brief Reduces [first, last) with op: op(op(op(init, x0), x1), ...), chunks are reduced in parallel.
+/// op must be associative, partial results are combined in order of chunks.
+/// op can return new accumulator: T op(T acc, const V& x), or update it in place: void op(T& acc, const V& x),
+/// the latter doesn't move accumulator on every element.
+/// \throws exception thrown by op (including traps of the context) for the chunk with lowest index
+template<typename It, typename T, typename Op>
+T reduce(It first, It last, T init, Op op, thread_pool& pool = thread_pool::shared(), size_t grain = DEFAULT_GRAIN) {
+    const size_t size = static_cast<size_t>(std::distance(first, last));
+    if (size == 0) {
+        return init;
+    }
+    if (grain == 0) {
+        grain = 1;
+    }
+    std::vector<T> partial((size + grain - 1) / grain);
+    detail::for_chunks(size, grain, pool, [&](size_t chunk, size_t begin, size_t end) {
+        T acc = *(first + begin);
+        for (size_t i = begin + 1; i < end; i++) {
+            detail::fold(acc, op, *(first + i));
+        }
+        partial[chunk] = std::move(acc);
+    });
+    for (T& p : partial) {
+        detail::fold(init, op, p);
+    }
+    return init;
+}
+
+/// \brief Writes f(x) of every x in [first, last) to out, elements are computed in parallel.
+/// out must be random access iterator to range of at least std::distance(first, last) elements.
+/// \throws exception thrown by f (including traps of the context) for the chunk with lowest index
+template<typename It, typename Out, typename F>
+Out transform(It first, It last, Out out, F f, thread_pool& pool = thread_pool::shared(), size_t grain = DEFAULT_GRAIN) {
+    const size_t size = static_cast<size_t>(std::distance(first, last));
+    if (size == 0) {
+        return out;
+    }
+    if (grain == 0) {
+        grain = 1;
+    }
+    detail::for_chunks(size, grain, pool, [&](size_t, size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            *(out + i) = f(*(first + i));
+        }
+    });
+    return out + size;
+}
+
+} // namespace parallel
+} // namespace bigmath
+
+#endif //BIGMATHPP_PARALLEL_H
@@ -0,0 +1,83 @@
+/*!
+ * bigmath.
+ * static_context.h
+ *
+ * \date 10/17/2026
+ * \author Eduard Maximovich (edward.vstock@gmail.com)
+ * \link   https://github.com/edwardstock
+ */
+#ifndef BIGMATHPP_STATIC_CONTEXT_H
+#define BIGMATHPP_STATIC_CONTEXT_H
+
+#include "bd_context.h"
+#include "mpdecimal_backport.h"
+#include "utils.h"
+
+#include <cstdint>
+#include <type_traits>
+
+namespace bigmath {
+
+/// \brief Context with fields known at compile time. Fields are validated by static_assert instead of
+/// bd_context setters, and operations get pointer to constexpr mpd_context_t, so nothing is built per call.
+///
+/// Status is not stored: trapped flags throw as with bd_context, other flags are dropped.
+/// Use bigmath::checked functions with to_context() if status is needed.
+/// \code
+/// using ctx38 = bigmath::static_context<38>;
+/// bigmath::bigdecimal r = a.div(b, ctx38{});
+/// \endcode
+template<mpd_ssize_t Prec,
+         int Round = MPD_ROUND_HALF_EVEN,
+         mpd_ssize_t Emax = 999999,
+         mpd_ssize_t Emin = -999999,
+         uint32_t Traps = MPD_IEEE_Invalid_operation | MPD_Division_by_zero | MPD_Overflow>
+struct static_context {
+    static_assert(Prec >= 1 && Prec <= MPD_MAX_PREC, "valid range for prec is [1, MAX_PREC]");
+    static_assert(Round >= 0 && Round < MPD_ROUND_GUARD, "invalid rounding mode");
+    static_assert(Emax >= 0 && Emax <= MPD_MAX_EMAX, "valid range for emax is [0, MAX_EMAX]");
+    static_assert(Emin <= 0 && Emin >= MPD_MIN_EMIN, "valid range for emin is [MIN_EMIN, 0]");
+    static_assert(Traps <= MPD_Max_status, "invalid trap flags");
+
+    static constexpr mpd_context_t value{
+        Prec,  /* prec */
+        Emax,  /* emax */
+        Emin,  /* emin */
+        Traps, /* traps */
+        0,     /* status */
+        0,     /* newtrap */
+        Round, /* round */
+        0,     /* clamp */
+        1      /* allcr */
+    };
+
+    static constexpr const mpd_context_t* getconst() noexcept {
+        return &value;
+    }
+
+    /* raise an exception if a trap is active, flags are not stored */
+    static ALWAYS_INLINE void raise(uint32_t flags) {
+        if (flags & (Traps | MPD_Malloc_error)) {
+            bd_context(value).raise(flags);
+        }
+    }
+
+    /// \brief Runtime context with the same fields, for functions that take bd_context
+    static bd_context to_context() {
+        return bd_context(value);
+    }
+};
+
+template<typename T>
+struct is_static_context : std::false_type {};
+
+template<mpd_ssize_t Prec, int Round, mpd_ssize_t Emax, mpd_ssize_t Emin, uint32_t Traps>
+struct is_static_context<static_context<Prec, Round, Emax, Emin, Traps>> : std::true_type {};
+
+#define ENABLE_IF_STATIC_CONTEXT(T) \
+    template<typename T,            \
+             typename = typename std::enable_if<bigmath::is_static_context<T>::value>::type>
+
+} // namespace bigmath
+
+#endif //BIGMATHPP_STATIC_CONTEXT_H
@@ -0,0 +1,112 @@
+/*!
+ * bigmath.
+ * stats.h
+ *
+ * \date 10/17/2026
+ * \author Eduard Maximovich (edward.vstock@gmail.com)
+ * \link   https://github.com/edwardstock
+ */
+#ifndef BIGMATHPP_STATS_H
+#define BIGMATHPP_STATS_H
+
+#include "bigmath_config.h"
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace bigmath {
+
+/* Allocation and operation counters, collected only if library is built with ENABLE_STATS (BIGMATHPP_STATS).
+ * Every thread increments its own counters without locks, snapshot() sums counters of all threads.
+ * Without BIGMATHPP_STATS hooks are not compiled and snapshot() returns zeros. */
+namespace stats {
+
+#ifdef BIGMATHPP_STATS
+constexpr bool enabled = true;
+#else
+constexpr bool enabled = false;
+#endif
+
+/// \brief Calls of bigdecimal function, named after its mpdecimal function without "mpd_q" prefix
+struct op_count {
+    const char* name;
+    uint64_t calls;
+};
+
+struct counters {
+    /// mpdecimal heap calls: coefficients of bigdecimal and temporaries of mpdecimal functions
+    uint64_t decimal_allocs = 0;
+    uint64_t decimal_reallocs = 0;
+    uint64_t decimal_frees = 0;
+    /// bytes requested by allocs and reallocs
+    uint64_t decimal_bytes = 0;
+    /// bigdecimal coefficients moved from inline buffer to heap, counted when it happens: by bigdecimal functions,
+    /// parsing and copies. Temporaries inside of mpdecimal functions are not counted
+    uint64_t decimal_spills = 0;
+
+    /// GMP heap calls, made by bigint
+    uint64_t bigint_allocs = 0;
+    uint64_t bigint_reallocs = 0;
+    uint64_t bigint_frees = 0;
+    uint64_t bigint_bytes = 0;
+
+    /// status reports to contexts, see bd_context::raise()
+    uint64_t raises = 0;
+    /// exceptions thrown for trapped flags, including deferred_traps
+    uint64_t traps = 0;
+
+    /// per-function calls, sorted by name
+    std::vector<op_count> ops;
+
+    /// \brief Calls of function with given name, 0 if it was not called
+    uint64_t calls(const char* name) const {
+        for (const op_count& op : ops) {
+            if (std::strcmp(op.name, name) == 0) {
+                return op.calls;
+            }
+        }
+        return 0;
+    }
+};
+
+/// \brief Counters of all threads since start or last reset()
+BIGMATHPP_API counters snapshot();
+
+/// \brief Makes next snapshot() count from now. Counters of threads are not modified
+BIGMATHPP_API void reset();
+
+#ifdef BIGMATHPP_STATS
+namespace detail {
+using op_fn = void (*)();
+
+enum counter {
+    DECIMAL_ALLOCS,
+    DECIMAL_REALLOCS,
+    DECIMAL_FREES,
+    DECIMAL_BYTES,
+    DECIMAL_SPILLS,
+    BIGINT_ALLOCS,
+    BIGINT_REALLOCS,
+    BIGINT_FREES,
+    BIGINT_BYTES,
+    RAISES,
+    TRAPS,
+    COUNTERS_SIZE
+};
+
+BIGMATHPP_API void add(counter c, uint64_t n = 1) noexcept;
+BIGMATHPP_API void count_op(op_fn fn) noexcept;
+} // namespace detail
+
+#define BIGMATH_STATS_ADD(c) ::bigmath::stats::detail::add(::bigmath::stats::detail::c)
+#define BIGMATH_STATS_OP(fn) ::bigmath::stats::detail::count_op(reinterpret_cast<::bigmath::stats::detail::op_fn>(fn))
+#else
+#define BIGMATH_STATS_ADD(c) ((void) 0)
+#define BIGMATH_STATS_OP(fn) ((void) 0)
+#endif
+
+} // namespace stats
+} // namespace bigmath
+
+#endif //BIGMATHPP_STATS_H
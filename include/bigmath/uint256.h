@@ -0,0 +1,520 @@
+/*!
+ * bigmath.
+ * uint256.h
+ *
+ * \date 10/17/2026
+ * \author Eduard Maximovich (edward.vstock@gmail.com)
+ * \link   https://github.com/edwardstock
+ */
+#ifndef BIGMATHPP_UINT256_H
+#define BIGMATHPP_UINT256_H
+
+#include "bigint.h"
+#include "bigmath_config.h"
+#include "errors.h"
+
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#ifdef HAVE_UINT128_T
+
+namespace bigmath {
+
+namespace detail {
+
+/* double width multiplication, as _mpd_mul_words of typearith.h */
+ALWAYS_INLINE void mul_words(uint64_t* hi, uint64_t* lo, uint64_t a, uint64_t b) {
+    __extension__ typedef unsigned __int128 word_product_t;
+    const word_product_t hl = word_product_t(a) * b;
+    *hi = uint64_t(hl >> 64);
+    *lo = uint64_t(hl);
+}
+
+/* magnitudes of 4 limbs, least significant first: q = a / b, r = a % b, b is not zero */
+BIGMATHPP_API void int256_divmod(uint64_t* q, uint64_t* r, const uint64_t* a, const uint64_t* b);
+
+/* decimal or 0x-prefixed hex string, negative values are allowed if is_signed */
+BIGMATHPP_API void int256_parse(uint64_t* limbs, std::string_view s, bool is_signed);
+BIGMATHPP_API std::to_chars_result int256_to_chars(char* first, char* last, const uint64_t* limbs, bool is_signed);
+
+BIGMATHPP_API void int256_to_bigint(bigint& result, const uint64_t* limbs, bool is_signed);
+/* false if v is out of range */
+BIGMATHPP_API bool int256_from_bigint(uint64_t* limbs, const bigint& v, bool is_signed);
+
+} // namespace detail
+
+/// \brief 256-bit integer stored inline as 4 64-bit limbs, for EVM-style balances and hashes.
+/// Signed is two's complement int256, otherwise it's uint256. Arithmetic operators wrap modulo 2^256
+/// like builtin unsigned integers, try_* functions report overflow instead. Nothing uses heap: only division
+/// by value wider than 64 bits calls into GMP, as mpn_tdiv_qr on limbs of operands.
+template<bool Signed>
+class basic_int256 {
+public:
+    static constexpr size_t LIMBS = 4;
+    static constexpr size_t BYTES = 32;
+    /// \brief longest str() output: sign and 78 digits
+    static constexpr size_t MAX_CHARS = 79;
+
+private:
+    template<bool>
+    friend class basic_int256;
+
+    /* least significant first */
+    uint64_t m_limbs[LIMBS] = {0, 0, 0, 0};
+
+    /* r = a + b, returns carry */
+    static ALWAYS_INLINE uint64_t add_limbs(uint64_t* r, const uint64_t* a, const uint64_t* b) noexcept {
+        uint64_t carry = 0;
+        for (size_t i = 0; i < LIMBS; i++) {
+            const uint64_t s = a[i] + carry;
+            carry = s < carry;
+            r[i] = s + b[i];
+            carry += r[i] < s;
+        }
+        return carry;
+    }
+
+    /* r = a - b, returns borrow */
+    static ALWAYS_INLINE uint64_t sub_limbs(uint64_t* r, const uint64_t* a, const uint64_t* b) noexcept {
+        uint64_t borrow = 0;
+        for (size_t i = 0; i < LIMBS; i++) {
+            const uint64_t d = a[i] - b[i];
+            const uint64_t nb = a[i] < b[i];
+            r[i] = d - borrow;
+            borrow = nb | (d < borrow);
+        }
+        return borrow;
+    }
+
+    /* n least significant limbs of a * b, n is 4 (wrapping) or 8 (full product) */
+    static ALWAYS_INLINE void mul_limbs(uint64_t* r, const uint64_t* a, const uint64_t* b, size_t n) noexcept {
+        for (size_t i = 0; i < n; i++) {
+            r[i] = 0;
+        }
+        for (size_t i = 0; i < LIMBS; i++) {
+            if (a[i] == 0) {
+                continue;
+            }
+            uint64_t carry = 0;
+            for (size_t j = 0; j < LIMBS && i + j < n; j++) {
+                uint64_t hi, lo;
+                detail::mul_words(&hi, &lo, a[i], b[j]);
+                lo += carry;
+                hi += lo < carry;
+                r[i + j] += lo;
+                hi += r[i + j] < lo;
+                carry = hi;
+            }
+            if (i + LIMBS < n) {
+                r[i + LIMBS] = carry;
+            }
+        }
+    }
+
+    static ALWAYS_INLINE void negate_limbs(uint64_t* r, const uint64_t* a) noexcept {
+        const uint64_t zero[LIMBS] = {0, 0, 0, 0};
+        sub_limbs(r, zero, a);
+    }
+
+    /* absolute value, 2^255 for int256 minimum */
+    ALWAYS_INLINE basic_int256<false> magnitude() const noexcept {
+        basic_int256<false> r;
+        if (issigned()) {
+            negate_limbs(r.m_limbs, m_limbs);
+        } else {
+            r = basic_int256<false>(*this);
+        }
+        return r;
+    }
+
+    /* value with sign from magnitude, false if it's out of range */
+    static ALWAYS_INLINE bool from_magnitude(const basic_int256<false>& m, bool neg, basic_int256& result) noexcept {
+        basic_int256 r(m);
+        if (neg) {
+            negate_limbs(r.m_limbs, r.m_limbs);
+        }
+        const bool ok = Signed ? (m.iszero() || r.issigned() == neg) : (!neg || m.iszero());
+        if (ok) {
+            result = r;
+        }
+        return ok;
+    }
+
+    static ALWAYS_INLINE void check_divisor(const basic_int256& other) {
+        if (other.iszero()) {
+            throw division_by_zero("int256: division by zero");
+        }
+    }
+
+    /* q = a / b truncated, r = a - q * b with sign of a; q wraps for int256 minimum / -1 */
+    static void divmod(const basic_int256& a, const basic_int256& b, basic_int256* q, basic_int256* r) {
+        check_divisor(b);
+        const basic_int256<false> am = a.magnitude(), bm = b.magnitude();
+        basic_int256<false> qm, rm;
+        detail::int256_divmod(qm.m_limbs, rm.m_limbs, am.m_limbs, bm.m_limbs);
+        if (q) {
+            *q = basic_int256(qm);
+            if (a.issigned() != b.issigned()) {
+                negate_limbs(q->m_limbs, q->m_limbs);
+            }
+        }
+        if (r) {
+            *r = basic_int256(rm);
+            if (a.issigned()) {
+                negate_limbs(r->m_limbs, r->m_limbs);
+            }
+        }
+    }
+
+    static ALWAYS_INLINE void store_limb(uint8_t* p, uint64_t v, endian order) noexcept {
+        for (size_t i = 0; i < 8; i++) {
+            p[i] = uint8_t(order == endian::big ? v >> (56 - 8 * i) : v >> (8 * i));
+        }
+    }
+
+    static ALWAYS_INLINE uint64_t load_limb(const uint8_t* p, endian order) noexcept {
+        uint64_t v = 0;
+        for (size_t i = 0; i < 8; i++) {
+            v |= uint64_t(p[i]) << (order == endian::big ? 56 - 8 * i : 8 * i);
+        }
+        return v;
+    }
+
+public:
+    constexpr basic_int256() = default;
+
+    /// \brief Value of builtin integer, negative values are sign-extended (wrap for uint256 as builtin conversions do)
+    template<typename T, typename = typename std::enable_if<std::is_integral<T>::value>::type>
+    constexpr explicit basic_int256(T v)
+        : m_limbs{uint64_t(v), 0, 0, 0} {
+        if (std::is_signed<T>::value && v < 0) {
+            m_limbs[1] = m_limbs[2] = m_limbs[3] = ~uint64_t(0);
+        }
+    }
+
+    /// \brief Same bits as other, as static_cast between int64_t and uint64_t
+    template<bool S, typename = typename std::enable_if<S != Signed>::type>
+    constexpr explicit basic_int256(const basic_int256<S>& other)
+        : m_limbs{other.m_limbs[0], other.m_limbs[1], other.m_limbs[2], other.m_limbs[3]} {
+    }
+
+    /// \brief Parses decimal or 0x-prefixed hex integer, string doesn't have to be null-terminated
+    /// \throws conversion_syntax_error for invalid string, overflow_error if value is out of range
+    explicit basic_int256(std::string_view s) {
+        detail::int256_parse(m_limbs, s, Signed);
+    }
+
+    explicit basic_int256(const char* s)
+        : basic_int256(std::string_view(s)) {
+    }
+
+    explicit basic_int256(const std::string& s)
+        : basic_int256(std::string_view(s)) {
+    }
+
+    /// \brief Exact conversion, limbs are copied directly
+    /// \throws overflow_error if value is out of range
+    explicit basic_int256(const bigint& v) {
+        if (!detail::int256_from_bigint(m_limbs, v, Signed)) {
+            throw overflow_error("int256: value is out of range");
+        }
+    }
+
+    static constexpr basic_int256 min() {
+        basic_int256 r;
+        if (Signed) {
+            r.m_limbs[3] = uint64_t(1) << 63;
+        }
+        return r;
+    }
+
+    static constexpr basic_int256 max() {
+        basic_int256 r;
+        r.m_limbs[0] = r.m_limbs[1] = r.m_limbs[2] = ~uint64_t(0);
+        r.m_limbs[3] = Signed ? ~uint64_t(0) >> 1 : ~uint64_t(0);
+        return r;
+    }
+
+    /// \brief Limb i, least significant first, two's complement for negative int256
+    constexpr uint64_t limb(size_t i) const {
+        return m_limbs[i];
+    }
+
+    constexpr bool iszero() const {
+        return (m_limbs[0] | m_limbs[1] | m_limbs[2] | m_limbs[3]) == 0;
+    }
+
+    /// \brief true if value is negative, always false for uint256
+    constexpr bool issigned() const {
+        return Signed && (m_limbs[3] >> 63) != 0;
+    }
+
+    /// \brief -1, 0 or 1
+    constexpr int sign() const {
+        return issigned() ? -1 : (iszero() ? 0 : 1);
+    }
+
+    /***********************************************************************/
+    /*                             Conversions                             */
+    /***********************************************************************/
+    bigint to_bigint() const {
+        bigint result;
+        detail::int256_to_bigint(result, m_limbs, Signed);
+        return result;
+    }
+
+    /// \brief Writes decimal value, no null terminator is written
+    std::to_chars_result to_chars(char* first, char* last) const {
+        return detail::int256_to_chars(first, last, m_limbs, Signed);
+    }
+
+    std::string str() const {
+        char buf[MAX_CHARS];
+        const std::to_chars_result res = to_chars(buf, buf + sizeof(buf));
+        return std::string(buf, res.ptr);
+    }
+
+    friend std::ostream& operator<<(std::ostream& os, const basic_int256& self) {
+        char buf[MAX_CHARS];
+        const std::to_chars_result res = self.to_chars(buf, buf + sizeof(buf));
+        os.write(buf, res.ptr - buf);
+        return os;
+    }
+
+    /// \brief Writes BYTES bytes, two's complement for negative int256
+    ALWAYS_INLINE void export_to(uint8_t* out, endian order = endian::big) const noexcept {
+        for (size_t i = 0; i < LIMBS; i++) {
+            const size_t limb = order == endian::big ? LIMBS - 1 - i : i;
+            store_limb(out + 8 * i, m_limbs[limb], order);
+        }
+    }
+
+    /// \brief Reads BYTES bytes written by export_to()
+    ALWAYS_INLINE void import_from(const uint8_t* data, endian order = endian::big) noexcept {
+        for (size_t i = 0; i < LIMBS; i++) {
+            const size_t limb = order == endian::big ? LIMBS - 1 - i : i;
+            m_limbs[limb] = load_limb(data + 8 * i, order);
+        }
+    }
+
+    /***********************************************************************/
+    /*                     Arithmetic without exceptions                   */
+    /***********************************************************************/
+    /// \return false if result is out of range, result is unchanged then
+    ALWAYS_INLINE bool try_add(const basic_int256& other, basic_int256& result) const noexcept {
+        basic_int256 r;
+        const uint64_t carry = add_limbs(r.m_limbs, m_limbs, other.m_limbs);
+        const bool ok = Signed ? !(issigned() == other.issigned() && r.issigned() != issigned()) : carry == 0;
+        if (ok) {
+            result = r;
+        }
+        return ok;
+    }
+
+    ALWAYS_INLINE bool try_sub(const basic_int256& other, basic_int256& result) const noexcept {
+        basic_int256 r;
+        const uint64_t borrow = sub_limbs(r.m_limbs, m_limbs, other.m_limbs);
+        const bool ok = Signed ? !(issigned() != other.issigned() && r.issigned() != issigned()) : borrow == 0;
+        if (ok) {
+            result = r;
+        }
+        return ok;
+    }
+
+    ALWAYS_INLINE bool try_mul(const basic_int256& other, basic_int256& result) const noexcept {
+        const basic_int256<false> a = magnitude(), b = other.magnitude();
+        uint64_t full[2 * LIMBS];
+        mul_limbs(full, a.m_limbs, b.m_limbs, 2 * LIMBS);
+        if ((full[4] | full[5] | full[6] | full[7]) != 0) {
+            return false;
+        }
+        basic_int256<false> m;
+        for (size_t i = 0; i < LIMBS; i++) {
+            m.m_limbs[i] = full[i];
+        }
+        return from_magnitude(m, issigned() != other.issigned(), result);
+    }
+
+    /// \brief Truncating division, false only for int256 minimum / -1
+    /// \throws division_by_zero
+    bool try_div(const basic_int256& other, basic_int256& result) const {
+        if (Signed && *this == min() && other == basic_int256(-1)) {
+            return false;
+        }
+        divmod(*this, other, &result, nullptr);
+        return true;
+    }
+
+    /// \brief Quotient and remainder of truncating division in one pass
+    /// \throws division_by_zero
+    static void div_mod(const basic_int256& a, const basic_int256& b, basic_int256& q, basic_int256& r) {
+        divmod(a, b, &q, &r);
+    }
+
+    /***********************************************************************/
+    /*                  Arithmetic operators, modulo 2^256                 */
+    /***********************************************************************/
+    ALWAYS_INLINE basic_int256 operator+(const basic_int256& other) const noexcept {
+        basic_int256 r;
+        add_limbs(r.m_limbs, m_limbs, other.m_limbs);
+        return r;
+    }
+    ALWAYS_INLINE basic_int256 operator-(const basic_int256& other) const noexcept {
+        basic_int256 r;
+        sub_limbs(r.m_limbs, m_limbs, other.m_limbs);
+        return r;
+    }
+    ALWAYS_INLINE basic_int256 operator*(const basic_int256& other) const noexcept {
+        basic_int256 r;
+        mul_limbs(r.m_limbs, m_limbs, other.m_limbs, LIMBS);
+        return r;
+    }
+    /// \throws division_by_zero
+    basic_int256 operator/(const basic_int256& other) const {
+        basic_int256 q;
+        divmod(*this, other, &q, nullptr);
+        return q;
+    }
+    /// \throws division_by_zero
+    basic_int256 operator%(const basic_int256& other) const {
+        basic_int256 r;
+        divmod(*this, other, nullptr, &r);
+        return r;
+    }
+    ALWAYS_INLINE basic_int256 operator-() const noexcept {
+        basic_int256 r;
+        negate_limbs(r.m_limbs, m_limbs);
+        return r;
+    }
+
+    ALWAYS_INLINE basic_int256& operator+=(const basic_int256& other) noexcept {
+        add_limbs(m_limbs, m_limbs, other.m_limbs);
+        return *this;
+    }
+    ALWAYS_INLINE basic_int256& operator-=(const basic_int256& other) noexcept {
+        sub_limbs(m_limbs, m_limbs, other.m_limbs);
+        return *this;
+    }
+    ALWAYS_INLINE basic_int256& operator*=(const basic_int256& other) noexcept {
+        return *this = *this * other;
+    }
+    basic_int256& operator/=(const basic_int256& other) {
+        return *this = *this / other;
+    }
+    basic_int256& operator%=(const basic_int256& other) {
+        return *this = *this % other;
+    }
+
+    /***********************************************************************/
+    /*                          Bitwise operators                          */
+    /***********************************************************************/
+    ALWAYS_INLINE basic_int256 operator~() const noexcept {
+        basic_int256 r;
+        for (size_t i = 0; i < LIMBS; i++) {
+            r.m_limbs[i] = ~m_limbs[i];
+        }
+        return r;
+    }
+    ALWAYS_INLINE basic_int256 operator&(const basic_int256& other) const noexcept {
+        basic_int256 r;
+        for (size_t i = 0; i < LIMBS; i++) {
+            r.m_limbs[i] = m_limbs[i] & other.m_limbs[i];
+        }
+        return r;
+    }
+    ALWAYS_INLINE basic_int256 operator|(const basic_int256& other) const noexcept {
+        basic_int256 r;
+        for (size_t i = 0; i < LIMBS; i++) {
+            r.m_limbs[i] = m_limbs[i] | other.m_limbs[i];
+        }
+        return r;
+    }
+    ALWAYS_INLINE basic_int256 operator^(const basic_int256& other) const noexcept {
+        basic_int256 r;
+        for (size_t i = 0; i < LIMBS; i++) {
+            r.m_limbs[i] = m_limbs[i] ^ other.m_limbs[i];
+        }
+        return r;
+    }
+
+    /// \brief Shift left, bits shifted out are dropped, 0 if n >= 256
+    ALWAYS_INLINE basic_int256 operator<<(unsigned n) const noexcept {
+        basic_int256 r;
+        const size_t words = n / 64, bits = n % 64;
+        for (size_t i = LIMBS; i-- > words;) {
+            r.m_limbs[i] = m_limbs[i - words] << bits;
+            if (bits && i > words) {
+                r.m_limbs[i] |= m_limbs[i - words - 1] >> (64 - bits);
+            }
+        }
+        return r;
+    }
+
+    /// \brief Shift right, arithmetic for int256: negative values are filled with ones
+    ALWAYS_INLINE basic_int256 operator>>(unsigned n) const noexcept {
+        const uint64_t fill = issigned() ? ~uint64_t(0) : 0;
+        basic_int256 r;
+        for (size_t i = 0; i < LIMBS; i++) {
+            r.m_limbs[i] = fill;
+        }
+        const size_t words = n / 64, bits = n % 64;
+        for (size_t i = 0; i + words < LIMBS; i++) {
+            const uint64_t next = i + words + 1 < LIMBS ? m_limbs[i + words + 1] : fill;
+            r.m_limbs[i] = bits ? (m_limbs[i + words] >> bits) | (next << (64 - bits)) : m_limbs[i + words];
+        }
+        return r;
+    }
+
+    ALWAYS_INLINE basic_int256& operator<<=(unsigned n) noexcept {
+        return *this = *this << n;
+    }
+    ALWAYS_INLINE basic_int256& operator>>=(unsigned n) noexcept {
+        return *this = *this >> n;
+    }
+
+    /***********************************************************************/
+    /*                         Comparison operators                        */
+    /***********************************************************************/
+    constexpr bool operator==(const basic_int256& other) const {
+        return m_limbs[0] == other.m_limbs[0] && m_limbs[1] == other.m_limbs[1] &&
+               m_limbs[2] == other.m_limbs[2] && m_limbs[3] == other.m_limbs[3];
+    }
+    constexpr bool operator!=(const basic_int256& other) const {
+        return !(*this == other);
+    }
+    constexpr bool operator<(const basic_int256& other) const {
+        if (issigned() != other.issigned()) {
+            return issigned();
+        }
+        // same sign: two's complement values compare as unsigned
+        for (size_t i = LIMBS; i-- > 0;) {
+            if (m_limbs[i] != other.m_limbs[i]) {
+                return m_limbs[i] < other.m_limbs[i];
+            }
+        }
+        return false;
+    }
+    constexpr bool operator<=(const basic_int256& other) const {
+        return !(other < *this);
+    }
+    constexpr bool operator>(const basic_int256& other) const {
+        return other < *this;
+    }
+    constexpr bool operator>=(const basic_int256& other) const {
+        return !(*this < other);
+    }
+};
+
+using uint256 = basic_int256<false>;
+using int256 = basic_int256<true>;
+
+} // namespace bigmath
+
+#endif // HAVE_UINT128_T
+
+#endif //BIGMATHPP_UINT256_H
@@ -62,12 +62,7 @@ inline std::string string_from_cp(const char* cp) {
 }
 
 inline bool has_dec_point(const char* s) {
-    for (size_t i = 0; i < strlen(s); i++) {
-        if (*(s + i) == '.') {
-            return true;
-        }
-    }
-    return false;
+    return strchr(s, '.') != nullptr;
 }
 
 template<typename T>
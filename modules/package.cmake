@@ -14,6 +14,7 @@ elseif (HAVE_MPIR)
 	list(APPEND target_deps "find_dependency(MPIR REQUIRED)")
 endif ()
 list(APPEND target_deps "find_dependency(MPDECIMAL REQUIRED)")
+list(APPEND target_deps "find_dependency(Threads REQUIRED)")
 
 if (target_deps)
 	list(JOIN target_deps "\n" targets_deps_joined)
@@ -0,0 +1,577 @@
+/*!
+ * bigmath.
+ * allocator.cpp
+ *
+ * \date 10/17/2026
+ * \author Eduard Maximovich (edward.vstock@gmail.com)
+ * \link   https://github.com/edwardstock
+ */
+
+#include "bigmath/allocator.h"
+
+#include "bigmath/errors.h"
+#include "bigmath/stats.h"
+#include "mpdecimal.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <gmp.h>
+#include <string>
+
+/*****************************************************************************/
+/*                              Installed functions                           */
+/*****************************************************************************/
+
+static bigmath::allocator current{std::malloc, std::realloc, std::free};
+
+static void* calloc_func(size_t nmemb, size_t size) {
+    if (size != 0 && nmemb > SIZE_MAX / size) {
+        return nullptr;
+    }
+    void* p = current.alloc(nmemb * size);
+    if (p != nullptr) {
+        std::memset(p, 0, nmemb * size);
+    }
+    return p;
+}
+
+/* GMP can't handle allocation failure, same as its default functions */
+static void* gmp_check(void* p) {
+    if (p == nullptr) {
+        std::fprintf(stderr, "GNU MP: Cannot allocate memory\n");
+        std::abort();
+    }
+    return p;
+}
+
+static void* gmp_alloc(size_t size) {
+    return gmp_check(current.alloc(size));
+}
+
+static void* gmp_realloc(void* ptr, size_t, size_t new_size) {
+    return gmp_check(current.realloc(ptr, new_size));
+}
+
+static void gmp_free(void* ptr, size_t) {
+    current.free(ptr);
+}
+
+#ifdef BIGMATHPP_STATS
+/* counting wrappers, installed instead of the functions themselves */
+using bigmath::stats::detail::add;
+namespace counter = bigmath::stats::detail;
+
+static void* mpd_alloc_counted(size_t size) {
+    add(counter::DECIMAL_ALLOCS);
+    add(counter::DECIMAL_BYTES, size);
+    return current.alloc(size);
+}
+
+static void* mpd_calloc_counted(size_t nmemb, size_t size) {
+    add(counter::DECIMAL_ALLOCS);
+    add(counter::DECIMAL_BYTES, nmemb * size);
+    return calloc_func(nmemb, size);
+}
+
+static void* mpd_realloc_counted(void* ptr, size_t size) {
+    add(counter::DECIMAL_REALLOCS);
+    add(counter::DECIMAL_BYTES, size);
+    return current.realloc(ptr, size);
+}
+
+static void mpd_free_counted(void* ptr) {
+    if (ptr != nullptr) {
+        add(counter::DECIMAL_FREES);
+    }
+    current.free(ptr);
+}
+
+static void* gmp_alloc_counted(size_t size) {
+    add(counter::BIGINT_ALLOCS);
+    add(counter::BIGINT_BYTES, size);
+    return gmp_alloc(size);
+}
+
+static void* gmp_realloc_counted(void* ptr, size_t old_size, size_t new_size) {
+    add(counter::BIGINT_REALLOCS);
+    add(counter::BIGINT_BYTES, new_size);
+    return gmp_realloc(ptr, old_size, new_size);
+}
+
+static void gmp_free_counted(void* ptr, size_t size) {
+    add(counter::BIGINT_FREES);
+    gmp_free(ptr, size);
+}
+#endif
+
+void bigmath::set_allocator(const allocator& a) {
+    if (a.alloc == nullptr || a.realloc == nullptr || a.free == nullptr) {
+        throw value_error("allocator functions must be not null");
+    }
+    current = a;
+
+#ifdef BIGMATHPP_STATS
+    mpd_mallocfunc = mpd_alloc_counted;
+    mpd_reallocfunc = mpd_realloc_counted;
+    mpd_free = mpd_free_counted;
+    mpd_callocfunc = mpd_calloc_counted;
+    mp_set_memory_functions(gmp_alloc_counted, gmp_realloc_counted, gmp_free_counted);
+#else
+    mpd_mallocfunc = a.alloc;
+    mpd_reallocfunc = a.realloc;
+    mpd_free = a.free;
+    mpd_callocfunc = calloc_func;
+
+    if (a.alloc == std::malloc && a.realloc == std::realloc && a.free == std::free) {
+        // GMP defaults
+        mp_set_memory_functions(nullptr, nullptr, nullptr);
+    } else {
+        mp_set_memory_functions(gmp_alloc, gmp_realloc, gmp_free);
+    }
+#endif
+}
+
+bigmath::allocator bigmath::get_allocator() {
+    return current;
+}
+
+bigmath::allocator bigmath::system_allocator() {
+    return {std::malloc, std::realloc, std::free};
+}
+
+/*****************************************************************************/
+/*                                  Size-class pool                           */
+/*****************************************************************************/
+
+/* 16, 32, ..., 4096 bytes */
+static constexpr size_t MIN_CLASS_SHIFT = 4;
+static constexpr size_t NUM_CLASSES = 9;
+static constexpr uint32_t LARGE_CLASS = NUM_CLASSES;
+static constexpr uint32_t ARENA_CLASS = NUM_CLASSES + 1;
+/* cached blocks per class, at most 256KiB of cache per thread */
+static constexpr uint32_t MAX_CACHED = 32;
+
+/* stored before each block, keeps payload aligned as malloc does */
+struct alignas(alignof(std::max_align_t)) block_header {
+    uint32_t cls;
+    /* arena blocks only: id of owning arena and requested size */
+    uint32_t arena;
+    size_t size;
+};
+
+struct free_block {
+    free_block* next;
+};
+
+struct free_list {
+    free_block* head;
+    uint32_t count;
+};
+
+enum cache_state : uint8_t {
+    CACHE_INIT,
+    CACHE_ACTIVE,
+    /* thread is exiting, cached blocks are released */
+    CACHE_DEAD,
+};
+
+/* plain thread_local data doesn't need initialization guards on access */
+static thread_local free_list cache[NUM_CLASSES];
+static thread_local cache_state state = CACHE_INIT;
+static thread_local bigmath::pool_stats pool_counters;
+
+/* innermost arena_scope of the thread and whether allocations go to it */
+static thread_local bigmath::arena_scope* arena_top = nullptr;
+static thread_local bool arena_bypassed = false;
+static thread_local uint32_t arena_ids = 0;
+
+static void release_cache() {
+    for (free_list& list : cache) {
+        while (list.head != nullptr) {
+            free_block* b = list.head;
+            list.head = b->next;
+            std::free(reinterpret_cast<block_header*>(b) - 1);
+        }
+        list.count = 0;
+    }
+}
+
+struct cache_cleaner {
+    ~cache_cleaner() {
+        release_cache();
+        state = CACHE_DEAD;
+    }
+};
+
+static thread_local cache_cleaner cleaner;
+
+static inline size_t class_size(uint32_t cls) {
+    return size_t(1) << (cls + MIN_CLASS_SHIFT);
+}
+
+static inline uint32_t size_class(size_t size) {
+    uint32_t cls = 0;
+    while (cls < NUM_CLASSES && class_size(cls) < size) {
+        cls++;
+    }
+    return cls;
+}
+
+static inline void* payload(block_header* h) {
+    return h + 1;
+}
+
+static inline block_header* header(void* p) {
+    return static_cast<block_header*>(p) - 1;
+}
+
+static void* new_block(uint32_t cls, size_t size) {
+    pool_counters.misses++;
+    auto* h = static_cast<block_header*>(std::malloc(sizeof(block_header) + (cls == LARGE_CLASS ? size : class_size(cls))));
+    if (h == nullptr) {
+        return nullptr;
+    }
+    h->cls = cls;
+    return payload(h);
+}
+
+static void* cache_alloc(size_t size) {
+    const uint32_t cls = size_class(size);
+    if (cls != LARGE_CLASS) {
+        free_list& list = cache[cls];
+        if (list.head != nullptr) {
+            free_block* b = list.head;
+            list.head = b->next;
+            list.count--;
+            pool_counters.hits++;
+            return b;
+        }
+    }
+    return new_block(cls, size);
+}
+
+static void cache_free(block_header* h) {
+    if (h->cls != LARGE_CLASS && state != CACHE_DEAD) {
+        free_list& list = cache[h->cls];
+        if (list.count < MAX_CACHED) {
+            if (state == CACHE_INIT) {
+                // registers thread exit cleanup
+                (void) &cleaner;
+                state = CACHE_ACTIVE;
+            }
+            auto* b = reinterpret_cast<free_block*>(payload(h));
+            b->next = list.head;
+            list.head = b;
+            list.count++;
+            pool_counters.cached++;
+            return;
+        }
+    }
+    pool_counters.released++;
+    std::free(h);
+}
+
+/*****************************************************************************/
+/*                                  Arena                                     */
+/*****************************************************************************/
+
+/* chunk of arena memory, blocks follow the header */
+struct alignas(alignof(std::max_align_t)) chunk_header {
+    chunk_header* next;
+};
+
+static constexpr size_t BLOCK_ALIGN = alignof(std::max_align_t);
+
+static inline size_t block_span(size_t size) {
+    return sizeof(block_header) + (size + BLOCK_ALIGN - 1) / BLOCK_ALIGN * BLOCK_ALIGN;
+}
+
+static void free_chunks(chunk_header* c) {
+    while (c != nullptr) {
+        chunk_header* next = c->next;
+        std::free(c);
+        c = next;
+    }
+}
+
+/* memory of closed checked arena with escaped values, freed with the last escaped block */
+struct retained_arena {
+    retained_arena* next;
+    chunk_header* chunks;
+    size_t live;
+    uint32_t id;
+};
+
+static thread_local retained_arena* retained = nullptr;
+
+static void free_retained(const block_header* h) {
+    for (retained_arena** r = &retained; *r != nullptr; r = &(*r)->next) {
+        if ((*r)->id == h->arena) {
+            retained_arena* found = *r;
+            if (--found->live == 0) {
+                *r = found->next;
+                free_chunks(found->chunks);
+                std::free(found);
+            }
+            return;
+        }
+    }
+}
+
+namespace bigmath {
+
+struct arena_access {
+    static chunk_header* add_chunk(arena_scope& a, size_t size) {
+        auto* c = static_cast<chunk_header*>(std::malloc(sizeof(chunk_header) + size));
+        if (c == nullptr) {
+            return nullptr;
+        }
+        c->next = static_cast<chunk_header*>(a.m_chunks);
+        a.m_chunks = c;
+        return c;
+    }
+
+    static void* alloc(arena_scope& a, size_t size) {
+        const size_t span = block_span(size);
+        block_header* h;
+        if (span > a.m_chunk_size / 4) {
+            // dedicated chunk, current one is kept for small blocks
+            chunk_header* c = add_chunk(a, span);
+            if (c == nullptr) {
+                return nullptr;
+            }
+            h = reinterpret_cast<block_header*>(c + 1);
+        } else {
+            if (size_t(a.m_end - a.m_cur) < span) {
+                chunk_header* c = add_chunk(a, a.m_chunk_size);
+                if (c == nullptr) {
+                    return nullptr;
+                }
+                a.m_cur = reinterpret_cast<char*>(c + 1);
+                a.m_end = a.m_cur + a.m_chunk_size;
+            }
+            h = reinterpret_cast<block_header*>(a.m_cur);
+            a.m_cur += span;
+            a.m_last = h;
+        }
+
+        h->cls = ARENA_CLASS;
+        h->arena = a.m_id;
+        h->size = size;
+        a.m_live++;
+        a.m_bytes += size;
+        return payload(h);
+    }
+
+    /* arena of this thread that owns block, null if block escaped or belongs to another thread */
+    static arena_scope* owner(const block_header* h) {
+        for (arena_scope* a = arena_top; a != nullptr; a = a->m_prev) {
+            if (a->m_id == h->arena) {
+                return a;
+            }
+        }
+        return nullptr;
+    }
+
+    static void free(block_header* h) {
+        arena_scope* a = owner(h);
+        if (a == nullptr) {
+            free_retained(h);
+            return;
+        }
+        a->m_live--;
+        if (a->m_last == h) {
+            // last block of temporary value, reuse its memory
+            a->m_cur = reinterpret_cast<char*>(h);
+            a->m_last = nullptr;
+        }
+    }
+
+    static void* realloc(block_header* h, size_t size) {
+        arena_scope* a = owner(h);
+        if (size <= h->size) {
+            if (a != nullptr) {
+                a->m_bytes -= h->size - size;
+            }
+            h->size = size;
+            return payload(h);
+        }
+        if (a != nullptr && a->m_last == h && size_t(a->m_end - reinterpret_cast<char*>(h)) >= block_span(size)) {
+            // grow in place
+            a->m_cur = reinterpret_cast<char*>(h) + block_span(size);
+            a->m_bytes += size - h->size;
+            h->size = size;
+            return payload(h);
+        }
+        return nullptr;
+    }
+
+    static void retain(arena_scope& a) {
+        auto* r = static_cast<retained_arena*>(std::malloc(sizeof(retained_arena)));
+        if (r == nullptr) {
+            // chunks are leaked, escaped values stay valid anyway
+            return;
+        }
+        r->next = retained;
+        r->chunks = static_cast<chunk_header*>(a.m_chunks);
+        r->live = a.m_live;
+        r->id = a.m_id;
+        retained = r;
+    }
+
+    static void pop(arena_scope& a) {
+        if (arena_top != &a) {
+            throw value_error("arena_scope must be closed in reverse order of creation");
+        }
+        arena_top = a.m_prev;
+        a.m_closed = true;
+    }
+};
+
+} // namespace bigmath
+
+/*****************************************************************************/
+/*                              Pool functions                                */
+/*****************************************************************************/
+
+static void* pool_alloc(size_t size) {
+    if (arena_top != nullptr && !arena_bypassed) {
+        return bigmath::arena_access::alloc(*arena_top, size);
+    }
+    return cache_alloc(size);
+}
+
+static void pool_free(void* p) {
+    if (p == nullptr) {
+        return;
+    }
+    block_header* h = header(p);
+    if (h->cls == ARENA_CLASS) {
+        bigmath::arena_access::free(h);
+        return;
+    }
+    cache_free(h);
+}
+
+static void* pool_realloc(void* p, size_t size) {
+    if (p == nullptr) {
+        return pool_alloc(size);
+    }
+    block_header* h = header(p);
+    size_t old_size;
+    void* np;
+    if (h->cls == ARENA_CLASS) {
+        np = bigmath::arena_access::realloc(h, size);
+        if (np != nullptr) {
+            return np;
+        }
+        old_size = h->size;
+        np = pool_alloc(size);
+    } else {
+        if (h->cls == LARGE_CLASS) {
+            if (size_class(size) == LARGE_CLASS) {
+                auto* nh = static_cast<block_header*>(std::realloc(h, sizeof(block_header) + size));
+                return nh == nullptr ? nullptr : payload(nh);
+            }
+            // shrinking from large block, it's greater than any class
+            old_size = size;
+        } else if (size <= class_size(h->cls) && (h->cls == 0 || size > class_size(h->cls - 1))) {
+            // same class, shrinking to smaller class is done by copying to keep cache effective
+            return p;
+        } else {
+            old_size = class_size(h->cls);
+        }
+        // block allocated outside of arena stays outside
+        np = cache_alloc(size);
+    }
+
+    if (np == nullptr) {
+        return nullptr;
+    }
+    std::memcpy(np, p, old_size < size ? old_size : size);
+    pool_free(p);
+    return np;
+}
+
+bigmath::allocator bigmath::pool_allocator() {
+    return {pool_alloc, pool_realloc, pool_free};
+}
+
+bigmath::pool_stats bigmath::get_pool_stats() {
+    return pool_counters;
+}
+
+void bigmath::reset_pool_stats() {
+    pool_counters = pool_stats();
+}
+
+/*****************************************************************************/
+/*                              arena_scope API                               */
+/*****************************************************************************/
+
+bigmath::arena_scope::arena_scope(arena_mode mode, size_t chunk_size)
+    : m_chunk_size(chunk_size < 1024 ? 1024 : chunk_size),
+      m_id(++arena_ids),
+      m_mode(mode) {
+    if (current.alloc != pool_alloc) {
+        throw runtime_error("arena_scope requires pool_allocator() to be installed");
+    }
+    m_prev = arena_top;
+    arena_top = this;
+}
+
+bigmath::arena_scope::~arena_scope() {
+    if (m_closed) {
+        return;
+    }
+    if (arena_top == this) {
+        arena_top = m_prev;
+    }
+    m_closed = true;
+    if (!release()) {
+        std::fprintf(stderr, "bigmath: %zu values escaped arena_scope\n", m_live);
+        std::abort();
+    }
+}
+
+void bigmath::arena_scope::close() {
+    if (m_closed) {
+        return;
+    }
+    arena_access::pop(*this);
+    if (!release()) {
+        throw arena_escape_error(std::to_string(m_live) + " values escaped arena_scope");
+    }
+}
+
+/* frees arena memory, returns false if memory is kept until escaped values are freed in checked mode */
+bool bigmath::arena_scope::release() {
+    const bool escaped = m_mode == arena_mode::checked && m_live > 0;
+    if (escaped) {
+        arena_access::retain(*this);
+    } else {
+        free_chunks(static_cast<chunk_header*>(m_chunks));
+    }
+    m_chunks = nullptr;
+    m_cur = m_end = nullptr;
+    m_last = nullptr;
+    return !escaped;
+}
+
+size_t bigmath::arena_scope::live_blocks() const {
+    return m_live;
+}
+
+size_t bigmath::arena_scope::allocated_bytes() const {
+    return m_bytes;
+}
+
+bigmath::arena_bypass::arena_bypass()
+    : m_prev(arena_bypassed) {
+    arena_bypassed = true;
+}
+
+bigmath::arena_bypass::~arena_bypass() {
+    arena_bypassed = m_prev;
+}
@@ -11,6 +11,7 @@
 
 #include "bigmath/errors.h"
 
+#include <exception>
 #include <sstream>
 #include <string>
 
@@ -39,7 +40,7 @@ bigmath::bd_context bigmath::context_template{
     1                                                                 /* allcr */
 };
 
-thread_local bigmath::bd_context bigmath::context{*bigmath::context_template.getconst()};
+thread_local bigmath::bd_context bigmath::context{bigmath::context_template};
 
 /* Factory function for creating a context for maximum unrounded arithmetic.*/
 bigmath::bd_context bigmath::MaxContext() {
@@ -136,12 +137,9 @@ std::string flags(const uint32_t flags) {
     return s;
 }
 
-void bigmath::bd_context::raiseit(const uint32_t status) {
-    if (status & MPD_Malloc_error) {
-        throw malloc_error();
-    }
-
-    const std::string msg = flags(status);
+/* throws exception of first condition (or signal) in status */
+static void throw_status(const uint32_t status, const std::string& msg) {
+    BIGMATH_STATS_ADD(TRAPS);
     for (const cmap* c = cond_map; c->flag != UINT32_MAX; c++) {
         if (status & c->flag) {
             c->raise(msg);
@@ -154,7 +152,26 @@ void bigmath::bd_context::raiseit(const uint32_t status) {
         }
     }
 
-    throw runtime_error("internal_error: unknown status flag");
+    throw bigmath::runtime_error("internal_error: unknown status flag");
+}
+
+void bigmath::bd_context::raiseit(const uint32_t status) {
+    if (status & MPD_Malloc_error) {
+        BIGMATH_STATS_ADD(TRAPS);
+        throw malloc_error();
+    }
+
+    throw_status(status, flags(status));
+}
+
+void bigmath::bd_context::on_trap(const uint32_t active_traps) {
+    if (!m_deferring || (active_traps & MPD_Malloc_error)) {
+        raiseit(active_traps);
+    }
+    if (!m_pending) {
+        m_first_pending = m_ops;
+    }
+    m_pending |= active_traps;
 }
 
 bigmath::bd_context::bd_context(mpd_ssize_t prec, mpd_ssize_t emax, mpd_ssize_t emin, int round, uint32_t traps, int clamp, int allcr) {
@@ -179,11 +196,13 @@ bigmath::bd_context::bd_context(const bigmath::bd_context&& c) noexcept {
 
 bigmath::bd_context& bigmath::bd_context::operator=(const bigmath::bd_context& c) noexcept {
     ctx = *c.getconst();
+    m_policy = c.m_policy;
     return *this;
 }
 
 bigmath::bd_context& bigmath::bd_context::operator=(const bigmath::bd_context&& c) noexcept {
     ctx = *c.getconst();
+    m_policy = c.m_policy;
     return *this;
 }
 
@@ -196,7 +215,8 @@ bool bigmath::bd_context::operator==(const bigmath::bd_context& other) const noe
            ctx.round == other.ctx.round &&
            ctx.clamp == other.ctx.clamp &&
            ctx.allcr == other.ctx.allcr &&
-           ctx.newtrap == other.ctx.newtrap;
+           ctx.newtrap == other.ctx.newtrap &&
+           m_policy == other.m_policy;
 }
 
 bool bigmath::bd_context::operator!=(const bigmath::bd_context& other) const noexcept {
@@ -267,3 +287,88 @@ int64_t bigmath::bd_context::etiny() const {
 int64_t bigmath::bd_context::etop() const {
     return mpd_etop(&ctx);
 }
+bigmath::precision_policy bigmath::bd_context::policy() const {
+    return m_policy;
+}
+
+/*****************************************************************************/
+/*                              deferred_traps                               */
+/*****************************************************************************/
+static std::string deferred_message(const uint32_t status, const uint64_t index) {
+    return flags(status) + " at operation #" + std::to_string(index);
+}
+
+bigmath::deferred_traps::deferred_traps(bigmath::bd_context& c)
+    : m_ctx(c),
+      m_saved_deferring(c.m_deferring),
+      m_saved_pending(c.m_pending),
+      m_saved_first(c.m_first_pending),
+      m_base(c.m_ops),
+      m_uncaught(std::uncaught_exceptions()) {
+    m_ctx.m_deferring = true;
+    m_ctx.m_pending = 0;
+    m_ctx.m_first_pending = 0;
+}
+
+bigmath::deferred_traps::~deferred_traps() noexcept(false) {
+    if (!m_active) {
+        return;
+    }
+    if (std::uncaught_exceptions() > m_uncaught) {
+        /* pending flags were not reported, leave them to outer guard */
+        restore(true);
+        return;
+    }
+    const uint32_t status = pending();
+    const uint64_t index = first_index();
+    restore(false);
+    if (status) {
+        throw_status(status, deferred_message(status, index));
+    }
+}
+
+uint32_t bigmath::deferred_traps::pending() const noexcept {
+    return m_active ? m_ctx.m_pending : 0;
+}
+
+uint64_t bigmath::deferred_traps::first_index() const noexcept {
+    if (!pending()) {
+        return npos;
+    }
+    /* operation counter is incremented before trap is recorded */
+    return m_ctx.m_first_pending - m_base - 1;
+}
+
+uint64_t bigmath::deferred_traps::count() const noexcept {
+    return m_ctx.m_ops - m_base;
+}
+
+void bigmath::deferred_traps::check() {
+    const uint32_t status = pending();
+    if (!status) {
+        return;
+    }
+
+    const std::string msg = deferred_message(status, first_index());
+    m_ctx.m_pending = 0;
+    m_ctx.m_first_pending = 0;
+    throw_status(status, msg);
+}
+
+void bigmath::deferred_traps::dismiss() noexcept {
+    if (m_active) {
+        restore(false);
+    }
+}
+
+void bigmath::deferred_traps::restore(bool merge) noexcept {
+    if (merge && m_ctx.m_pending) {
+        m_ctx.m_first_pending = m_saved_pending ? m_saved_first : m_ctx.m_first_pending;
+        m_ctx.m_pending |= m_saved_pending;
+    } else {
+        m_ctx.m_pending = m_saved_pending;
+        m_ctx.m_first_pending = m_saved_first;
+    }
+    m_ctx.m_deferring = m_saved_deferring;
+    m_active = false;
+}
@@ -27,9 +27,12 @@
 
 #include "bigmath/bigdecimal.h"
 
+#include <algorithm>
 #include <cstdint>
+#include <cstring>
 #include <iostream>
 #include <sstream>
+#include <vector>
 
 namespace bigmath {
 
@@ -40,57 +43,502 @@ namespace bigmath {
 class LibraryInit {
 public:
     LibraryInit() {
-        mpd_setminalloc(bigmath::MINALLOC);
+        // any basic_bigdecimal inline coefficient must be at least MPD_MINALLOC words, otherwise it's moved to heap on resize
+        mpd_setminalloc(bigmath::MINALLOC_MIN);
     }
 };
 
 const LibraryInit init;
 
+/* mpd_qresize that counts coefficient moved from inline buffer to heap, see stats::counters */
+static ALWAYS_INLINE int resize(mpd_t* result, mpd_ssize_t nwords, uint32_t* status) {
+    const bool was_inline = mpd_isstatic_data(result);
+    const int ok = mpd_qresize(result, nwords, status);
+    if (was_inline && mpd_isdynamic_data(result)) {
+        BIGMATH_STATS_ADD(DECIMAL_SPILLS);
+    }
+    return ok;
+}
+
 /*****************************************************************************/
-/*                                Decimal API                                */
+/*                            bigint conversion                              */
 /*****************************************************************************/
 
-bigdecimal bigdecimal::exact(const char* const s, bd_context& c) {
-    bigdecimal result;
+/* Coefficient words (base MPD_RADIX) are converted to GMP limbs directly, without decimal string.
+ * Small values use schoolbook conversion with single-limb mpn operations and don't allocate.
+ * Large values go through raw digit array (values 0-9, not characters) and mpn_set_str/mpn_get_str,
+ * which are subquadratic in GMP, while packing digits to words is linear. */
+
+static_assert(sizeof(mpd_uint_t) <= sizeof(mp_limb_t), "coefficient word must fit into GMP limb");
+
+/* sizes from which GMP subquadratic conversion is faster than schoolbook one: multiplication
+ * by single limb in words -> limbs direction is much cheaper than division in opposite one */
+constexpr size_t WORDS_TO_LIMBS_THRESHOLD = 200;
+constexpr size_t LIMBS_TO_WORDS_THRESHOLD = 48;
+
+/* words {data, len} to limbs at rp, rp must have room for len limbs, returns number of limbs */
+static mp_size_t words_to_limbs_basecase(mp_ptr rp, const mpd_uint_t* data, size_t len) {
+    mp_size_t rn = 0;
+    for (size_t i = len; i-- > 0;) {
+        mp_limb_t carry = rn ? mpn_mul_1(rp, rp, rn, MPD_RADIX) : 0;
+        if (carry) {
+            rp[rn++] = carry;
+        }
+        if (rn == 0) {
+            if (data[i]) {
+                rp[rn++] = data[i];
+            }
+        } else {
+            carry = mpn_add_1(rp, rp, rn, data[i]);
+            if (carry) {
+                rp[rn++] = carry;
+            }
+        }
+    }
+    return rn;
+}
+
+/* limbs {up, un} to exactly len words at out (zero padded), destroys limbs, value must be < MPD_RADIX^len */
+static void limbs_to_words_basecase(mpd_uint_t* out, mp_ptr up, mp_size_t un, size_t len) {
+    size_t i = 0;
+    while (un > 0 && up[un - 1] == 0) {
+        un--;
+    }
+    while (un > 0) {
+        out[i++] = (mpd_uint_t) mpn_divrem_1(up, 0, up, un, MPD_RADIX);
+        if (up[un - 1] == 0) {
+            un--;
+        }
+    }
+    std::fill(out + i, out + len, 0);
+}
+
+/* coefficient words to decimal digits starting from zero char (0 for raw digits or '0'), most significant first,
+ * returns number of digits (digits of mpd_t) */
+template<typename CharT>
+static size_t words_to_digits(CharT* out, const mpd_t* a, CharT zero = 0) {
+    CharT* p = out + a->digits;
+    for (mpd_ssize_t i = 0; i < a->len; i++) {
+        mpd_uint_t w = a->data[i];
+        const size_t n = i + 1 < a->len ? MPD_RDIGITS : size_t(a->digits - i * MPD_RDIGITS);
+        for (size_t j = 0; j < n; j++) {
+            *--p = CharT(zero + w % 10);
+            w /= 10;
+        }
+    }
+    return (size_t) a->digits;
+}
+
+/* raw decimal digits {str, n}, most significant first, to words at out, returns number of words */
+static size_t digits_to_words(mpd_uint_t* out, const unsigned char* str, size_t n) {
+    size_t len = 0;
+    while (n > 0) {
+        const size_t take = n < MPD_RDIGITS ? n : MPD_RDIGITS;
+        mpd_uint_t w = 0;
+        for (const unsigned char* p = str + n - take; p != str + n; p++) {
+            w = w * 10 + *p;
+        }
+        out[len++] = w;
+        n -= take;
+    }
+    return len;
+}
+
+void detail::bigint_to_decimal(mpd_t* result, const bigint& s) {
     uint32_t status = 0;
+    mpz_srcptr z = s.m_val;
+    const size_t un = mpz_size(z);
 
-    if (s == nullptr) {
-        throw value_error("bigdecimal::exact: string argument is NULL");
+    // integer keeps one digit after point, like set_str("123") that parses "123.0": coefficient is z * 10
+    size_t len;
+    if (un < LIMBS_TO_WORDS_THRESHOLD) {
+        mp_limb_t scratch[LIMBS_TO_WORDS_THRESHOLD];
+        mp_size_t sn = (mp_size_t) un;
+        if (sn > 0) {
+            const mp_limb_t carry = mpn_mul_1(scratch, z->_mp_d, sn, 10);
+            if (carry) {
+                scratch[sn++] = carry;
+            }
+        }
+        len = bits2digits((size_t) sn * GMP_NUMB_BITS) / MPD_RDIGITS + 1;
+        if (!resize(result, (mpd_ssize_t) len, &status)) {
+            context.raise(status);
+        }
+        limbs_to_words_basecase(result->data, scratch, sn, len);
+    } else {
+        // value * 10 is the same digits with zero appended
+        std::vector<mp_limb_t> limbs(z->_mp_d, z->_mp_d + un);
+        // mpn_get_str wants room for largest number of un limbs plus one digit, and one more for appended zero
+        std::vector<unsigned char> digits(bits2digits(un * GMP_NUMB_BITS) + 3);
+        size_t n = mpn_get_str(digits.data(), 10, limbs.data(), (mp_size_t) un);
+        digits[n++] = 0;
+        // mpn_get_str may produce leading zeros
+        size_t skip = 0;
+        while (digits[skip] == 0) {
+            skip++;
+        }
+        len = (n - skip + MPD_RDIGITS - 1) / MPD_RDIGITS;
+        if (!resize(result, (mpd_ssize_t) len, &status)) {
+            context.raise(status);
+        }
+        len = digits_to_words(result->data, digits.data() + skip, n - skip);
+    }
+    while (len > 1 && result->data[len - 1] == 0) {
+        len--;
+    }
+    mpd_clear_flags(result);
+    mpd_set_sign(result, mpz_sgn(z) < 0 ? MPD_NEG : MPD_POS);
+    result->exp = -1;
+    result->len = (mpd_ssize_t) len;
+    mpd_setdigits(result);
+}
+
+bigint detail::decimal_to_bigint(const mpd_t* value, bd_context& c) {
+    if (mpd_isspecial(value)) {
+        throw value_error("bigdecimal: NaN or Infinity can't be converted to bigint");
     }
 
-    mpd_qset_string_exact(result.get(), s, &status);
+    bigdecimal integral;
+    uint32_t status = 0;
+    mpd_qround_to_int(integral.get(), value, c.getconst(), &status);
     c.raise(status);
-    return result;
+    const mpd_t* a = integral.getconst();
+    bigint out;
+    if (mpd_iszerocoeff(a)) {
+        return out;
+    }
+
+    // coefficient * 10^exp, exp is never negative after to_integral
+    bigdecimal shifted;
+    if (a->exp > 0) {
+        uint32_t status = 0;
+        if (!mpd_qshiftl(shifted.get(), a, a->exp, &status)) {
+            c.raise(status);
+        }
+        a = shifted.getconst();
+    }
+
+    const size_t len = (size_t) a->len;
+    if (len <= WORDS_TO_LIMBS_THRESHOLD) {
+        out.ensure(len);
+        out.m_val->_mp_size = (int) words_to_limbs_basecase(out.m_val->_mp_d, a->data, len);
+    } else {
+        std::vector<unsigned char> digits((size_t) a->digits);
+        const size_t n = words_to_digits(digits.data(), a);
+        // mpn_set_str wants room for largest number of n digits plus one limb
+        out.ensure(digits2bits((uint32_t) n) / GMP_NUMB_BITS + 2);
+        out.m_val->_mp_size = (int) mpn_set_str(out.m_val->_mp_d, digits.data(), n, 10);
+    }
+    if (mpd_isnegative(a)) {
+        mpz_neg(out.m_val, out.m_val);
+    }
+    return out;
 }
 
-bigdecimal bigdecimal::exact(const std::string& s, bd_context& c) {
-    return bigdecimal::exact(s.c_str(), c);
+/*****************************************************************************/
+/*                               String parsing                              */
+/*****************************************************************************/
+
+static ALWAYS_INLINE bool is_digit(char c) {
+    return c >= '0' && c <= '9';
 }
 
-bigdecimal bigdecimal::ln10(int64_t n, bd_context& c) {
-    bigdecimal result;
+void detail::decimal_parse(mpd_t* result, std::string_view s, uint32_t* status_out) {
+    /* bounds exponent while parsing, anything beyond it is overflow or underflow for any context anyway */
+    constexpr int64_t EXP_LIMIT = 2 * MPD_MAX_EMAX;
+
+    const char* p = s.data();
+    const char* const end = p + s.size();
     uint32_t status = 0;
 
-    mpd_ssize_t nn = bigmath::safe_downcast<mpd_ssize_t, int64_t>(n);
-    mpd_qln10(result.get(), nn, &status);
+    uint8_t sign = MPD_POS;
+    if (p != end && (*p == '+' || *p == '-')) {
+        sign = *p == '-' ? MPD_NEG : MPD_POS;
+        p++;
+    }
 
-    c.raise(status);
-    return result;
+    const char* int_first = p;
+    while (p != end && is_digit(*p)) {
+        p++;
+    }
+    const char* const int_last = p;
+
+    bool has_point = false;
+    const char* frac_first = p;
+    const char* frac_last = p;
+    if (p != end && *p == '.') {
+        has_point = true;
+        frac_first = ++p;
+        while (p != end && is_digit(*p)) {
+            p++;
+        }
+        frac_last = p;
+    }
+    const size_t frac_digits = size_t(frac_last - frac_first);
+
+    bool valid = int_first != int_last || frac_first != frac_last;
+
+    int64_t exp = 0;
+    // string without point is parsed as it has ".0" at the end, so exponent is not allowed there
+    if (valid && has_point && p != end && (*p == 'e' || *p == 'E')) {
+        p++;
+        bool exp_neg = false;
+        if (p != end && (*p == '+' || *p == '-')) {
+            exp_neg = *p == '-';
+            p++;
+        }
+        valid = p != end && is_digit(*p);
+        while (p != end && is_digit(*p)) {
+            exp = exp >= EXP_LIMIT / 10 ? EXP_LIMIT : exp * 10 + (*p - '0');
+            p++;
+        }
+        if (exp_neg) {
+            exp = -exp;
+        }
+    }
+
+    if (!valid || p != end) {
+        mpd_seterror(result, MPD_Conversion_syntax, &status);
+        *status_out |= status;
+        return;
+    }
+
+    while (int_first != int_last && *int_first == '0') {
+        int_first++;
+    }
+    if (int_first == int_last) {
+        while (frac_first != frac_last && *frac_first == '0') {
+            frac_first++;
+        }
+    }
+
+    // integer gets one zero digit after point
+    const size_t zero_digit = has_point ? 0 : 1;
+    const size_t ndigits = size_t(int_last - int_first) + size_t(frac_last - frac_first) + zero_digit;
+    const size_t nwords = ndigits == 0 ? 1 : (ndigits + MPD_RDIGITS - 1) / MPD_RDIGITS;
+    if (!resize(result, (mpd_ssize_t) nwords, &status)) {
+        *status_out |= status;
+        return;
+    }
+
+    // pack digits starting from least significant one
+    size_t len = 0;
+    size_t count = 0;
+    mpd_uint_t word = 0;
+    mpd_uint_t mul = 1;
+    const auto push = [&](mpd_uint_t d) {
+        word += d * mul;
+        mul *= 10;
+        if (++count == MPD_RDIGITS) {
+            result->data[len++] = word;
+            word = 0;
+            mul = 1;
+            count = 0;
+        }
+    };
+    if (zero_digit) {
+        push(0);
+    }
+    for (const char* q = frac_last; q != frac_first;) {
+        push(mpd_uint_t(*--q - '0'));
+    }
+    for (const char* q = int_last; q != int_first;) {
+        push(mpd_uint_t(*--q - '0'));
+    }
+    if (count != 0 || len == 0) {
+        result->data[len++] = word;
+    }
+
+    mpd_clear_flags(result);
+    mpd_set_sign(result, sign);
+    result->exp = exp - (int64_t) frac_digits - (int64_t) zero_digit;
+    result->len = (mpd_ssize_t) len;
+    mpd_setdigits(result);
+
+    mpd_context_t maxcontext;
+    mpd_maxcontext(&maxcontext);
+    mpd_qfinalize(result, &maxcontext, &status);
+
+    if (status & (MPD_Inexact | MPD_Rounded | MPD_Clamped)) {
+        /* we want exact results */
+        mpd_seterror(result, MPD_Invalid_operation, &status);
+    }
+    *status_out |= status & MPD_Errors;
+}
+
+void detail::decimal_set_str(mpd_t* result, std::string_view s) {
+    uint32_t status = 0;
+    decimal_parse(result, s, &status);
+    context.raise(status);
+}
+
+/*****************************************************************************/
+/*                          Fixed-point formatting                           */
+/*****************************************************************************/
+
+int detail::fixed_precision(const char* fmt) {
+    /* larger precision is left to mpd_qformat */
+    constexpr int MAX_PRECISION = 100000;
+
+    if (fmt[0] == 'f' && fmt[1] == '\0') {
+        return FMT_ALL_DIGITS;
+    }
+    if (fmt[0] != '.' || !is_digit(fmt[1])) {
+        return FMT_NOT_FIXED;
+    }
+    int precision = 0;
+    const char* p = fmt + 1;
+    while (is_digit(*p)) {
+        precision = precision * 10 + (*p - '0');
+        if (precision > MAX_PRECISION) {
+            return FMT_NOT_FIXED;
+        }
+        p++;
+    }
+    if (p[0] == 'f' && p[1] == '\0') {
+        return precision;
+    }
+    return FMT_NOT_FIXED;
+}
+
+/* output length of NaN or Infinity, same as mpd_to_sci */
+static size_t special_size(const mpd_t* a) {
+    const size_t sign = mpd_isnegative(a) ? 1 : 0;
+    if (mpd_isinfinite(a)) {
+        return sign + 8;
+    }
+    const size_t payload = a->len > 0 ? (size_t) a->digits : 0;
+    return sign + (mpd_issnan(a) ? 4 : 3) + payload;
+}
+
+static char* write_special(char* p, const mpd_t* a) {
+    if (mpd_isnegative(a)) {
+        *p++ = '-';
+    }
+    if (mpd_isinfinite(a)) {
+        std::memcpy(p, "Infinity", 8);
+        return p + 8;
+    }
+    if (mpd_issnan(a)) {
+        *p++ = 's';
+    }
+    std::memcpy(p, "NaN", 3);
+    p += 3;
+    if (a->len > 0) {
+        p += words_to_digits(p, a, '0');
+    }
+    return p;
 }
 
-int32_t bigdecimal::radix() {
-    return 10;
+/* output length of finite a with frac digits after point, exponent of a must be >= -frac */
+static size_t fixed_size(const mpd_t* a, size_t frac) {
+    const size_t sign = mpd_isnegative(a) ? 1 : 0;
+    const size_t point = frac ? 1 : 0;
+    if (mpd_iszerocoeff(a)) {
+        return sign + 1 + point + frac;
+    }
+    // coefficient with trailing zeros, without point
+    const size_t n = size_t(a->digits + a->exp + (int64_t) frac);
+    if (n > frac) {
+        return sign + n + point;
+    }
+    // "0.", zeros after point and all digits
+    return sign + 2 + (frac - n) + n;
 }
 
-std::string bigdecimal::repr(bool capitals) const {
-    std::string s = to_sci(capitals);
+static char* write_fixed(char* p, const mpd_t* a, size_t frac) {
+    if (mpd_isnegative(a)) {
+        *p++ = '-';
+    }
+    if (mpd_iszerocoeff(a)) {
+        *p++ = '0';
+        if (frac) {
+            *p++ = '.';
+            std::memset(p, '0', frac);
+            p += frac;
+        }
+        return p;
+    }
+
+    const size_t zeros = size_t(a->exp + (int64_t) frac);
+    const size_t n = (size_t) a->digits + zeros;
+    if (n > frac) {
+        char* const start = p;
+        p += words_to_digits(p, a, '0');
+        std::memset(p, '0', zeros);
+        p += zeros;
+        if (frac) {
+            char* const point = start + (n - frac);
+            std::memmove(point + 1, point, frac);
+            *point = '.';
+            p++;
+        }
+        return p;
+    }
 
-    return "bigmath::bigdecimal(\"" + s + "\")";
+    *p++ = '0';
+    *p++ = '.';
+    std::memset(p, '0', frac - n);
+    p += frac - n;
+    p += words_to_digits(p, a, '0');
+    std::memset(p, '0', zeros);
+    return p + zeros;
 }
 
-std::ostream& operator<<(std::ostream& os, const bigdecimal& dec) {
-    os << dec.format("f");
-    return os;
+/* value to print with given precision: a itself, or a rounded to precision digits after point into tmp */
+static const mpd_t* fixed_operand(const mpd_t* a, int precision, const bd_context& c, mpd_t* tmp, size_t& frac) {
+    if (precision < 0) {
+        frac = a->exp < 0 ? size_t(-a->exp) : 0;
+        return a;
+    }
+
+    frac = (size_t) precision;
+    if (a->exp >= -(int64_t) precision) {
+        return a;
+    }
+
+    uint32_t status = 0;
+    mpd_context_t ctx;
+    mpd_maxcontext(&ctx);
+    ctx.round = c.getconst()->round;
+    mpd_qrescale(tmp, a, -(mpd_ssize_t) precision, &ctx, &status);
+    if (status & MPD_Malloc_error) {
+        throw malloc_error("out of memory");
+    }
+    return tmp;
+}
+
+std::to_chars_result detail::to_chars_fixed(char* first, char* last, const mpd_t* value, int precision, const bd_context& c) {
+    const size_t room = size_t(last - first);
+    if (mpd_isspecial(value)) {
+        if (special_size(value) > room) {
+            return {last, std::errc::value_too_large};
+        }
+        return {write_special(first, value), std::errc()};
+    }
+
+    bigdecimal rounded;
+    size_t frac;
+    const mpd_t* a = fixed_operand(value, precision, c, rounded.get(), frac);
+    if (fixed_size(a, frac) > room) {
+        return {last, std::errc::value_too_large};
+    }
+    return {write_fixed(first, a, frac), std::errc()};
+}
+
+void detail::append_fixed(std::string& out, const mpd_t* value, int precision, const bd_context& c) {
+    const size_t offset = out.size();
+    if (mpd_isspecial(value)) {
+        out.resize(offset + special_size(value));
+        write_special(&out[offset], value);
+        return;
+    }
+
+    bigdecimal rounded;
+    size_t frac;
+    const mpd_t* a = fixed_operand(value, precision, c, rounded.get(), frac);
+    out.resize(offset + fixed_size(a, frac));
+    write_fixed(&out[offset], a, frac);
 }
 
 } // namespace bigmath
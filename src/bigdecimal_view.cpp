@@ -0,0 +1,407 @@
+/*!
+ * bigmath.
+ * bigdecimal_view.cpp
+ *
+ * \date 10/17/2026
+ * \author Eduard Maximovich (edward.vstock@gmail.com)
+ * \link   https://github.com/edwardstock
+ */
+
+#include "bigmath/bigdecimal_view.h"
+
+#include "bigmath/errors.h"
+
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+
+namespace bigmath {
+
+static_assert(MPD_RDIGITS == 19, "binary encoding stores 64-bit coefficient words");
+
+/*****************************************************************************/
+/*                               Binary encoding                              */
+/*****************************************************************************/
+
+static constexpr uint8_t ENC_SIGN = 0x01;
+static constexpr uint8_t ENC_INF = 0x02;
+static constexpr uint8_t ENC_NAN = 0x04;
+static constexpr uint8_t ENC_SNAN = 0x06;
+static constexpr uint8_t ENC_SPECIAL = 0x06;
+static constexpr size_t WORD_BYTES = 8;
+static constexpr size_t MAX_VARINT = 10;
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__ || defined(_M_X64) || defined(_M_ARM64)
+static constexpr bool LITTLE_ENDIAN_HOST = true;
+#else
+static constexpr bool LITTLE_ENDIAN_HOST = false;
+#endif
+
+static ALWAYS_INLINE uint8_t encode_flags(const mpd_t* a) {
+    uint8_t flags = mpd_isnegative(a) ? ENC_SIGN : 0;
+    if (mpd_isinfinite(a)) {
+        flags |= ENC_INF;
+    } else if (mpd_isqnan(a)) {
+        flags |= ENC_NAN;
+    } else if (mpd_issnan(a)) {
+        flags |= ENC_SNAN;
+    }
+    return flags;
+}
+
+static ALWAYS_INLINE uint8_t decode_flags(uint8_t flags) {
+    uint8_t result = flags & ENC_SIGN ? MPD_NEG : 0;
+    switch (flags & ENC_SPECIAL) {
+        case ENC_INF:
+            result |= MPD_INF;
+            break;
+        case ENC_NAN:
+            result |= MPD_NAN;
+            break;
+        case ENC_SNAN:
+            result |= MPD_SNAN;
+            break;
+        default:
+            break;
+    }
+    return result;
+}
+
+static ALWAYS_INLINE uint64_t zigzag(int64_t v) {
+    return (uint64_t(v) << 1) ^ uint64_t(v >> 63);
+}
+
+static ALWAYS_INLINE int64_t unzigzag(uint64_t v) {
+    return int64_t(v >> 1) ^ -int64_t(v & 1);
+}
+
+static ALWAYS_INLINE size_t varint_size(uint64_t v) {
+    size_t n = 1;
+    for (; v >= 0x80; v >>= 7) {
+        n++;
+    }
+    return n;
+}
+
+static ALWAYS_INLINE uint8_t* put_varint(uint8_t* out, uint64_t v) {
+    for (; v >= 0x80; v >>= 7) {
+        *out++ = uint8_t(v | 0x80);
+    }
+    *out++ = uint8_t(v);
+    return out;
+}
+
+static const uint8_t* get_varint(const uint8_t* p, const uint8_t* end, uint64_t* v) {
+    uint64_t result = 0;
+    for (size_t i = 0; i < MAX_VARINT && p != end; i++) {
+        const uint8_t b = *p++;
+        if (i == MAX_VARINT - 1 && b > 1) {
+            break;
+        }
+        result |= uint64_t(b & 0x7F) << (7 * i);
+        if (!(b & 0x80)) {
+            *v = result;
+            return p;
+        }
+    }
+    throw value_error("bigdecimal encoding: truncated or too long varint");
+}
+
+static ALWAYS_INLINE void put_word(uint8_t* out, uint64_t w) {
+    if (LITTLE_ENDIAN_HOST) {
+        std::memcpy(out, &w, WORD_BYTES);
+    } else {
+        for (size_t i = 0; i < WORD_BYTES; i++) {
+            out[i] = uint8_t(w >> (8 * i));
+        }
+    }
+}
+
+/* words start at offset multiple of 8 from start of encoding, padding bytes are zero */
+static ALWAYS_INLINE size_t padded(size_t header_size) {
+    return (header_size + WORD_BYTES - 1) & ~(WORD_BYTES - 1);
+}
+
+static ALWAYS_INLINE uint64_t get_word(const uint8_t* p) {
+    uint64_t w = 0;
+    if (LITTLE_ENDIAN_HOST) {
+        std::memcpy(&w, p, WORD_BYTES);
+    } else {
+        for (size_t i = 0; i < WORD_BYTES; i++) {
+            w |= uint64_t(p[i]) << (8 * i);
+        }
+    }
+    return w;
+}
+
+size_t detail::decimal_serialized_size(const mpd_t* a) {
+    return padded(1 + varint_size(zigzag(a->exp)) + varint_size(uint64_t(a->len))) + size_t(a->len) * WORD_BYTES;
+}
+
+size_t detail::decimal_serialize(const mpd_t* a, uint8_t* out, size_t size) {
+    const size_t n = decimal_serialized_size(a);
+    if (size < n) {
+        throw value_error("bigdecimal.serialize_to: buffer is too small");
+    }
+    uint8_t* const start = out;
+    *out++ = encode_flags(a);
+    out = put_varint(out, zigzag(a->exp));
+    out = put_varint(out, uint64_t(a->len));
+    const size_t header = size_t(out - start);
+    std::memset(out, 0, padded(header) - header);
+    out = start + padded(header);
+    for (mpd_ssize_t i = 0; i < a->len; i++, out += WORD_BYTES) {
+        put_word(out, a->data[i]);
+    }
+    return n;
+}
+
+/* parsed and validated header of encoding */
+struct encoded {
+    uint8_t flags;
+    mpd_ssize_t exp;
+    mpd_ssize_t len;
+    mpd_ssize_t digits;
+    const uint8_t* words;
+    size_t size;
+};
+
+static encoded parse(const uint8_t* data, size_t size) {
+    const uint8_t* p = data;
+    const uint8_t* end = data + size;
+    if (p == end) {
+        throw value_error("bigdecimal encoding: empty buffer");
+    }
+    encoded e{};
+    const uint8_t header = *p++;
+    if (header & ~(ENC_SIGN | ENC_SPECIAL)) {
+        throw value_error("bigdecimal encoding: unknown header flags");
+    }
+    e.flags = decode_flags(header);
+
+    uint64_t exp = 0, len = 0;
+    p = get_varint(p, end, &exp);
+    p = get_varint(p, end, &len);
+    e.exp = mpd_ssize_t(unzigzag(exp));
+    const size_t words_offset = padded(size_t(p - data));
+    if (words_offset > size) {
+        throw value_error("bigdecimal encoding: truncated padding");
+    }
+    for (; p != data + words_offset; p++) {
+        if (*p != 0) {
+            throw value_error("bigdecimal encoding: nonzero padding");
+        }
+    }
+    if (len > uint64_t(size_t(end - p) / WORD_BYTES)) {
+        throw value_error("bigdecimal encoding: truncated coefficient");
+    }
+    e.len = mpd_ssize_t(len);
+    e.words = p;
+    e.size = size_t(p - data) + size_t(len) * WORD_BYTES;
+
+    if (e.len > 0) {
+        for (mpd_ssize_t i = 0; i < e.len; i++) {
+            if (get_word(e.words + i * WORD_BYTES) >= MPD_RADIX) {
+                throw value_error("bigdecimal encoding: coefficient word is out of range");
+            }
+        }
+        const mpd_uint_t top = get_word(e.words + (e.len - 1) * WORD_BYTES);
+        if (top == 0 && e.len > 1) {
+            throw value_error("bigdecimal encoding: leading zero word");
+        }
+        e.digits = (e.len - 1) * MPD_RDIGITS + mpd_word_digits(top);
+    }
+
+    if (e.flags & MPD_INF) {
+        if (e.len != 0 || e.exp != 0) {
+            throw value_error("bigdecimal encoding: infinity with coefficient");
+        }
+    } else if (e.flags & (MPD_NAN | MPD_SNAN)) {
+        if (e.exp != 0) {
+            throw value_error("bigdecimal encoding: NaN with exponent");
+        }
+    } else if (e.len == 0) {
+        throw value_error("bigdecimal encoding: finite value without coefficient");
+    } else if (e.exp < MPD_MIN_ETINY || e.exp > MPD_MAX_EMAX - e.digits + 1) {
+        throw value_error("bigdecimal encoding: exponent is out of range");
+    }
+    return e;
+}
+
+size_t detail::decimal_deserialize(mpd_t* result, const uint8_t* data, size_t size) {
+    const encoded e = parse(data, size);
+    uint32_t status = 0;
+    if (!mpd_qresize(result, e.len, &status)) {
+        throw malloc_error("out of memory");
+    }
+    mpd_set_flags(result, e.flags);
+    result->exp = e.exp;
+    result->len = e.len;
+    result->digits = e.digits;
+    for (mpd_ssize_t i = 0; i < e.len; i++) {
+        result->data[i] = get_word(e.words + i * WORD_BYTES);
+    }
+    return e.size;
+}
+
+/*****************************************************************************/
+/*                               bigdecimal_view                              */
+/*****************************************************************************/
+
+bigdecimal_view::bigdecimal_view(const uint8_t* data, size_t size)
+    : m_data(data) {
+    const encoded e = parse(data, size);
+    m_words = e.words;
+    m_size = e.size;
+    m_exp = e.exp;
+    m_len = e.len;
+    m_digits = e.digits;
+    m_flags = e.flags;
+}
+
+size_t bigdecimal_view::encoded_size() const {
+    return m_size;
+}
+
+bool bigdecimal_view::issigned() const {
+    return m_flags & MPD_NEG;
+}
+
+bool bigdecimal_view::isspecial() const {
+    return m_flags & MPD_SPECIAL;
+}
+
+bool bigdecimal_view::isnan() const {
+    return m_flags & (MPD_NAN | MPD_SNAN);
+}
+
+bool bigdecimal_view::isinfinite() const {
+    return m_flags & MPD_INF;
+}
+
+bool bigdecimal_view::iszero() const {
+    return !isspecial() && m_len == 1 && word(0) == 0;
+}
+
+mpd_ssize_t bigdecimal_view::exponent() const {
+    return m_exp;
+}
+
+mpd_ssize_t bigdecimal_view::digits() const {
+    return m_digits;
+}
+
+size_t bigdecimal_view::word_count() const {
+    return size_t(m_len);
+}
+
+mpd_uint_t bigdecimal_view::word(size_t i) const {
+    return get_word(m_words + i * WORD_BYTES);
+}
+
+const mpd_uint_t* bigdecimal_view::inplace_words() const {
+    if (LITTLE_ENDIAN_HOST && reinterpret_cast<uintptr_t>(m_words) % alignof(mpd_uint_t) == 0) {
+        return reinterpret_cast<const mpd_uint_t*>(m_words);
+    }
+    return nullptr;
+}
+
+/* mpd_t over coefficient in buffer, or over its copy if words can't be used in place */
+struct view_access {
+    static constexpr mpd_ssize_t STACK_WORDS = 8;
+
+    const bigdecimal_view& view;
+    mpd_uint_t stack[STACK_WORDS];
+    std::unique_ptr<mpd_uint_t[]> heap;
+    mpd_t value;
+
+    explicit view_access(const bigdecimal_view& v)
+        : view(v) {
+        const mpd_uint_t* data = v.inplace_words();
+        if (data == nullptr) {
+            mpd_uint_t* copy = stack;
+            if (v.m_len > STACK_WORDS) {
+                heap.reset(new mpd_uint_t[size_t(v.m_len)]);
+                copy = heap.get();
+            }
+            for (mpd_ssize_t i = 0; i < v.m_len; i++) {
+                copy[i] = v.word(size_t(i));
+            }
+            data = copy;
+        }
+        value = mpd_t{
+            uint8_t(MPD_STATIC | MPD_CONST_DATA | v.m_flags), /* flags */
+            v.m_exp,                                         /* exp */
+            v.m_digits,                                      /* digits */
+            v.m_len,                                         /* len */
+            std::max<mpd_ssize_t>(v.m_len, 1),               /* alloc */
+            const_cast<mpd_uint_t*>(data)                    /* data */
+        };
+    }
+
+    const mpd_t* get() const {
+        return &value;
+    }
+};
+
+int bigdecimal_view::compare(const mpd_t* other) const {
+    const view_access a(*this);
+    uint32_t status = 0;
+    const int r = mpd_qcmp(a.get(), other, &status);
+    if (r == INT_MAX) {
+        context.raise(status);
+    }
+    return r;
+}
+
+int bigdecimal_view::compare(const bigdecimal_view& other) const {
+    const view_access b(other);
+    return compare(b.get());
+}
+
+/* equality raises only for signaling NaN, as bigdecimal operators */
+static bool equals(const bigdecimal_view& a, const bigdecimal_view& b) {
+    const view_access va(a);
+    const view_access vb(b);
+    uint32_t status = 0;
+    const int r = mpd_qcmp(va.get(), vb.get(), &status);
+    if (r == INT_MAX) {
+        if (mpd_issnan(va.get()) || mpd_issnan(vb.get())) {
+            context.raise(status);
+        }
+        return false;
+    }
+    return r == 0;
+}
+
+bool bigdecimal_view::operator==(const bigdecimal_view& other) const {
+    return equals(*this, other);
+}
+
+bool bigdecimal_view::operator!=(const bigdecimal_view& other) const {
+    return !equals(*this, other);
+}
+
+bool bigdecimal_view::operator<(const bigdecimal_view& other) const {
+    const int r = compare(other);
+    return r != INT_MAX && r < 0;
+}
+
+bool bigdecimal_view::operator<=(const bigdecimal_view& other) const {
+    const int r = compare(other);
+    return r != INT_MAX && r <= 0;
+}
+
+bool bigdecimal_view::operator>(const bigdecimal_view& other) const {
+    const int r = compare(other);
+    return r != INT_MAX && r > 0;
+}
+
+bool bigdecimal_view::operator>=(const bigdecimal_view& other) const {
+    const int r = compare(other);
+    return r != INT_MAX && r >= 0;
+}
+
+} // namespace bigmath
@@ -9,6 +9,12 @@
 #include "bigmath/bigint.h"
 
 #include "bigmath/bigdecimal.h"
+#include "bigmath/errors.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <ostream>
 
 const bigmath::bigint bigmath::ZERO = bigmath::bigint("0");
 const bigmath::bigint bigmath::ONE = bigmath::bigint("1");
@@ -16,29 +22,29 @@ const bigmath::bigint bigmath::TWO = bigmath::bigint("2");
 const bigmath::bigint bigmath::THREE = bigmath::bigint("3");
 
 bigmath::bigint::bigint()
-    : m_val(), m_base(10) {
-    m_val.set_str("0", 10);
+    : m_base(10) {
 }
 
 bigmath::bigint::bigint(const std::string& val)
-    : m_val(), m_base(10) {
-    m_val.set_str(val, 10);
+    : m_base(10) {
+    set_str(val, 10);
 }
 bigmath::bigint::bigint(const std::string& val, int32_t radix)
-    : m_val(), m_base(radix) {
-    m_val.set_str(val, radix);
+    : m_base(radix) {
+    set_str(val, radix);
 }
 
-bigmath::bigint::bigint(const std::vector<uint8_t>& bytes)
-    : m_val() {
+bigmath::bigint::bigint(const std::vector<uint8_t>& bytes) {
     import_bytes(bytes);
 }
 bigmath::bigint::bigint(const mpz_class& other, int32_t radix)
-    : m_val(other),
-      m_base(radix) {
+    : m_base(radix) {
+    ensure(mpz_size(other.get_mpz_t()));
+    mpz_set(m_val, other.get_mpz_t());
 }
 bigmath::bigint::bigint(const bigmath::bigint& other) {
-    m_val = other.m_val;
+    ensure(mpz_size(other.m_val));
+    mpz_set(m_val, other.m_val);
     m_base = other.m_base;
 }
 
@@ -47,36 +53,238 @@ bigmath::bigint::bigint(const bigmath::bigdecimal& other) {
 }
 
 bigmath::bigint::bigint(bigmath::bigint&& other) noexcept {
-    m_val = std::move(other.m_val);
+    *this = std::move(other);
+}
+
+bigmath::bigint::~bigint() {
+    if (!is_inline()) {
+        mpz_clear(m_val);
+    }
+}
+
+bigmath::bigint& bigmath::bigint::operator=(bigmath::bigint&& other) noexcept {
+    if (this == &other) {
+        return *this;
+    }
+    if (other.is_inline()) {
+        // our buffer (inline or heap) always has room for inline value
+        mpz_set(m_val, other.m_val);
+    } else {
+        if (!is_inline()) {
+            mpz_clear(m_val);
+        }
+        *m_val = *other.m_val;
+        other.m_val->_mp_alloc = INLINE_LIMBS;
+        other.m_val->_mp_size = 0;
+        other.m_val->_mp_d = other.m_limbs;
+    }
     m_base = other.m_base;
+    return *this;
+}
+
+void bigmath::bigint::reserve(size_t n) {
+    if (is_inline()) {
+        // move value to the regular GMP-allocated buffer, after that GMP manages it by itself
+        mpz_t heap;
+        mpz_init2(heap, n * GMP_NUMB_BITS);
+        mpz_set(heap, m_val);
+        *m_val = *heap;
+    } else {
+        mpz_realloc2(m_val, n * GMP_NUMB_BITS);
+    }
+}
+
+static int digit_value(char c) {
+    if (c >= '0' && c <= '9') {
+        return c - '0';
+    }
+    if (c >= 'a' && c <= 'z') {
+        return c - 'a' + 10;
+    }
+    if (c >= 'A' && c <= 'Z') {
+        return c - 'A' + 10;
+    }
+    return -1;
+}
+
+void bigmath::bigint::set_str(const std::string& val, int32_t radix) {
+    // every digit of base <= 62 takes less than 6 bits
+    static constexpr size_t MAX_FAST_DIGITS = 64;
+    static constexpr size_t MAX_DIGIT_BITS = 6;
+
+    // mpz_set_str reserves limbs by upper estimate (~3 limbs for 20-digit number), that would move value
+    // to heap even if it fits inline buffer, so plain [-]digits strings are converted on stack with mpn_set_str
+    const size_t neg = !val.empty() && val[0] == '-' ? 1 : 0;
+    const size_t ndigits = val.size() - neg;
+    if (radix >= 2 && radix <= 36 && ndigits > 0 && ndigits <= MAX_FAST_DIGITS) {
+        unsigned char digits[MAX_FAST_DIGITS];
+        size_t n = 0;
+        bool valid = true;
+        for (size_t i = neg; i < val.size(); i++) {
+            const int d = digit_value(val[i]);
+            if (d < 0 || d >= radix) {
+                valid = false;
+                break;
+            }
+            // mpn_set_str wants most significant digit to be non-zero
+            if (n == 0 && d == 0) {
+                continue;
+            }
+            digits[n++] = (unsigned char) d;
+        }
+
+        if (valid) {
+            if (n == 0) {
+                mpz_set_ui(m_val, 0);
+                return;
+            }
+            // mpn_set_str requires space for largest number of given digits plus one limb
+            mp_limb_t limbs[(MAX_FAST_DIGITS * MAX_DIGIT_BITS) / GMP_NUMB_BITS + 2];
+            const mp_size_t size = mpn_set_str(limbs, digits, n, radix);
+            ensure(size);
+            std::copy(limbs, limbs + size, m_val->_mp_d);
+            m_val->_mp_size = neg ? -(int) size : (int) size;
+            return;
+        }
+    }
+
+    // same estimate as mpz_set_str does, otherwise it would reallocate inline buffer
+    ensure((val.size() * MAX_DIGIT_BITS) / GMP_NUMB_BITS + 2);
+    mpz_set_str(m_val, val.c_str(), radix);
+}
+
+void bigmath::bigint::pow_ui(bigmath::bigint& out, const bigmath::bigint& base, unsigned long int exp) {
+    // mpz_pow_ui reserves bits(base) * exp / GMP_NUMB_BITS + 5 limbs before computing
+    if (mpz_sgn(base.m_val) != 0 && exp > 0) {
+        out.ensure(mpz_sizeinbase(base.m_val, 2) * exp / GMP_NUMB_BITS + 6);
+    }
+    mpz_pow_ui(out.m_val, base.m_val, exp);
+}
+
+void bigmath::bigint::sqrt_rem(bigmath::bigint& s, bigmath::bigint& r, const bigmath::bigint& n) {
+    if (mpz_sgn(n.m_val) < 0) {
+        throw bigmath::value_error("square root of negative value");
+    }
+    const size_t size = mpz_size(n.m_val);
+    // mpz_sqrtrem reserves size of operand for remainder
+    s.ensure(size / 2 + 1);
+    r.ensure(std::max<size_t>(size, 1));
+    mpz_sqrtrem(s.m_val, r.m_val, n.m_val);
 }
+
 int32_t bigmath::bigint::get_radix() const {
     return m_base;
 }
 mp_bitcnt_t bigmath::bigint::get_precision() const {
-    return m_val.get_prec();
+    return mpf_get_default_prec();
 }
 std::string bigmath::bigint::str() const {
-    return m_val.get_str(m_base);
+    std::string out;
+    append_to(out);
+    return out;
+}
+
+/* upper bound of mpz_get_str output: digits (exact or 1 more), sign and null terminator */
+static size_t get_str_size(mpz_srcptr v, int32_t radix) {
+    const int base = std::abs(radix);
+    return mpz_sizeinbase(v, base < 2 ? 10 : base) + 2;
 }
-std::vector<uint8_t> bigmath::bigint::export_bytes() const {
-    std::vector<uint8_t> data;
-    data.resize(get_precision());
-    size_t count = 0;
-    mpz_export(data.data(), &count, 1, sizeof(uint8_t), 1, 0, m_val.get_mpz_t());
 
-    std::vector<uint8_t> out;
-    out.resize(count);
-    for (size_t i = 0; i < count; i++) {
-        out[i] = data[i];
+std::to_chars_result bigmath::bigint::to_chars(char* first, char* last) const {
+    const size_t bound = get_str_size(m_val, m_base);
+    const size_t room = size_t(last - first);
+    if (bound <= room) {
+        const size_t n = std::strlen(mpz_get_str(first, m_base, m_val));
+        return {first + n, std::errc()};
     }
-    if (count == 0) {
-        out.resize(1);
-        out[0] = (uint8_t) 0x00;
+
+    // mpz_get_str may need one or two chars more than result has, so write to temporary buffer
+    char small[160];
+    std::string large;
+    char* buf = small;
+    if (bound > sizeof(small)) {
+        large.resize(bound);
+        buf = &large[0];
+    }
+    const size_t n = std::strlen(mpz_get_str(buf, m_base, m_val));
+    if (n > room) {
+        return {last, std::errc::value_too_large};
     }
+    std::memcpy(first, buf, n);
+    return {first + n, std::errc()};
+}
 
+void bigmath::bigint::append_to(std::string& out) const {
+    const size_t offset = out.size();
+    out.resize(offset + get_str_size(m_val, m_base));
+    const size_t n = std::strlen(mpz_get_str(&out[offset], m_base, m_val));
+    out.resize(offset + n);
+}
+
+namespace bigmath {
+std::ostream& operator<<(std::ostream& os, const bigint& val) {
+    char buf[160];
+    const std::to_chars_result res = val.to_chars(buf, buf + sizeof(buf));
+    if (res.ec == std::errc()) {
+        os.write(buf, res.ptr - buf);
+    } else {
+        os << val.str();
+    }
+    return os;
+}
+} // namespace bigmath
+std::vector<uint8_t> bigmath::bigint::export_bytes() const {
+    std::vector<uint8_t> out(byte_size());
+    export_to(out.data(), out.size());
     return out;
 }
 void bigmath::bigint::import_bytes(const std::vector<uint8_t>& input) {
-    mpz_import(m_val.get_mpz_t(), input.size(), 1, sizeof(uint8_t), 1, 0, input.data());
+    import_from(input.data(), input.size());
+}
+
+size_t bigmath::bigint::byte_size() const {
+    return mpz_sgn(m_val) == 0 ? 1 : (mpz_sizeinbase(m_val, 2) + 7) / 8;
+}
+
+/* bytes are moved between limbs and buffer directly: mpz_export and mpz_import handle arbitrary word sizes
+ * and nails and are several times slower for short values */
+static_assert(GMP_NAIL_BITS == 0, "bigint byte I/O requires limbs without nail bits");
+
+size_t bigmath::bigint::export_to(uint8_t* out, size_t len, endian order, bool fixed_width) const {
+    const size_t size = byte_size();
+    if (len < size) {
+        throw value_error("output buffer is too small for bigint");
+    }
+    const size_t width = fixed_width ? len : size;
+    const mp_limb_t* limbs = m_val->_mp_d;
+    // zero has no limbs but is written as one 0x00 byte
+    const size_t bytes = mpz_sgn(m_val) == 0 ? 0 : size;
+    if (order == endian::big) {
+        std::memset(out, 0, width - bytes);
+        uint8_t* last = out + width - 1;
+        for (size_t i = 0; i < bytes; i++) {
+            last[-ptrdiff_t(i)] = uint8_t(limbs[i / sizeof(mp_limb_t)] >> (8 * (i % sizeof(mp_limb_t))));
+        }
+    } else {
+        for (size_t i = 0; i < bytes; i++) {
+            out[i] = uint8_t(limbs[i / sizeof(mp_limb_t)] >> (8 * (i % sizeof(mp_limb_t))));
+        }
+        std::memset(out + bytes, 0, width - bytes);
+    }
+    return width;
+}
+
+void bigmath::bigint::import_from(const uint8_t* data, size_t len, endian order) {
+    size_t n = (len + sizeof(mp_limb_t) - 1) / sizeof(mp_limb_t);
+    ensure(n);
+    mp_limb_t* limbs = m_val->_mp_d;
+    std::fill(limbs, limbs + n, mp_limb_t(0));
+    for (size_t i = 0; i < len; i++) {
+        const uint8_t b = order == endian::big ? data[len - 1 - i] : data[i];
+        limbs[i / sizeof(mp_limb_t)] |= mp_limb_t(b) << (8 * (i % sizeof(mp_limb_t)));
+    }
+    while (n > 0 && limbs[n - 1] == 0) {
+        n--;
+    }
+    m_val->_mp_size = int(n);
 }
@@ -0,0 +1,128 @@
+/*!
+ * bigmath.
+ * checked.cpp
+ *
+ * \date 10/17/2026
+ * \author Eduard Maximovich (edward.vstock@gmail.com)
+ * \link   https://github.com/edwardstock
+ */
+
+#include "bigmath/checked.h"
+
+#include <string>
+
+namespace bigmath {
+namespace checked {
+
+static_assert(sizeof(mp_limb_t) == 8 && GMP_NAIL_BITS == 0, "checked conversions expect 64-bit GMP limbs");
+
+using bigmath::detail::bigint_access;
+
+static int digit_value(char c) {
+    if (c >= '0' && c <= '9') {
+        return c - '0';
+    }
+    if (c >= 'a' && c <= 'z') {
+        return c - 'a' + 10;
+    }
+    if (c >= 'A' && c <= 'Z') {
+        return c - 'A' + 10;
+    }
+    return -1;
+}
+
+result<bigint> parse_bigint(std::string_view s, int32_t radix) {
+    result<bigint> r;
+    if (radix < 2 || radix > 36) {
+        r.status = MPD_Invalid_operation;
+        return r;
+    }
+    const size_t first = !s.empty() && s[0] == '-' ? 1 : 0;
+    bool valid = s.size() > first;
+    for (size_t i = first; valid && i < s.size(); i++) {
+        const int d = digit_value(s[i]);
+        valid = d >= 0 && d < radix;
+    }
+    if (!valid) {
+        r.status = MPD_Conversion_syntax;
+        return r;
+    }
+    r.value = bigint(std::string(s), radix);
+    return r;
+}
+
+/* magnitude of value that has at most one limb, false if it's larger */
+static bool small_magnitude(const bigint& a, uint64_t& m) {
+    mpz_srcptr z = bigint_access::val(a);
+    const size_t n = mpz_size(z);
+    m = n == 0 ? 0 : uint64_t(z->_mp_d[0]);
+    return n <= 1;
+}
+
+result<int64_t> to_i64(const bigint& a) {
+    result<int64_t> r;
+    uint64_t m;
+    const bool neg = mpz_sgn(bigint_access::val(a)) < 0;
+    const uint64_t limit = neg ? uint64_t(1) << 63 : (uint64_t(1) << 63) - 1;
+    if (!small_magnitude(a, m) || m > limit) {
+        r.status = MPD_Invalid_operation;
+        return r;
+    }
+    r.value = neg ? int64_t(0 - m) : int64_t(m);
+    return r;
+}
+
+result<uint64_t> to_u64(const bigint& a) {
+    result<uint64_t> r;
+    uint64_t m;
+    if (!small_magnitude(a, m) || mpz_sgn(bigint_access::val(a)) < 0) {
+        r.status = MPD_Invalid_operation;
+        return r;
+    }
+    r.value = m;
+    return r;
+}
+
+result<bigint> div(const bigint& a, const bigint& b) {
+    result<bigint> r;
+    if (detail::is_zero(b)) {
+        r.status = MPD_Division_by_zero;
+        return r;
+    }
+    r.value = a / b;
+    return r;
+}
+
+result<bigint> mod(const bigint& a, const bigint& b) {
+    result<bigint> r;
+    if (detail::is_zero(b)) {
+        r.status = MPD_Division_by_zero;
+        return r;
+    }
+    r.value = a % b;
+    return r;
+}
+
+result<std::pair<bigint, bigint>> divmod(const bigint& a, const bigint& b) {
+    result<std::pair<bigint, bigint>> r;
+    if (detail::is_zero(b)) {
+        r.status = MPD_Division_by_zero;
+        return r;
+    }
+    bigint::tdiv_qr(r.value.first, r.value.second, a, b);
+    return r;
+}
+
+result<bigint> sqrt(const bigint& a) {
+    result<bigint> r;
+    if (mpz_sgn(bigint_access::val(a)) < 0) {
+        r.status = MPD_Invalid_operation;
+        return r;
+    }
+    bigint rem;
+    bigint::sqrt_rem(r.value, rem, a);
+    return r;
+}
+
+} // namespace checked
+} // namespace bigmath
@@ -0,0 +1,327 @@
+/*!
+ * bigmath.
+ * decimal_column.cpp
+ *
+ * \date 10/17/2026
+ * \author Eduard Maximovich (edward.vstock@gmail.com)
+ * \link   https://github.com/edwardstock
+ */
+
+#include "bigmath/decimal_column.h"
+
+#include "bigmath/batch.h"
+#include "bigmath/errors.h"
+
+#include <algorithm>
+#include <climits>
+
+namespace bigmath {
+
+static_assert(decimal_column::INLINE_WORDS == 2, "kernels handle coefficient of two words");
+
+static constexpr uint8_t VALUE_FLAGS = MPD_NEG | MPD_SPECIAL;
+static constexpr mpd_ssize_t INLINE_DIGITS = decimal_column::INLINE_WORDS * MPD_RDIGITS;
+
+static ALWAYS_INLINE mpd_ssize_t words_of(mpd_ssize_t digits) {
+    return (digits + MPD_RDIGITS - 1) / MPD_RDIGITS;
+}
+
+/*****************************************************************************/
+/*                                  Storage                                   */
+/*****************************************************************************/
+
+size_t decimal_column::size() const {
+    return m_flags.size();
+}
+
+bool decimal_column::empty() const {
+    return m_flags.empty();
+}
+
+void decimal_column::reserve(size_t n) {
+    m_flags.reserve(n);
+    m_exp.reserve(n);
+    m_digits.reserve(n);
+    m_words.reserve(n * INLINE_WORDS);
+}
+
+void decimal_column::clear() {
+    m_flags.clear();
+    m_exp.clear();
+    m_digits.clear();
+    m_words.clear();
+    m_spill.clear();
+}
+
+void decimal_column::resize(size_t n) {
+    m_flags.resize(n);
+    m_exp.resize(n);
+    m_digits.resize(n);
+    m_words.resize(n * INLINE_WORDS);
+}
+
+void decimal_column::push_back(const mpd_t* v) {
+    resize(size() + 1);
+    store(size() - 1, v);
+}
+
+void decimal_column::set(size_t i, const mpd_t* v) {
+    store(i, v);
+}
+
+void decimal_column::store(size_t i, const mpd_t* v) {
+    m_flags[i] = v->flags & VALUE_FLAGS;
+    m_exp[i] = v->exp;
+    m_digits[i] = v->digits;
+    mpd_uint_t* words = &m_words[i * INLINE_WORDS];
+    if (v->len <= INLINE_WORDS) {
+        for (mpd_ssize_t k = 0; k < INLINE_WORDS; k++) {
+            words[k] = k < v->len ? v->data[k] : 0;
+        }
+    } else {
+        words[0] = m_spill.size();
+        words[1] = 0;
+        m_spill.insert(m_spill.end(), v->data, v->data + v->len);
+    }
+}
+
+mpd_t decimal_column::view(size_t i) const {
+    const mpd_ssize_t len = words_of(m_digits[i]);
+    const mpd_uint_t* words = &m_words[i * INLINE_WORDS];
+    const mpd_uint_t* data = len <= INLINE_WORDS ? words : &m_spill[words[0]];
+    return mpd_t{
+        uint8_t(MPD_STATIC | MPD_CONST_DATA | m_flags[i]), /* flags */
+        m_exp[i],                                          /* exp */
+        m_digits[i],                                       /* digits */
+        len,                                               /* len */
+        std::max(len, INLINE_WORDS),                       /* alloc */
+        const_cast<mpd_uint_t*>(data)                      /* data */
+    };
+}
+
+bool decimal_column::issigned(size_t i) const {
+    return m_flags[i] & MPD_NEG;
+}
+
+mpd_ssize_t decimal_column::exponent(size_t i) const {
+    return m_exp[i];
+}
+
+mpd_ssize_t decimal_column::digits(size_t i) const {
+    return m_digits[i];
+}
+
+/*****************************************************************************/
+/*                                  Kernels                                   */
+/*****************************************************************************/
+
+#ifdef HAVE_UINT128_T
+__extension__ typedef unsigned __int128 word_sum_t;
+
+/* acc += hi * RADIX + lo with given exponent and sign */
+static void add_word_sums(mpd_t* acc, word_sum_t hi, word_sum_t lo, mpd_ssize_t exp, bool neg,
+                          const mpd_context_t* ctx, uint32_t* status) {
+    mpd_uint_t data[8];
+    mpd_ssize_t len = 1;
+    data[0] = mpd_uint_t(lo % MPD_RADIX);
+    for (word_sum_t t = hi + lo / MPD_RADIX; t != 0; t /= MPD_RADIX) {
+        data[len++] = mpd_uint_t(t % MPD_RADIX);
+    }
+    mpd_t v{uint8_t(MPD_STATIC | MPD_CONST_DATA | (neg ? MPD_NEG : 0)), exp, 0, len, 8, data};
+    mpd_setdigits(&v);
+    mpd_qadd(acc, acc, &v, ctx, status);
+}
+#endif
+
+bigdecimal decimal_column::sum(bd_context& c) const {
+    const mpd_context_t exact = batch::detail::exact_context(*c.getconst());
+    uint32_t status = 0;
+    bigdecimal acc;
+    mpd_qset_ssize(acc.get(), 0, &exact, &status);
+
+    /* finite values with exponent of the first finite one and inline coefficient: words are summed column by column,
+     * positive and negative separately, carries are normalized once at the end */
+    const size_t n = size();
+    const auto* first = std::find_if(m_flags.data(), m_flags.data() + n, [](uint8_t f) { return !(f & MPD_SPECIAL); });
+    const mpd_ssize_t ref_exp = first != m_flags.data() + n ? m_exp[size_t(first - m_flags.data())] : 0;
+    const auto fast = [this, ref_exp](size_t i) {
+        return !(m_flags[i] & MPD_SPECIAL) && m_exp[i] == ref_exp && m_digits[i] <= INLINE_DIGITS;
+    };
+
+#ifdef HAVE_UINT128_T
+    word_sum_t lo[2] = {0, 0};
+    word_sum_t hi[2] = {0, 0};
+    /* zeros are added too, they keep exponent of result as in batch::sum */
+    bool any[2] = {false, false};
+    for (size_t i = 0; i < n; i++) {
+        if (fast(i)) {
+            const size_t neg = m_flags[i] & MPD_NEG ? 1 : 0;
+            lo[neg] += m_words[i * INLINE_WORDS];
+            hi[neg] += m_words[i * INLINE_WORDS + 1];
+            any[neg] = true;
+        }
+    }
+    for (int neg = 0; neg < 2; neg++) {
+        if (any[neg]) {
+            add_word_sums(acc.get(), hi[neg], lo[neg], ref_exp, neg, &exact, &status);
+        }
+    }
+    const auto slow = [&fast](size_t i) { return !fast(i); };
+#else
+    const auto slow = [](size_t) { return true; };
+#endif
+
+    for (size_t i = 0; i < n; i++) {
+        if (slow(i)) {
+            const mpd_t v = view(i);
+            mpd_qadd(acc.get(), acc.getconst(), &v, &exact, &status);
+        }
+    }
+    mpd_qplus(acc.get(), acc.getconst(), c.getconst(), &status);
+    c.raise(status);
+    return acc;
+}
+
+bigdecimal decimal_column::sum() const {
+    if (context.policy() == precision_policy::fixed) {
+        return sum(context);
+    }
+    const mpd_ssize_t digits = empty() ? 0 : *std::max_element(m_digits.begin(), m_digits.end());
+    bd_context c = batch::detail::operand_context(digits + batch::detail::count_digits(size()));
+    return sum(c);
+}
+
+/* magnitude comparison of two-word coefficients */
+static ALWAYS_INLINE int cmp_words(mpd_uint_t a1, mpd_uint_t a0, mpd_uint_t b1, mpd_uint_t b0) {
+    if (a1 != b1) {
+        return a1 < b1 ? -1 : 1;
+    }
+    if (a0 != b0) {
+        return a0 < b0 ? -1 : 1;
+    }
+    return 0;
+}
+
+void decimal_column::add(const decimal_column& a, const decimal_column& b, decimal_column& out, bd_context& c) {
+    if (a.size() != b.size()) {
+        throw value_error("addition of columns with different sizes");
+    }
+    uint32_t status = 0;
+    add_impl(a, b, out, *c.getconst(), false, &status);
+    c.raise(status);
+}
+
+void decimal_column::add(const decimal_column& a, const decimal_column& b, decimal_column& out) {
+    if (context.policy() == precision_policy::fixed) {
+        add(a, b, out, context);
+        return;
+    }
+    if (a.size() != b.size()) {
+        throw value_error("addition of columns with different sizes");
+    }
+    uint32_t status = 0;
+    add_impl(a, b, out, OPERAND_CONTEXT, true, &status);
+    bd_context(OPERAND_CONTEXT).raise(status);
+}
+
+void decimal_column::add_impl(const decimal_column& a,
+                              const decimal_column& b,
+                              decimal_column& out,
+                              mpd_context_t ctx,
+                              bool operand_prec,
+                              uint32_t* status) {
+    const size_t n = a.size();
+    out.resize(n);
+    bigdecimal tmp;
+    for (size_t i = 0; i < n; i++) {
+        if (operand_prec) {
+            ctx.prec = std::min<mpd_ssize_t>(std::max<mpd_ssize_t>({a.m_digits[i], b.m_digits[i], 1}), MPD_MAX_PREC);
+        }
+        const uint8_t fa = a.m_flags[i];
+        const uint8_t fb = b.m_flags[i];
+        const mpd_ssize_t exp = a.m_exp[i];
+        if (!((fa | fb) & MPD_SPECIAL) && exp == b.m_exp[i] && a.m_digits[i] <= INLINE_DIGITS &&
+            b.m_digits[i] <= INLINE_DIGITS) {
+            const mpd_uint_t a0 = a.m_words[i * 2], a1 = a.m_words[i * 2 + 1];
+            const mpd_uint_t b0 = b.m_words[i * 2], b1 = b.m_words[i * 2 + 1];
+            mpd_uint_t lo, hi;
+            uint8_t sign;
+            if ((fa & MPD_NEG) == (fb & MPD_NEG)) {
+                /* 2 * (RADIX - 1) can wrap 64 bits, subtraction of RADIX is modulo 2^64 */
+                lo = a0 + b0;
+                const mpd_uint_t carry = lo < a0 || lo >= MPD_RADIX ? 1 : 0;
+                lo -= carry * MPD_RADIX;
+                /* high words of 2^63 and more wrap 64 bits too, MPD_RADIX sends sum to mpdecimal below */
+                hi = a1 >= MPD_RADIX - b1 - carry ? MPD_RADIX : a1 + b1 + carry;
+                sign = fa & MPD_NEG;
+            } else {
+                const int r = cmp_words(a1, a0, b1, b0);
+                const bool a_larger = r >= 0;
+                const mpd_uint_t x0 = a_larger ? a0 : b0, x1 = a_larger ? a1 : b1;
+                const mpd_uint_t y0 = a_larger ? b0 : a0, y1 = a_larger ? b1 : a1;
+                const mpd_uint_t borrow = x0 < y0 ? 1 : 0;
+                lo = x0 + borrow * MPD_RADIX - y0;
+                hi = x1 - y1 - borrow;
+                if (r == 0) {
+                    /* x + (-x) is +0, except rounding to -inf */
+                    sign = ctx.round == MPD_ROUND_FLOOR ? MPD_NEG : 0;
+                } else {
+                    sign = (a_larger ? fa : fb) & MPD_NEG;
+                }
+            }
+            if (hi < MPD_RADIX) {
+                const mpd_ssize_t digits = hi != 0 ? MPD_RDIGITS + mpd_word_digits(hi) : mpd_word_digits(lo);
+                const mpd_ssize_t adjexp = exp + digits - 1;
+                /* exact result without rounding, clamping or subnormal flags */
+                if (digits <= ctx.prec && adjexp <= ctx.emax && adjexp >= ctx.emin &&
+                    (!ctx.clamp || exp <= ctx.emax - ctx.prec + 1)) {
+                    out.m_flags[i] = sign;
+                    out.m_exp[i] = exp;
+                    out.m_digits[i] = digits;
+                    out.m_words[i * 2] = lo;
+                    out.m_words[i * 2 + 1] = hi;
+                    continue;
+                }
+            }
+        }
+        const mpd_t va = a.view(i);
+        const mpd_t vb = b.view(i);
+        mpd_qadd(tmp.get(), &va, &vb, &ctx, status);
+        out.store(i, tmp.getconst());
+    }
+}
+
+void decimal_column::compare(const decimal_column& a, const decimal_column& b, std::vector<int>& out) {
+    if (a.size() != b.size()) {
+        throw value_error("comparison of columns with different sizes");
+    }
+    const size_t n = a.size();
+    out.resize(n);
+    uint32_t status = 0;
+    for (size_t i = 0; i < n; i++) {
+        const uint8_t fa = a.m_flags[i];
+        const uint8_t fb = b.m_flags[i];
+        if (!((fa | fb) & MPD_SPECIAL) && a.m_exp[i] == b.m_exp[i] && a.m_digits[i] <= INLINE_DIGITS &&
+            b.m_digits[i] <= INLINE_DIGITS) {
+            const mpd_uint_t a0 = a.m_words[i * 2], a1 = a.m_words[i * 2 + 1];
+            const mpd_uint_t b0 = b.m_words[i * 2], b1 = b.m_words[i * 2 + 1];
+            /* signs of values, zero has no sign */
+            const int sa = (a0 | a1) == 0 ? 0 : (fa & MPD_NEG ? -1 : 1);
+            const int sb = (b0 | b1) == 0 ? 0 : (fb & MPD_NEG ? -1 : 1);
+            if (sa != sb) {
+                out[i] = sa < sb ? -1 : 1;
+            } else {
+                out[i] = sa * cmp_words(a1, a0, b1, b0);
+            }
+            continue;
+        }
+        const mpd_t va = a.view(i);
+        const mpd_t vb = b.view(i);
+        out[i] = mpd_qcmp(&va, &vb, &status);
+    }
+    if (status != 0) {
+        context.raise(status);
+    }
+}
+
+} // namespace bigmath
@@ -0,0 +1,309 @@
+/*!
+ * bigmath.
+ * fixed_decimal.cpp
+ *
+ * \date 10/17/2026
+ * \author Eduard Maximovich (edward.vstock@gmail.com)
+ * \link   https://github.com/edwardstock
+ */
+
+#include "bigmath/fixed_decimal.h"
+
+#ifdef HAVE_UINT128_T
+
+#include <algorithm>
+#include <gmp.h>
+
+namespace bigmath {
+
+using u128 = uint128_t;
+
+static_assert(sizeof(mp_limb_t) == 8, "fixed_decimal expects 64-bit GMP limbs");
+static_assert(MPD_RADIX == 10000000000000000000ULL, "fixed_decimal expects 64-bit mpdecimal words");
+
+constexpr u128 MAX_MAGNITUDE = u128(~u128(0) >> 1);
+
+static u128 magnitude(int128_t v) {
+    return v < 0 ? u128(0) - u128(v) : u128(v);
+}
+
+static int128_t checked_signed(u128 v, bool neg) {
+    if (v > MAX_MAGNITUDE) {
+        throw overflow_error("fixed_decimal: value is out of range");
+    }
+    return neg ? -int128_t(v) : int128_t(v);
+}
+
+static mp_size_t set_limbs(mp_limb_t* p, u128 v) {
+    p[0] = mp_limb_t(v);
+    p[1] = mp_limb_t(v >> 64);
+    return p[1] ? 2 : (p[0] ? 1 : 0);
+}
+
+/*****************************************************************************/
+/*                          Rounded multiply-divide                          */
+/*****************************************************************************/
+
+/* product of two 127-bit magnitudes has 4 limbs, rounding can carry into the 5th */
+constexpr mp_size_t MULDIV_LIMBS = 5;
+
+/* same decisions as mpdecimal _mpd_apply_round: cmp is remainder vs half of divisor */
+static bool round_up(int round, bool neg, bool odd, mp_limb_t last_digit, int cmp) {
+    switch (round) {
+        case MPD_ROUND_UP:
+            return true;
+        case MPD_ROUND_CEILING:
+            return !neg;
+        case MPD_ROUND_FLOOR:
+            return neg;
+        case MPD_ROUND_HALF_UP:
+            return cmp >= 0;
+        case MPD_ROUND_HALF_DOWN:
+            return cmp > 0;
+        case MPD_ROUND_HALF_EVEN:
+            return cmp > 0 || (cmp == 0 && odd);
+        case MPD_ROUND_05UP:
+            return last_digit == 0 || last_digit == 5;
+        default: /* MPD_ROUND_DOWN, MPD_ROUND_TRUNC */
+            return false;
+    }
+}
+
+/* magnitude of round(a * b / c) to q, sign to neg, returns number of limbs; c is not zero */
+static mp_size_t muldiv(mp_limb_t* q, bool& neg, int128_t a, int128_t b, int128_t c, int round) {
+    mp_limb_t al[2], bl[2], cl[2], prod[4], rem[2] = {0, 0};
+    const mp_size_t an = set_limbs(al, magnitude(a));
+    const mp_size_t bn = set_limbs(bl, magnitude(b));
+    const mp_size_t cn = set_limbs(cl, magnitude(c));
+    neg = ((a < 0) != (b < 0)) != (c < 0);
+    if (an == 0 || bn == 0) {
+        neg = false;
+        return 0;
+    }
+
+    if (an >= bn) {
+        mpn_mul(prod, al, an, bl, bn);
+    } else {
+        mpn_mul(prod, bl, bn, al, an);
+    }
+    mp_size_t pn = an + bn;
+    while (pn > 0 && prod[pn - 1] == 0) {
+        pn--;
+    }
+
+    mp_size_t qn = 0;
+    if (pn < cn) {
+        std::copy(prod, prod + pn, rem);
+    } else {
+        mpn_tdiv_qr(q, rem, 0, prod, pn, cl, cn);
+        qn = pn - cn + 1;
+        while (qn > 0 && q[qn - 1] == 0) {
+            qn--;
+        }
+    }
+
+    const u128 r = u128(rem[0]) | (u128(rem[1]) << 64);
+    if (r == 0) {
+        return qn;
+    }
+    /* r < |c| <= 2^127, so 2r doesn't overflow */
+    const u128 divisor = magnitude(c);
+    const int cmp = 2 * r < divisor ? -1 : (2 * r == divisor ? 0 : 1);
+    const bool odd = qn > 0 && (q[0] & 1);
+    const mp_limb_t last_digit = qn > 0 ? mpn_mod_1(q, qn, 10) : 0;
+    if (round_up(round, neg, odd, last_digit, cmp)) {
+        if (qn == 0) {
+            q[qn++] = 1;
+        } else if (mpn_add_1(q, q, qn, 1)) {
+            q[qn++] = 1;
+        }
+    }
+    return qn;
+}
+
+/* limbs {p, n} to coefficient of result with exponent -scale, p is destroyed */
+static void limbs_to_decimal(mpd_t* result, mp_limb_t* p, mp_size_t n, bool neg, int scale) {
+    mpd_uint_t words[MULDIV_LIMBS + 1];
+    mpd_ssize_t len = 0;
+    while (n > 0) {
+        words[len++] = mpn_divrem_1(p, 0, p, n, MPD_RADIX);
+        while (n > 0 && p[n - 1] == 0) {
+            n--;
+        }
+    }
+    if (len == 0) {
+        words[len++] = 0;
+    }
+
+    uint32_t status = 0;
+    if (!mpd_qresize(result, len, &status)) {
+        throw malloc_error("out of memory");
+    }
+    std::copy(words, words + len, result->data);
+    mpd_clear_flags(result);
+    mpd_set_sign(result, neg && (len > 1 || words[0] != 0) ? MPD_NEG : MPD_POS);
+    result->exp = -scale;
+    result->len = len;
+    mpd_setdigits(result);
+}
+
+bool detail::fixed_muldiv(int128_t a, int128_t b, int128_t c, int round, int128_t& result) {
+    mp_limb_t q[MULDIV_LIMBS];
+    bool neg;
+    const mp_size_t qn = muldiv(q, neg, a, b, c, round);
+    if (qn > 2) {
+        return false;
+    }
+    const u128 v = qn == 0 ? 0 : (qn == 1 ? u128(q[0]) : u128(q[0]) | (u128(q[1]) << 64));
+    if (v > MAX_MAGNITUDE) {
+        return false;
+    }
+    result = neg ? -int128_t(v) : int128_t(v);
+    return true;
+}
+
+void detail::fixed_muldiv_decimal(mpd_t* result, int128_t a, int128_t b, int128_t c, int round, int scale) {
+    mp_limb_t q[MULDIV_LIMBS];
+    bool neg;
+    const mp_size_t qn = muldiv(q, neg, a, b, c, round);
+    limbs_to_decimal(result, q, qn, neg, scale);
+}
+
+/*****************************************************************************/
+/*                               Conversions                                 */
+/*****************************************************************************/
+
+static bool checked_shift(u128& v, int digits) {
+    for (int i = 0; i < digits; i++) {
+        if (__builtin_mul_overflow(v, u128(10), &v)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+int128_t detail::fixed_parse(std::string_view s, int scale) {
+    size_t i = 0;
+    bool neg = false;
+    if (i < s.size() && (s[i] == '+' || s[i] == '-')) {
+        neg = s[i] == '-';
+        i++;
+    }
+
+    u128 v = 0;
+    bool overflow = false;
+    size_t digits = 0;
+    for (; i < s.size() && s[i] >= '0' && s[i] <= '9'; i++, digits++) {
+        overflow |= __builtin_mul_overflow(v, u128(10), &v) || __builtin_add_overflow(v, u128(s[i] - '0'), &v);
+    }
+
+    int frac = 0;
+    bool inexact = false;
+    if (i < s.size() && s[i] == '.') {
+        for (i++; i < s.size() && s[i] >= '0' && s[i] <= '9'; i++, digits++) {
+            if (frac < scale) {
+                overflow |= __builtin_mul_overflow(v, u128(10), &v) || __builtin_add_overflow(v, u128(s[i] - '0'), &v);
+                frac++;
+            } else {
+                inexact |= s[i] != '0';
+            }
+        }
+    }
+
+    if (i != s.size() || digits == 0) {
+        throw conversion_syntax_error("fixed_decimal: invalid string");
+    }
+    if (inexact) {
+        throw inexact_error("fixed_decimal: value has more fractional digits than scale");
+    }
+    if (overflow || !checked_shift(v, scale - frac)) {
+        throw overflow_error("fixed_decimal: value is out of range");
+    }
+    return checked_signed(v, neg);
+}
+
+int128_t detail::fixed_from_decimal(const mpd_t* a, int scale) {
+    if (mpd_isspecial(a)) {
+        throw value_error("fixed_decimal: NaN or Infinity can't be converted");
+    }
+    if (mpd_iszerocoeff(a)) {
+        return 0;
+    }
+
+    bigdecimal rescaled;
+    if (a->exp < -(mpd_ssize_t) scale) {
+        uint32_t status = 0;
+        mpd_context_t ctx;
+        mpd_maxcontext(&ctx);
+        mpd_qrescale(rescaled.get(), a, -(mpd_ssize_t) scale, &ctx, &status);
+        if (status & MPD_Malloc_error) {
+            throw malloc_error("out of memory");
+        }
+        if (status & MPD_Inexact) {
+            throw inexact_error("fixed_decimal: value has more fractional digits than scale");
+        }
+        a = rescaled.getconst();
+    }
+
+    /* at most 39 digits: 3 words */
+    if (a->len > 3) {
+        throw overflow_error("fixed_decimal: value is out of range");
+    }
+    u128 v = 0;
+    for (mpd_ssize_t i = a->len; i-- > 0;) {
+        /* checked before multiplication, 3 words can wrap 128 bits */
+        if (v > (MAX_MAGNITUDE - a->data[i]) / MPD_RADIX) {
+            throw overflow_error("fixed_decimal: value is out of range");
+        }
+        v = v * MPD_RADIX + a->data[i];
+    }
+    if (a->exp + scale > 38 || !checked_shift(v, int(a->exp + scale))) {
+        throw overflow_error("fixed_decimal: value is out of range");
+    }
+    return checked_signed(v, mpd_isnegative(a));
+}
+
+void detail::fixed_to_decimal(mpd_t* result, int128_t raw, int scale) {
+    mp_limb_t p[2];
+    const mp_size_t n = set_limbs(p, magnitude(raw));
+    limbs_to_decimal(result, p, n, raw < 0, scale);
+}
+
+std::to_chars_result detail::fixed_to_chars(char* first, char* last, int128_t raw, int scale) {
+    /* digits in reverse order, 19 at a time from 64-bit chunks */
+    char digits[40];
+    size_t n = 0;
+    u128 v = magnitude(raw);
+    do {
+        uint64_t chunk = uint64_t(v % MPD_RADIX);
+        v /= MPD_RADIX;
+        for (size_t i = 0; i < MPD_RDIGITS && (chunk || v); i++) {
+            digits[n++] = char('0' + chunk % 10);
+            chunk /= 10;
+        }
+    } while (v);
+    const size_t frac = size_t(scale);
+    while (n < frac + 1) {
+        digits[n++] = '0';
+    }
+
+    const size_t size = (raw < 0) + n + (frac > 0);
+    if (size > size_t(last - first)) {
+        return {last, std::errc::value_too_large};
+    }
+    char* p = first;
+    if (raw < 0) {
+        *p++ = '-';
+    }
+    for (size_t i = n; i-- > 0;) {
+        *p++ = digits[i];
+        if (i == frac && frac > 0) {
+            *p++ = '.';
+        }
+    }
+    return {p, std::errc()};
+}
+
+} // namespace bigmath
+
+#endif // HAVE_UINT128_T
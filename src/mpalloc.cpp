@@ -29,6 +29,7 @@
 
 #if (MPD_MINOR_VERSION == 4)
 
+#include "bigmath/stats.h"
 #include "bigmath/typearith.h"
 #include "mpdecimal.h"
 
@@ -67,6 +68,7 @@ int bigmath::mpd_switch_to_dyn(mpd_t* result, mpd_ssize_t nwords, uint32_t* stat
     memcpy(result->data, p, result->alloc * (sizeof *result->data));
     result->alloc = nwords;
     mpd_set_dynamic_data(result);
+    BIGMATH_STATS_ADD(DECIMAL_SPILLS);
     return 1;
 }
 
@@ -91,6 +93,7 @@ int bigmath::mpd_switch_to_dyn_zero(mpd_t* result, mpd_ssize_t nwords, uint32_t*
 
     result->alloc = nwords;
     mpd_set_dynamic_data(result);
+    BIGMATH_STATS_ADD(DECIMAL_SPILLS);
 
     return 1;
 }
@@ -147,6 +150,7 @@ int bigmath::mpd_switch_to_dyn_cxx(mpd_t* result, mpd_ssize_t nwords) {
     result->data = data;
     result->alloc = nwords;
     mpd_set_dynamic_data(result);
+    BIGMATH_STATS_ADD(DECIMAL_SPILLS);
     return 1;
 }
 
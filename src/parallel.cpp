@@ -0,0 +1,219 @@
+/*!
+ * bigmath.
+ * parallel.cpp
+ *
+ * \date 10/17/2026
+ * \author Eduard Maximovich (edward.vstock@gmail.com)
+ * \link   https://github.com/edwardstock
+ */
+
+#include "bigmath/parallel.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace bigmath {
+
+/*****************************************************************************/
+/*                                   State                                    */
+/*****************************************************************************/
+
+namespace {
+
+/* tasks of one run() call */
+struct batch {
+    const std::function<void(size_t)>& task;
+    std::atomic<size_t> remaining;
+    std::mutex lock;
+    std::condition_variable done;
+    std::exception_ptr error;
+    size_t error_index = SIZE_MAX;
+
+    batch(const std::function<void(size_t)>& task, size_t count)
+        : task(task),
+          remaining(count) {
+    }
+
+    void execute(size_t index) {
+        try {
+            task(index);
+        } catch (...) {
+            std::lock_guard<std::mutex> guard(lock);
+            if (index < error_index) {
+                error_index = index;
+                error = std::current_exception();
+            }
+        }
+        /* under lock: run() can't return and destroy batch between decrement and notification */
+        std::lock_guard<std::mutex> guard(lock);
+        if (remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            done.notify_all();
+        }
+    }
+};
+
+struct job {
+    batch* owner;
+    size_t index;
+};
+
+/* owner takes jobs from back, thieves from front */
+struct job_queue {
+    std::mutex lock;
+    std::deque<job> jobs;
+
+    bool pop_back(job& j) {
+        std::lock_guard<std::mutex> guard(lock);
+        if (jobs.empty()) {
+            return false;
+        }
+        j = jobs.back();
+        jobs.pop_back();
+        return true;
+    }
+
+    bool pop_front(job& j) {
+        std::lock_guard<std::mutex> guard(lock);
+        if (jobs.empty()) {
+            return false;
+        }
+        j = jobs.front();
+        jobs.pop_front();
+        return true;
+    }
+};
+
+} // namespace
+
+struct thread_pool::state {
+    /* one queue per worker and one for threads outside of the pool */
+    std::vector<std::unique_ptr<job_queue>> queues;
+    std::vector<std::thread> threads;
+    std::atomic<size_t> pending{0};
+    std::atomic<size_t> next_queue{0};
+    std::mutex lock;
+    std::condition_variable wakeup;
+    bool stop = false;
+
+    /* own queue first, then steal starting from next one */
+    bool take(size_t self, job& j) {
+        if (queues[self]->pop_back(j)) {
+            pending.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+        for (size_t i = 1; i < queues.size(); i++) {
+            if (queues[(self + i) % queues.size()]->pop_front(j)) {
+                pending.fetch_sub(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void work(size_t self) {
+        job j{};
+        for (;;) {
+            if (take(self, j)) {
+                j.owner->execute(j.index);
+                continue;
+            }
+            std::unique_lock<std::mutex> guard(lock);
+            wakeup.wait(guard, [this] { return stop || pending.load(std::memory_order_relaxed) != 0; });
+            if (stop) {
+                return;
+            }
+        }
+    }
+};
+
+/* index of worker queue of the current thread in its pool, or last queue for foreign threads */
+static thread_local const thread_pool* current_pool = nullptr;
+static thread_local size_t current_queue = 0;
+
+/*****************************************************************************/
+/*                                 thread_pool                                */
+/*****************************************************************************/
+
+thread_pool::thread_pool(size_t threads)
+    : m_state(new state) {
+    if (threads == 0) {
+        const size_t hw = std::thread::hardware_concurrency();
+        threads = hw > 1 ? hw - 1 : 0;
+    }
+    for (size_t i = 0; i <= threads; i++) {
+        m_state->queues.emplace_back(new job_queue);
+    }
+    for (size_t i = 0; i < threads; i++) {
+        m_state->threads.emplace_back([this, i] {
+            current_pool = this;
+            current_queue = i;
+            m_state->work(i);
+        });
+    }
+}
+
+thread_pool::~thread_pool() {
+    {
+        std::lock_guard<std::mutex> guard(m_state->lock);
+        m_state->stop = true;
+    }
+    m_state->wakeup.notify_all();
+    for (std::thread& t : m_state->threads) {
+        t.join();
+    }
+    delete m_state;
+}
+
+size_t thread_pool::size() const {
+    return m_state->threads.size();
+}
+
+void thread_pool::run(size_t count, const std::function<void(size_t)>& task) {
+    if (count == 0) {
+        return;
+    }
+    batch b(task, count);
+    const size_t self = current_pool == this ? current_queue : m_state->queues.size() - 1;
+
+    /* spread jobs over all queues, in reverse so owners start from lowest indices */
+    const size_t queues = m_state->queues.size();
+    const size_t first = m_state->next_queue.fetch_add(1, std::memory_order_relaxed);
+    for (size_t i = count; i > 0; i--) {
+        job_queue& q = *m_state->queues[(first + i - 1) % queues];
+        std::lock_guard<std::mutex> guard(q.lock);
+        q.jobs.push_back(job{&b, i - 1});
+    }
+    {
+        std::lock_guard<std::mutex> guard(m_state->lock);
+        m_state->pending.fetch_add(count, std::memory_order_relaxed);
+    }
+    m_state->wakeup.notify_all();
+
+    /* help until own batch is done: jobs of other batches are taken too, as they may be nested ones */
+    job j{};
+    while (b.remaining.load(std::memory_order_acquire) != 0) {
+        if (m_state->take(self, j)) {
+            j.owner->execute(j.index);
+            continue;
+        }
+        std::unique_lock<std::mutex> guard(b.lock);
+        b.done.wait(guard, [&b] { return b.remaining.load(std::memory_order_acquire) == 0; });
+    }
+
+    std::lock_guard<std::mutex> guard(b.lock);
+    if (b.error) {
+        std::rethrow_exception(b.error);
+    }
+}
+
+thread_pool& thread_pool::shared() {
+    static thread_pool pool;
+    return pool;
+}
+
+} // namespace bigmath
@@ -0,0 +1,310 @@
+/*!
+ * bigmath.
+ * stats.cpp
+ *
+ * \date 10/17/2026
+ * \author Eduard Maximovich (edward.vstock@gmail.com)
+ * \link   https://github.com/edwardstock
+ */
+
+#include "bigmath/stats.h"
+
+#ifdef BIGMATHPP_STATS
+
+#include "bigmath/allocator.h"
+#include "mpdecimal.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <mutex>
+
+using bigmath::stats::detail::COUNTERS_SIZE;
+using bigmath::stats::detail::op_fn;
+
+/*****************************************************************************/
+/*                              Thread counters                              */
+/*****************************************************************************/
+
+/* open addressing table of called functions, full table counts to "other" */
+static constexpr size_t OP_SLOTS = 64;
+
+/* Counters are written only by owning thread, atomics make concurrent snapshot() well-defined.
+ * Relaxed load and store compile to plain moves, without locked instructions. */
+struct block {
+    std::atomic<uint64_t> values[COUNTERS_SIZE] = {};
+    std::atomic<op_fn> op_keys[OP_SLOTS] = {};
+    std::atomic<uint64_t> op_calls[OP_SLOTS] = {};
+    std::atomic<uint64_t> op_other{0};
+};
+
+static inline void bump(std::atomic<uint64_t>& v, uint64_t n) {
+    v.store(v.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+}
+
+struct totals {
+    uint64_t values[COUNTERS_SIZE] = {};
+    std::vector<std::pair<op_fn, uint64_t>> ops;
+    uint64_t op_other = 0;
+
+    void add(const block& b) {
+        for (size_t i = 0; i < COUNTERS_SIZE; i++) {
+            values[i] += b.values[i].load(std::memory_order_relaxed);
+        }
+        for (size_t i = 0; i < OP_SLOTS; i++) {
+            const op_fn fn = b.op_keys[i].load(std::memory_order_acquire);
+            if (fn != nullptr) {
+                add_op(fn, b.op_calls[i].load(std::memory_order_relaxed));
+            }
+        }
+        op_other += b.op_other.load(std::memory_order_relaxed);
+    }
+
+    void add_op(op_fn fn, uint64_t calls) {
+        for (auto& op : ops) {
+            if (op.first == fn) {
+                op.second += calls;
+                return;
+            }
+        }
+        ops.emplace_back(fn, calls);
+    }
+};
+
+/* live blocks of running threads, totals of finished threads and reset() baseline */
+struct registry {
+    std::mutex lock;
+    std::vector<block*> live;
+    totals retired;
+    bigmath::stats::counters baseline;
+};
+
+/* never destroyed: threads may exit after static destructors ran */
+static registry& get_registry() {
+    static registry* r = new registry;
+    return *r;
+}
+
+/* memory can be freed by destructors of other thread_local objects after counters are gone */
+static thread_local bool local_destroyed = false;
+
+struct local_block {
+    block b;
+
+    local_block() {
+        registry& r = get_registry();
+        std::lock_guard<std::mutex> lock(r.lock);
+        r.live.push_back(&b);
+    }
+
+    ~local_block() {
+        registry& r = get_registry();
+        std::lock_guard<std::mutex> lock(r.lock);
+        r.retired.add(b);
+        r.live.erase(std::find(r.live.begin(), r.live.end(), &b));
+        local_destroyed = true;
+    }
+};
+
+static block& local() {
+    static thread_local local_block lb;
+    return lb.b;
+}
+
+void bigmath::stats::detail::add(counter c, uint64_t n) noexcept {
+    if (local_destroyed) {
+        return;
+    }
+    bump(local().values[c], n);
+}
+
+void bigmath::stats::detail::count_op(op_fn fn) noexcept {
+    if (local_destroyed) {
+        return;
+    }
+    block& b = local();
+    size_t i = (reinterpret_cast<uintptr_t>(fn) >> 4) % OP_SLOTS;
+    for (size_t probe = 0; probe < OP_SLOTS; probe++, i = (i + 1) % OP_SLOTS) {
+        const op_fn key = b.op_keys[i].load(std::memory_order_relaxed);
+        if (key == fn) {
+            bump(b.op_calls[i], 1);
+            return;
+        }
+        if (key == nullptr) {
+            /* count is published before key, snapshot() never sees key without its first call */
+            b.op_calls[i].store(1, std::memory_order_relaxed);
+            b.op_keys[i].store(fn, std::memory_order_release);
+            return;
+        }
+    }
+    bump(b.op_other, 1);
+}
+
+/*****************************************************************************/
+/*                                  Snapshot                                 */
+/*****************************************************************************/
+
+#define OP_NAME(fn) \
+    { reinterpret_cast<op_fn>(mpd_q##fn), #fn }
+
+struct op_name {
+    op_fn fn;
+    const char* name;
+};
+
+static const op_name op_names[] = {
+    OP_NAME(abs),
+    OP_NAME(add),
+    OP_NAME(ceil),
+    OP_NAME(compare),
+    OP_NAME(compare_signal),
+    OP_NAME(div),
+    OP_NAME(divint),
+    OP_NAME(divmod),
+    OP_NAME(exp),
+    OP_NAME(finalize),
+    OP_NAME(floor),
+    OP_NAME(fma),
+    OP_NAME(invert),
+    OP_NAME(invroot),
+    OP_NAME(ln),
+    OP_NAME(log10),
+    OP_NAME(logb),
+    OP_NAME(max),
+    OP_NAME(max_mag),
+    OP_NAME(min),
+    OP_NAME(min_mag),
+    OP_NAME(minus),
+    OP_NAME(mul),
+    OP_NAME(next_minus),
+    OP_NAME(next_plus),
+    OP_NAME(next_toward),
+    OP_NAME(plus),
+    OP_NAME(pow),
+    OP_NAME(powmod),
+    OP_NAME(quantize),
+    OP_NAME(reduce),
+    OP_NAME(rem),
+    OP_NAME(rem_near),
+    OP_NAME(rescale),
+    OP_NAME(rotate),
+    OP_NAME(round_to_int),
+    OP_NAME(round_to_intx),
+    OP_NAME(scaleb),
+    OP_NAME(shift),
+    OP_NAME(shiftl),
+    OP_NAME(shiftn),
+    OP_NAME(shiftr),
+    OP_NAME(sqrt),
+    OP_NAME(sub),
+    OP_NAME(trunc),
+    /* "and" and "or" are operator tokens, can't be pasted */
+    {reinterpret_cast<op_fn>(mpd_qand), "and"},
+    {reinterpret_cast<op_fn>(mpd_qor), "or"},
+    {reinterpret_cast<op_fn>(mpd_qxor), "xor"},
+};
+
+static const char* name_of(op_fn fn) {
+    for (const op_name& n : op_names) {
+        if (n.fn == fn) {
+            return n.name;
+        }
+    }
+    return "other";
+}
+
+static void add_named(std::vector<bigmath::stats::op_count>& ops, const char* name, uint64_t calls) {
+    for (auto& op : ops) {
+        if (std::strcmp(op.name, name) == 0) {
+            op.calls += calls;
+            return;
+        }
+    }
+    ops.push_back({name, calls});
+}
+
+/* counters of all threads, without baseline */
+static bigmath::stats::counters collect(registry& r) {
+    totals t = r.retired;
+    for (const block* b : r.live) {
+        t.add(*b);
+    }
+
+    bigmath::stats::counters c;
+    uint64_t* const fields[COUNTERS_SIZE] = {
+        &c.decimal_allocs,
+        &c.decimal_reallocs,
+        &c.decimal_frees,
+        &c.decimal_bytes,
+        &c.decimal_spills,
+        &c.bigint_allocs,
+        &c.bigint_reallocs,
+        &c.bigint_frees,
+        &c.bigint_bytes,
+        &c.raises,
+        &c.traps,
+    };
+    for (size_t i = 0; i < COUNTERS_SIZE; i++) {
+        *fields[i] = t.values[i];
+    }
+
+    for (const auto& op : t.ops) {
+        add_named(c.ops, name_of(op.first), op.second);
+    }
+    if (t.op_other) {
+        add_named(c.ops, "other", t.op_other);
+    }
+    return c;
+}
+
+bigmath::stats::counters bigmath::stats::snapshot() {
+    registry& r = get_registry();
+    std::lock_guard<std::mutex> lock(r.lock);
+    counters c = collect(r);
+    const counters& base = r.baseline;
+
+    c.decimal_allocs -= base.decimal_allocs;
+    c.decimal_reallocs -= base.decimal_reallocs;
+    c.decimal_frees -= base.decimal_frees;
+    c.decimal_bytes -= base.decimal_bytes;
+    c.decimal_spills -= base.decimal_spills;
+    c.bigint_allocs -= base.bigint_allocs;
+    c.bigint_reallocs -= base.bigint_reallocs;
+    c.bigint_frees -= base.bigint_frees;
+    c.bigint_bytes -= base.bigint_bytes;
+    c.raises -= base.raises;
+    c.traps -= base.traps;
+
+    std::vector<op_count> ops;
+    for (const op_count& op : c.ops) {
+        const uint64_t calls = op.calls - base.calls(op.name);
+        if (calls) {
+            ops.push_back({op.name, calls});
+        }
+    }
+    std::sort(ops.begin(), ops.end(), [](const op_count& a, const op_count& b) {
+        return std::strcmp(a.name, b.name) < 0;
+    });
+    c.ops = std::move(ops);
+    return c;
+}
+
+void bigmath::stats::reset() {
+    registry& r = get_registry();
+    std::lock_guard<std::mutex> lock(r.lock);
+    r.baseline = collect(r);
+}
+
+/* counting memory functions must be installed before the first value allocates */
+static const bool hooks_installed = (bigmath::set_allocator(bigmath::get_allocator()), true);
+
+#else
+
+bigmath::stats::counters bigmath::stats::snapshot() {
+    return counters();
+}
+
+void bigmath::stats::reset() {
+}
+
+#endif // BIGMATHPP_STATS
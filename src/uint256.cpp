@@ -0,0 +1,217 @@
+/*!
+ * bigmath.
+ * uint256.cpp
+ *
+ * \date 10/17/2026
+ * \author Eduard Maximovich (edward.vstock@gmail.com)
+ * \link   https://github.com/edwardstock
+ */
+
+#include "bigmath/uint256.h"
+
+#ifdef HAVE_UINT128_T
+
+#include "bigmath/bigint_expr.h"
+
+#include <algorithm>
+#include <gmp.h>
+
+namespace bigmath {
+
+static_assert(sizeof(mp_limb_t) == 8 && GMP_NAIL_BITS == 0, "int256 expects 64-bit GMP limbs");
+static_assert(MPD_RADIX == 10000000000000000000ULL, "int256 expects 64-bit mpdecimal words");
+
+__extension__ typedef unsigned __int128 u128;
+
+constexpr size_t LIMBS = 4;
+
+static size_t significant(const uint64_t* a) {
+    size_t n = LIMBS;
+    while (n > 0 && a[n - 1] == 0) {
+        n--;
+    }
+    return n;
+}
+
+static void negate(uint64_t* a) {
+    uint64_t borrow = 0;
+    for (size_t i = 0; i < LIMBS; i++) {
+        const uint64_t v = a[i];
+        a[i] = 0 - v - borrow;
+        borrow |= v != 0;
+    }
+}
+
+/* a = a / d, returns remainder */
+static uint64_t div_word(uint64_t* a, uint64_t d) {
+    uint64_t r = 0;
+    for (size_t i = significant(a); i-- > 0;) {
+        const u128 hl = u128(r) << 64 | a[i];
+        a[i] = uint64_t(hl / d);
+        r = uint64_t(hl % d);
+    }
+    return r;
+}
+
+/* a = a * m + add, returns false on overflow */
+static bool mul_add_word(uint64_t* a, uint64_t m, uint64_t add) {
+    uint64_t carry = add;
+    for (size_t i = 0; i < LIMBS; i++) {
+        uint64_t hi, lo;
+        detail::mul_words(&hi, &lo, a[i], m);
+        lo += carry;
+        hi += lo < carry;
+        a[i] = lo;
+        carry = hi;
+    }
+    return carry == 0;
+}
+
+/* magnitude with sign to two's complement, false if it's out of range */
+static bool apply_sign(uint64_t* limbs, bool neg, bool is_signed) {
+    const bool zero = significant(limbs) == 0;
+    if (!is_signed) {
+        return !neg || zero;
+    }
+    const bool top = (limbs[LIMBS - 1] >> 63) != 0;
+    if (neg && !zero) {
+        // 2^255 is the only magnitude with top bit that fits
+        if (top && (limbs[LIMBS - 1] << 1 | limbs[2] | limbs[1] | limbs[0]) != 0) {
+            return false;
+        }
+        negate(limbs);
+        return true;
+    }
+    return !top;
+}
+
+void detail::int256_divmod(uint64_t* q, uint64_t* r, const uint64_t* a, const uint64_t* b) {
+    const size_t an = significant(a), bn = significant(b);
+    std::fill(q, q + LIMBS, uint64_t(0));
+    std::fill(r, r + LIMBS, uint64_t(0));
+    if (an < bn) {
+        std::copy(a, a + LIMBS, r);
+        return;
+    }
+    if (bn == 1) {
+        r[0] = mpn_divrem_1(reinterpret_cast<mp_limb_t*>(q), 0, reinterpret_cast<const mp_limb_t*>(a), mp_size_t(an), b[0]);
+        return;
+    }
+    mpn_tdiv_qr(reinterpret_cast<mp_limb_t*>(q), reinterpret_cast<mp_limb_t*>(r), 0,
+                reinterpret_cast<const mp_limb_t*>(a), mp_size_t(an),
+                reinterpret_cast<const mp_limb_t*>(b), mp_size_t(bn));
+}
+
+static int hex_digit(char c) {
+    if (c >= '0' && c <= '9') {
+        return c - '0';
+    }
+    if (c >= 'a' && c <= 'f') {
+        return c - 'a' + 10;
+    }
+    if (c >= 'A' && c <= 'F') {
+        return c - 'A' + 10;
+    }
+    return -1;
+}
+
+void detail::int256_parse(uint64_t* limbs, std::string_view s, bool is_signed) {
+    size_t i = 0;
+    bool neg = false;
+    if (i < s.size() && (s[i] == '+' || s[i] == '-')) {
+        neg = s[i] == '-';
+        i++;
+    }
+    std::fill(limbs, limbs + LIMBS, uint64_t(0));
+
+    bool overflow = false;
+    size_t digits = 0;
+    if (s.size() - i > 2 && s[i] == '0' && (s[i + 1] == 'x' || s[i + 1] == 'X')) {
+        for (i += 2; i < s.size() && hex_digit(s[i]) >= 0; i++, digits++) {
+            overflow |= (limbs[LIMBS - 1] >> 60) != 0;
+            for (size_t k = LIMBS; k-- > 1;) {
+                limbs[k] = limbs[k] << 4 | limbs[k - 1] >> 60;
+            }
+            limbs[0] = limbs[0] << 4 | uint64_t(hex_digit(s[i]));
+        }
+    } else {
+        // 19 digits at a time: one multiply-add of 4 limbs per chunk
+        while (i < s.size() && s[i] >= '0' && s[i] <= '9') {
+            uint64_t chunk = 0, scale = 1;
+            for (size_t k = 0; k < MPD_RDIGITS && i < s.size() && s[i] >= '0' && s[i] <= '9'; k++, i++, digits++) {
+                chunk = chunk * 10 + uint64_t(s[i] - '0');
+                scale *= 10;
+            }
+            overflow |= !mul_add_word(limbs, scale, chunk);
+        }
+    }
+
+    if (i != s.size() || digits == 0) {
+        throw conversion_syntax_error("int256: invalid string");
+    }
+    if (overflow || !apply_sign(limbs, neg, is_signed)) {
+        throw overflow_error("int256: value is out of range");
+    }
+}
+
+std::to_chars_result detail::int256_to_chars(char* first, char* last, const uint64_t* limbs, bool is_signed) {
+    const bool neg = is_signed && (limbs[LIMBS - 1] >> 63) != 0;
+    uint64_t v[LIMBS];
+    std::copy(limbs, limbs + LIMBS, v);
+    if (neg) {
+        negate(v);
+    }
+
+    /* digits in reverse order, 19 at a time */
+    char digits[80];
+    size_t n = 0;
+    do {
+        uint64_t chunk = div_word(v, MPD_RADIX);
+        const bool more = significant(v) != 0;
+        for (size_t i = 0; i < MPD_RDIGITS && (chunk || more || n == 0); i++) {
+            digits[n++] = char('0' + chunk % 10);
+            chunk /= 10;
+        }
+    } while (significant(v) != 0);
+
+    if (neg + n > size_t(last - first)) {
+        return {last, std::errc::value_too_large};
+    }
+    char* p = first;
+    if (neg) {
+        *p++ = '-';
+    }
+    for (size_t i = n; i-- > 0;) {
+        *p++ = digits[i];
+    }
+    return {p, std::errc()};
+}
+
+void detail::int256_to_bigint(bigint& result, const uint64_t* limbs, bool is_signed) {
+    const bool neg = is_signed && (limbs[LIMBS - 1] >> 63) != 0;
+    uint64_t v[LIMBS];
+    std::copy(limbs, limbs + LIMBS, v);
+    if (neg) {
+        negate(v);
+    }
+    const size_t n = significant(v);
+    bigint_access::ensure(result, n);
+    mpz_ptr z = bigint_access::val(result);
+    std::copy(v, v + n, z->_mp_d);
+    z->_mp_size = neg ? -int(n) : int(n);
+}
+
+bool detail::int256_from_bigint(uint64_t* limbs, const bigint& v, bool is_signed) {
+    mpz_srcptr z = bigint_access::val(v);
+    const size_t n = mpz_size(z);
+    if (n > LIMBS) {
+        return false;
+    }
+    std::fill(limbs, limbs + LIMBS, uint64_t(0));
+    std::copy(z->_mp_d, z->_mp_d + n, limbs);
+    return apply_sign(limbs, mpz_sgn(z) < 0, is_signed);
+}
+
+} // namespace bigmath
+
+#endif // HAVE_UINT128_T
@@ -0,0 +1,198 @@
+/*!
+ * bigmath.
+ * allocator_test.cpp
+ *
+ * \date 10/17/2026
+ * \author Eduard Maximovich (edward.vstock@gmail.com)
+ * \link   https://github.com/edwardstock
+ */
+
+#include <bigmath/allocator.h>
+#include <bigmath/bigdecimal.h>
+#include <bigmath/bigint.h>
+#include <gtest/gtest.h>
+#include <cstring>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace bigmath;
+
+// values must not outlive allocator they were allocated with
+class PoolAllocator : public ::testing::Test {
+protected:
+    void SetUp() override {
+        set_allocator(pool_allocator());
+        reset_pool_stats();
+    }
+    void TearDown() override {
+        set_allocator(system_allocator());
+    }
+};
+
+static std::string compute(int seed) {
+    bigdecimal sum("0");
+    bigint prod("1");
+    for (int i = 1; i < 200; i++) {
+        const std::string digits = std::to_string(seed * 1000003 + i) + "123456789012345678901234567890";
+        sum += bigdecimal(digits + ".000000000000000001") * bigdecimal("1.5");
+        prod *= bigint(digits);
+        prod /= bigint(std::to_string(i * 7 + 1));
+    }
+    return sum.to_sci() + " " + prod.str();
+}
+
+TEST(Allocator, DefaultIsSystem) {
+    const allocator a = get_allocator();
+    ASSERT_EQ(system_allocator().alloc, a.alloc);
+    ASSERT_EQ(system_allocator().realloc, a.realloc);
+    ASSERT_EQ(system_allocator().free, a.free);
+
+    ASSERT_THROW(set_allocator(allocator{nullptr, nullptr, nullptr}), bigmath::value_error);
+}
+
+TEST_F(PoolAllocator, SameResults) {
+    set_allocator(system_allocator());
+    const std::string expected = compute(1);
+
+    set_allocator(pool_allocator());
+    ASSERT_EQ(expected, compute(1));
+    ASSERT_EQ(expected, compute(1));
+
+    const pool_stats stats = get_pool_stats();
+    ASSERT_GT(stats.hits, stats.misses);
+    ASSERT_GT(stats.cached, 0u);
+}
+
+TEST_F(PoolAllocator, Realloc) {
+    allocator a = pool_allocator();
+    auto* p = static_cast<char*>(a.alloc(10));
+    std::memcpy(p, "123456789", 10);
+
+    // same size class
+    ASSERT_EQ(p, a.realloc(p, 16));
+
+    // larger class and large block keep data
+    for (size_t size : {size_t(100), size_t(4096), size_t(5000), size_t(100000), size_t(64), size_t(8)}) {
+        p = static_cast<char*>(a.realloc(p, size));
+        ASSERT_NE(nullptr, p);
+        ASSERT_STREQ("1234567", std::string(p, 7).c_str()) << size;
+    }
+    a.free(p);
+    a.free(nullptr);
+
+    p = static_cast<char*>(a.realloc(nullptr, 32));
+    ASSERT_NE(nullptr, p);
+    a.free(p);
+}
+
+TEST_F(PoolAllocator, Threads) {
+    std::vector<std::string> results(4);
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < results.size(); i++) {
+        threads.emplace_back([&results, i] {
+            results[i] = compute(int(i));
+            const pool_stats stats = get_pool_stats();
+            ASSERT_GT(stats.hits, 0u);
+        });
+    }
+    for (std::thread& t : threads) {
+        t.join();
+    }
+
+    for (size_t i = 0; i < results.size(); i++) {
+        ASSERT_EQ(compute(int(i)), results[i]);
+    }
+
+    // allocated and freed by different threads
+    std::vector<bigint> values;
+    std::thread producer([&values] {
+        for (int i = 0; i < 100; i++) {
+            values.emplace_back("123456789012345678901234567890123456789012345678901234567890" + std::to_string(i));
+        }
+    });
+    producer.join();
+    ASSERT_EQ(bigint("1234567890123456789012345678901234567890123456789012345678907"), values[7]);
+    values.clear();
+}
+
+TEST_F(PoolAllocator, ArenaScope) {
+    const std::string expected = compute(3);
+
+    bigdecimal outer("0.1");
+    bigint outer_int;
+    {
+        arena_scope arena(arena_mode::checked);
+        ASSERT_EQ(expected, compute(3));
+        ASSERT_GT(arena.allocated_bytes(), 0u);
+
+        bigdecimal a("123456789012345678901234567890123456789012345678901234567890.123456789012345678901234567890123456789012345678901234567890");
+        bigint b("123456789012345678901234567890123456789012345678901234567890");
+        b *= b;
+        ASSERT_EQ(2u, arena.live_blocks());
+
+        // values that outlive the arena
+        {
+            arena_bypass bypass;
+            outer = a * bigdecimal("2");
+            outer_int = b;
+        }
+        ASSERT_EQ(2u, arena.live_blocks());
+
+        // nested scope
+        {
+            arena_scope inner;
+            bigint c = b * b;
+            ASSERT_EQ(1u, inner.live_blocks());
+        }
+        ASSERT_EQ(2u, arena.live_blocks());
+    }
+    ASSERT_EQ(bigdecimal("246913578024691357802469135780246913578024691357802469135780.246913578024691357802469135780246913578024691357802469135780"), outer);
+    ASSERT_EQ(bigint("15241578753238836750495351562566681945008382873376009755225087639153757049236500533455762536198787501905199875019052100"),
+              outer_int);
+}
+
+TEST_F(PoolAllocator, ArenaEscape) {
+    std::unique_ptr<bigint> escaped;
+    arena_scope arena(arena_mode::checked);
+    escaped = std::make_unique<bigint>("123456789012345678901234567890123456789012345678901234567890");
+    ASSERT_THROW(arena.close(), bigmath::arena_escape_error);
+
+    // arena memory is kept alive in checked mode until escaped value is freed
+    ASSERT_EQ(bigint("123456789012345678901234567890123456789012345678901234567890"), *escaped);
+    escaped.reset();
+}
+
+TEST_F(PoolAllocator, ArenaGrowsOuterValue) {
+    bigint outer_int("1");
+    bigdecimal outer("1.5");
+    {
+        // outer values modified within bypass keep pool memory
+        arena_scope arena(arena_mode::checked);
+        {
+            arena_bypass bypass;
+            outer_int <<= 300;
+            outer = outer * bigdecimal(std::string(100, '7'));
+        }
+        arena.close();
+    }
+
+    bigint grown("1");
+    arena_scope arena(arena_mode::checked);
+    // heap limbs of value created outside come from arena
+    grown <<= 300;
+    ASSERT_THROW(arena.close(), bigmath::arena_escape_error);
+    ASSERT_EQ(outer_int, grown);
+}
+
+TEST_F(PoolAllocator, ArenaCloseOrder) {
+    arena_scope outer;
+    arena_scope inner;
+    ASSERT_THROW(outer.close(), bigmath::value_error);
+    inner.close();
+    outer.close();
+}
+
+TEST(Allocator, ArenaRequiresPool) {
+    ASSERT_THROW(arena_scope(), bigmath::runtime_error);
+}
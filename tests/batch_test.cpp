@@ -0,0 +1,117 @@
+/*!
+ * bigmath.
+ * batch_test.cpp
+ *
+ * \date 10/17/2026
+ * \author Eduard Maximovich (edward.vstock@gmail.com)
+ * \link   https://github.com/edwardstock
+ */
+
+#include <bigmath/batch.h>
+#include <gtest/gtest.h>
+#include <vector>
+
+using namespace bigmath;
+
+static std::vector<bigdecimal> make_values(const std::vector<const char*>& strs) {
+    std::vector<bigdecimal> values;
+    for (const char* s : strs) {
+        values.push_back(bigdecimal::exact(s, bigmath::context));
+    }
+    return values;
+}
+
+static bd_context wide_context() {
+    bd_context c;
+    c.prec(200);
+    return c;
+}
+
+TEST(Batch, Sum) {
+    const std::vector<bigdecimal> values = make_values({
+        "124.450200000000000200",
+        "-0.000000000000000001",
+        "99999999999999999999.999999999999999999",
+        "0.5",
+        "1E-30",
+    });
+
+    bd_context wide = wide_context();
+    bigdecimal exact = bigdecimal::exact("0", bigmath::context);
+    for (const bigdecimal& v : values) {
+        exact = exact.add(v, wide);
+    }
+    ASSERT_EQ(exact, batch::sum(values, wide));
+
+    // rounded once
+    bd_context ctx;
+    ctx.prec(20);
+    ASSERT_EQ(exact.plus(ctx), batch::sum(values, ctx));
+
+    // operand_digits keeps carries: result is exact for values with same exponent
+    const std::vector<bigdecimal> amounts(1000, bigdecimal("9.999999999999999999"));
+    ASSERT_EQ(bigdecimal::exact("9999.999999999999999000", bigmath::context), batch::sum(amounts));
+
+    ASSERT_EQ(bigdecimal("0"), batch::sum(std::vector<bigdecimal>()));
+}
+
+TEST(Batch, Dot) {
+    const std::vector<bigdecimal> a = make_values({"1.5", "-2.25", "1000000.000001", "3"});
+    const std::vector<bigdecimal> b = make_values({"2", "4.4", "0.333333333333", "-0.1"});
+
+    bd_context wide = wide_context();
+    bigdecimal exact = bigdecimal::exact("0", bigmath::context);
+    for (size_t i = 0; i < a.size(); i++) {
+        exact = exact.add(a[i].mul(b[i], wide), wide);
+    }
+    ASSERT_EQ(exact, batch::dot(a, b, wide));
+
+    bd_context ctx;
+    ctx.prec(8);
+    ASSERT_EQ(exact.plus(ctx), batch::dot(a, b, ctx));
+    ASSERT_EQ(exact, batch::dot(a, b));
+
+    ASSERT_THROW(batch::dot(a, std::vector<bigdecimal>(2, b[0])), bigmath::value_error);
+}
+
+TEST(Batch, ScaleAndFma) {
+    std::vector<bigdecimal> values = make_values({"1.5", "-2.25", "100.01"});
+    const std::vector<bigdecimal> expected = {values[0] * bigdecimal("0.3"),
+                                              values[1] * bigdecimal("0.3"),
+                                              values[2] * bigdecimal("0.3")};
+    batch::scale(values, bigdecimal("0.3"));
+    ASSERT_EQ(expected, values);
+
+    const std::vector<bigdecimal> a = make_values({"123456789.123456789", "2"});
+    const std::vector<bigdecimal> b = make_values({"987654321.987654321", "3"});
+    const std::vector<bigdecimal> c = make_values({"-121932631356500531.347203169112635269", "0.5"});
+    bd_context ctx;
+    ctx.prec(10);
+    std::vector<bigdecimal> out;
+    batch::fma_n(out, a, b, c, ctx);
+    ASSERT_EQ(2u, out.size());
+    ASSERT_EQ(a[0].fma(b[0], c[0], ctx), out[0]);
+    ASSERT_EQ(a[1].fma(b[1], c[1], ctx), out[1]);
+
+    // result in place of operand
+    std::vector<bigdecimal> in_place = c;
+    batch::fma_n(in_place, a, b, in_place, ctx);
+    ASSERT_EQ(out, in_place);
+}
+
+TEST(Batch, Traps) {
+    const std::vector<bigdecimal> values = make_values({"1.25", "1.25", "1.25"});
+    bd_context ctx;
+    ctx.prec(2);
+    ctx.traps(ctx.traps() | MPD_Inexact);
+    ASSERT_THROW(batch::sum(values, ctx), bigmath::inexact_error);
+
+    // status of all elements is raised once
+    bd_context quiet;
+    quiet.prec(2);
+    quiet.traps(0);
+    std::vector<bigdecimal> scaled = values;
+    batch::scale(scaled, bigdecimal("3"), quiet);
+    ASSERT_EQ(bigdecimal::exact("3.8", bigmath::context), scaled[2]);
+    ASSERT_TRUE(quiet.status() & MPD_Inexact);
+}
@@ -10,6 +10,8 @@
 #include <bigmath/bigdecimal.h>
 #include <gtest/gtest.h>
 #include <iostream>
+#include <sstream>
+#include <vector>
 
 using namespace bigmath;
 using bigdec18 = bigdecimal;
@@ -134,3 +136,206 @@ TEST(BigDecimal, CopyCtorMultiple) {
         test_copy();
     }
 }
+
+TEST(BigDecimal, PrecisionPolicy) {
+    bigdec18 a("1.0");
+    bigdec18 b("3.0");
+
+    // default: precision is max(digits) of operands
+    ASSERT_EQ(precision_policy::operand_digits, context.policy());
+    ASSERT_EQ(bigdec18("0.33"), a / b);
+
+    context.policy(precision_policy::fixed);
+    ASSERT_EQ(bigdec18("0.333333333333333333"), a / b);
+    bigdec18 c = a;
+    c /= b;
+    ASSERT_EQ(bigdec18("0.333333333333333333"), c);
+    context.policy(precision_policy::operand_digits);
+
+    ASSERT_EQ(bigdec18("0.33"), a / b);
+}
+
+TEST(BigDecimal, OperandPrecisionOfNaN) {
+    bigdec18 nan;
+    ASSERT_THROW(nan + bigdec18("1.0"), IEEE_invalid_operation);
+}
+
+TEST(BigDecimal, BigintConversion) {
+    // integers keep one digit after point, same as parsed from string
+    for (const char* s : {"0", "1", "-1", "123", "10000000000000000000", "-340282366920938463463374607431768211456",
+                          "999999999999999999999999999999999999999999999999999999999"}) {
+        const bigdecimal from_int{bigint(s)};
+        const bigdecimal from_str(s);
+        ASSERT_EQ(from_str.to_sci(), from_int.to_sci());
+        ASSERT_EQ(from_str.exponent(), from_int.exponent());
+        ASSERT_EQ(std::string(s), from_int.to_bigint().str());
+    }
+
+    ASSERT_EQ(bigint("100"), bigdecimal("100.4").to_bigint());
+    ASSERT_EQ(bigint("-101"), bigdecimal("-100.6").to_bigint());
+    ASSERT_EQ(bigint("1000000000000000000000"), bigdecimal::exact("1E+21", bigmath::context).to_bigint());
+    ASSERT_EQ(bigint("0"), bigdecimal("0.000").to_bigint());
+    ASSERT_THROW(bigdecimal::exact("NaN", bigmath::context).to_bigint(), bigmath::value_error);
+    ASSERT_THROW(bigdecimal::exact("-Infinity", bigmath::context).to_bigint(), bigmath::value_error);
+}
+
+TEST(BigDecimal, LargeBigintConversion) {
+    // crosses divide and conquer threshold and power-of-two split boundaries
+    for (size_t n : {900, 912, 1000, 2433, 4865, 10000, 20001}) {
+        std::string digits;
+        for (size_t i = 0; i < n; i++) {
+            digits += char('1' + (i * 7 + i / 13) % 9);
+        }
+        if (n % 3 == 0) {
+            digits += std::string(n / 3, '0');
+        }
+        const bigint v(digits);
+        const bigdecimal d(v);
+        ASSERT_EQ(bigdecimal(digits).to_sci(), d.to_sci());
+        ASSERT_EQ(digits, d.to_bigint().str());
+        ASSERT_EQ("-" + digits, bigdecimal("-" + digits).to_bigint().str());
+    }
+}
+
+TEST(BigDecimal, ParseFromChars) {
+    // same as mpdecimal parser, integers get ".0"
+    for (const char* s : {"0", "-0", "+15", "007", "123456789012345678901234567890", "0.0", "00.000", "-0.5", ".5", "5.",
+                          "1.5e3", "1.5E-3", "-1.25E+00000000000000000000000000000000005", "0.000000000000000000000001",
+                          "100000000000000000000000000000000000000000000000000000000000000000000000000000.123"}) {
+        const std::string str(s);
+        const std::string expected = str.find('.') == std::string::npos ? str + ".0" : str;
+        const bigdecimal parsed(s);
+        const bigdecimal reference = bigdecimal::exact(expected, bigmath::context);
+        ASSERT_EQ(reference.to_sci(), parsed.to_sci()) << s;
+        ASSERT_EQ(reference.exponent(), parsed.exponent()) << s;
+        ASSERT_EQ(reference.sign(), parsed.sign()) << s;
+    }
+
+    for (const char* s : {"", "-", ".", "1e5", "1.0e", "1.0e+", " 1.0", "1.0 ", "1,0", "1..0", "NaN", "Infinity", "0x10"}) {
+        ASSERT_THROW(bigdecimal{s}, bigmath::conversion_syntax_error) << s;
+    }
+    ASSERT_THROW(bigdecimal("1.5E+999999999999999999999999"), bigmath::IEEE_invalid_operation);
+
+    // not null-terminated range
+    const char json[] = "[12.50,-3]";
+    ASSERT_EQ(bigdecimal("12.50"), bigdecimal::from_chars(json + 1, json + 6));
+    ASSERT_EQ(bigdecimal("-3"), bigdecimal::from_chars(std::string_view(json + 7, 2)));
+    ASSERT_EQ(-1, bigdecimal::from_chars(std::string_view(json + 7, 2)).exponent());
+}
+
+static std::string mpd_format(const bigdecimal& d, const char* fmt) {
+    uint32_t status = 0;
+    char* s = mpd_qformat(d.getconst(), fmt, bigmath::context.getconst(), &status);
+    std::string res(s);
+    mpd_free(s);
+    return res;
+}
+
+TEST(BigDecimal, ToCharsFixed) {
+    std::vector<bigdecimal> values;
+    for (const char* s : {"0E+2", "0", "-0", "0.00", "-0.0", "1E+3", "-1.5E+3", "12.345", "12.355", "0.00123", "-0.5",
+                          "-0.001", "0.995", "9.9999", "1E-30", "123456789012345678901234567890.123456789012345678901",
+                          "-98765432109876543210987654321098765432109876543210E-75", "NaN", "-NaN", "sNaN123", "NaN7",
+                          "Infinity", "-Infinity"}) {
+        values.push_back(bigdecimal::exact(s, bigmath::context));
+    }
+    values.emplace_back("1000000.000001");
+
+    char buf[256];
+    for (const bigdecimal& d : values) {
+        for (const char* fmt : {"f", ".0f", ".1f", ".2f", ".5f", ".40f"}) {
+            const std::string expected = mpd_format(d, fmt);
+            ASSERT_EQ(expected, d.format(fmt)) << d.to_sci() << " " << fmt;
+
+            std::string appended = "x=";
+            if (fmt[0] == 'f') {
+                const std::to_chars_result res = d.to_chars(buf, buf + sizeof(buf));
+                ASSERT_EQ(std::errc(), res.ec);
+                ASSERT_EQ(expected, std::string(buf, res.ptr)) << d.to_sci();
+                d.append_to(appended);
+            } else {
+                const int precision = std::atoi(fmt + 1);
+                const std::to_chars_result res = d.to_chars(buf, buf + sizeof(buf), precision);
+                ASSERT_EQ(std::errc(), res.ec);
+                ASSERT_EQ(expected, std::string(buf, res.ptr)) << d.to_sci() << " " << fmt;
+                d.append_to(appended, precision);
+            }
+            ASSERT_EQ("x=" + expected, appended);
+        }
+    }
+
+    // rounding mode of given context
+    bd_context down = bigmath::context;
+    down.round(ROUND_DOWN);
+    const std::to_chars_result res = bigdecimal("12.349").to_chars(buf, buf + sizeof(buf), 2, down);
+    ASSERT_EQ("12.34", std::string(buf, res.ptr));
+
+    // buffer is too small
+    const bigdecimal d("-123.45");
+    ASSERT_EQ(std::errc::value_too_large, d.to_chars(buf, buf + 6).ec);
+    ASSERT_EQ(std::errc(), d.to_chars(buf, buf + 7).ec);
+    ASSERT_EQ(std::errc::value_too_large, d.to_chars(buf, buf + 7, 3).ec);
+    ASSERT_THROW(d.to_chars(buf, buf + sizeof(buf), -1), bigmath::value_error);
+
+    std::stringstream ss;
+    ss << d << " " << bigdecimal::exact("-Infinity", bigmath::context);
+    ASSERT_EQ("-123.45 -Infinity", ss.str());
+}
+
+template<mpd_ssize_t N>
+static void check_inline_words(const std::string& a, const std::string& b, size_t digits) {
+    using dec = basic_bigdecimal<N>;
+    const dec x(a);
+    const dec y(b);
+    ASSERT_EQ(digits <= size_t(N * MPD_RDIGITS), bool(mpd_isstatic_data(x.getconst()))) << N << " " << a;
+
+    ASSERT_EQ((bigdecimal(a) + bigdecimal(b)).to_sci(), (x + y).to_sci());
+    ASSERT_EQ((bigdecimal(a) - bigdecimal(b)).to_sci(), (x - y).to_sci());
+    ASSERT_EQ((bigdecimal(a) * bigdecimal(b)).to_sci(), (x * y).to_sci());
+    ASSERT_EQ((bigdecimal(a) / bigdecimal(b)).to_sci(), (x / y).to_sci());
+    ASSERT_EQ(bigdecimal(a).to_bigint(), x.to_bigint());
+
+    // copies between static and dynamic coefficients in both directions
+    dec z("1.5");
+    z = x;
+    ASSERT_EQ(x, z);
+    z = dec("2.5");
+    ASSERT_EQ(dec("2.5"), z);
+    z = y * y;
+    dec moved(std::move(z));
+    ASSERT_EQ(y * y, moved);
+    ASSERT_EQ(bigdecimal(a), bigdecimal(x));
+    ASSERT_EQ(x.format(".5f"), bigdecimal(a).format(".5f"));
+}
+
+TEST(BigDecimal, InlineWords) {
+    static_assert(sizeof(basic_bigdecimal<2>) < sizeof(bigdecimal), "smaller inline coefficient");
+    static_assert(sizeof(bigdecimal) < sizeof(basic_bigdecimal<8>), "larger inline coefficient");
+
+    for (size_t digits : {2, 18, 38, 39, 76, 77, 152, 153, 300}) {
+        std::string a, b;
+        for (size_t i = 0; i < digits; i++) {
+            a += char('1' + (i * 7) % 9);
+            b += char('1' + (i * 5 + 3) % 9);
+        }
+        a.insert(digits / 2, ".");
+        b.insert(1, ".");
+        check_inline_words<2>(a, b, digits);
+        check_inline_words<4>(a, b, digits);
+        check_inline_words<8>(a, b, digits);
+    }
+
+    using bigdec2 = basic_bigdecimal<2>;
+    ASSERT_EQ(bigdec2("3.5"), 2 + bigdec2("1.5"));
+    ASSERT_TRUE(2 < bigdec2("2.5"));
+}
+
+TEST(BigDecimal, MoveInlineToShrunkHeap) {
+    // heap coefficient of r shrinks below inline size of y after subtraction
+    const bigdecimal big(std::string(100, '7'));
+    bigdecimal r = big;
+    r -= big;
+    bigdecimal y(std::string(70, '3'));
+    r = std::move(y);
+    ASSERT_EQ(bigdecimal(std::string(70, '3')), r);
+}
@@ -0,0 +1,167 @@
+/*!
+ * bigmath.
+ * bigdecimal_view_test.cpp
+ *
+ * \date 10/17/2026
+ * \author Eduard Maximovich (edward.vstock@gmail.com)
+ * \link   https://github.com/edwardstock
+ */
+
+#include <bigmath/bigdecimal_view.h>
+#include <gtest/gtest.h>
+#include <vector>
+
+using namespace bigmath;
+
+static const std::vector<const char*> VALUES = {
+    "0",
+    "-0",
+    "124.450200000000000200",
+    "-0.000000000000000001",
+    "99999999999999999999.999999999999999999",
+    "123456789012345678901234567890123456789012345678901234567890123456789012345678901234567890.5",
+    "1E+999999",
+    "-7E-1000000",
+    "Infinity",
+    "-Infinity",
+    "NaN",
+    "-sNaN123456789012345678901234567890",
+};
+
+TEST(BigDecimalView, RoundTrip) {
+    std::vector<bigdecimal> values;
+    std::vector<uint8_t> buffer;
+    for (const char* s : VALUES) {
+        values.push_back(bigdecimal::exact(s, bigmath::context));
+        const size_t pos = buffer.size();
+        values.back().serialize_to(buffer);
+        ASSERT_EQ(values.back().serialized_size(), buffer.size() - pos) << s;
+    }
+
+    // 18 digits after point: header, exponent and count of words in 3 bytes, padded to 8
+    ASSERT_EQ(8u + 2 * 8, values[2].serialized_size());
+
+    size_t offset = 0;
+    for (const bigdecimal& v : values) {
+        size_t consumed = 0;
+        const bigdecimal r = bigdecimal::deserialize(buffer.data() + offset, buffer.size() - offset, &consumed);
+        ASSERT_EQ(0, mpd_cmp_total(v.getconst(), r.getconst())) << v.to_sci();
+        ASSERT_EQ(v.to_sci(), r.to_sci());
+
+        const bigdecimal_view view(buffer.data() + offset, buffer.size() - offset);
+        ASSERT_EQ(consumed, view.encoded_size());
+        ASSERT_EQ(v.issigned(), view.issigned());
+        ASSERT_EQ(v.isnan(), view.isnan());
+        ASSERT_EQ(v.isinfinite(), view.isinfinite());
+        ASSERT_EQ(v.iszero(), view.iszero());
+        ASSERT_EQ(v.getconst()->exp, view.exponent());
+        ASSERT_EQ(v.getconst()->digits, view.digits());
+        ASSERT_EQ(size_t(v.getconst()->len), view.word_count());
+        if (view.word_count() > 0) {
+            ASSERT_EQ(v.getconst()->data[0], view.word(0));
+        }
+        ASSERT_EQ(v.to_sci(), view.to_bigdecimal().to_sci());
+        ASSERT_EQ(v.to_sci(), view.to_bigdecimal<2>().to_sci());
+        offset += consumed;
+    }
+    ASSERT_EQ(buffer.size(), offset);
+
+    uint8_t small[4];
+    ASSERT_THROW(values[2].serialize_to(small, sizeof(small)), bigmath::value_error);
+}
+
+TEST(BigDecimalView, Compare) {
+    const bigdecimal a("124.450200000000000200");
+    const bigdecimal b("124.4502000000000002");
+    const bigdecimal c("-124.45");
+    const bigdecimal big("123456789012345678901234567890123456789012345678901234567890123456789012345678901234567890.5");
+
+    // values at every byte offset: words are used in place or copied when misaligned
+    for (size_t shift = 0; shift < 8; shift++) {
+        std::vector<uint8_t> buffer(shift);
+        a.serialize_to(buffer);
+        const size_t pos_b = buffer.size();
+        b.serialize_to(buffer);
+        const size_t pos_c = buffer.size();
+        c.serialize_to(buffer);
+        const size_t pos_big = buffer.size();
+        big.serialize_to(buffer);
+
+        const bigdecimal_view va(buffer.data() + shift, buffer.size() - shift);
+        const bigdecimal_view vb(buffer.data() + pos_b, buffer.size() - pos_b);
+        const bigdecimal_view vc(buffer.data() + pos_c, buffer.size() - pos_c);
+        const bigdecimal_view vbig(buffer.data() + pos_big, buffer.size() - pos_big);
+        ASSERT_TRUE(va == vb);
+        ASSERT_FALSE(va != vb);
+        ASSERT_TRUE(vc < va);
+        ASSERT_TRUE(va >= vc);
+        ASSERT_TRUE(vbig > va);
+        ASSERT_EQ(0, va.compare(b));
+        ASSERT_EQ(-1, vc.compare(a));
+        ASSERT_EQ(1, vbig.compare(a));
+        ASSERT_EQ(0, vbig.compare(big));
+    }
+
+    std::vector<uint8_t> buffer;
+    bigdecimal::exact("NaN", bigmath::context).serialize_to(buffer);
+    const bigdecimal_view nan(buffer.data(), buffer.size());
+    ASSERT_FALSE(nan == nan);
+    ASSERT_TRUE(nan != nan);
+    ASSERT_THROW((void) (nan < nan), bigmath::IEEE_invalid_operation);
+}
+
+TEST(BigDecimalView, InPlaceWords) {
+    const bigdecimal a("124.450200000000000200");
+    const bigdecimal big("123456789012345678901234567890123456789012345678901234567890123456789012345678901234567890.5");
+    alignas(8) uint8_t buffer[128] = {};
+    const size_t size_a = a.serialize_to(buffer, sizeof(buffer));
+    const size_t size_big = big.serialize_to(buffer + size_a, sizeof(buffer) - size_a);
+
+    const bigdecimal_view va(buffer, size_a);
+    const bigdecimal_view vbig(buffer + size_a, size_big);
+    ASSERT_EQ(reinterpret_cast<const mpd_uint_t*>(buffer + 8), va.inplace_words());
+    ASSERT_EQ(reinterpret_cast<const mpd_uint_t*>(buffer + size_a + 8), vbig.inplace_words());
+    ASSERT_EQ(-1, va.compare(vbig));
+
+    // misaligned encoding is copied
+    alignas(8) uint8_t shifted[64] = {};
+    a.serialize_to(shifted + 1, sizeof(shifted) - 1);
+    const bigdecimal_view vs(shifted + 1, size_a);
+    ASSERT_EQ(nullptr, vs.inplace_words());
+    ASSERT_TRUE(vs == va);
+}
+
+TEST(BigDecimalView, Malformed) {
+    std::vector<uint8_t> buffer;
+    bigdecimal("124.450200000000000200").serialize_to(buffer);
+
+    // truncated at every position
+    for (size_t size = 0; size < buffer.size(); size++) {
+        ASSERT_THROW(bigdecimal_view(buffer.data(), size), bigmath::value_error) << size;
+        ASSERT_THROW(bigdecimal::deserialize(buffer.data(), size), bigmath::value_error) << size;
+    }
+
+    std::vector<uint8_t> bad = buffer;
+    bad[0] = 0x10;
+    ASSERT_THROW(bigdecimal_view(bad.data(), bad.size()), bigmath::value_error);
+
+    // coefficient word >= 10^19
+    bad = buffer;
+    for (size_t i = 8; i < 16; i++) {
+        bad[i] = 0xFF;
+    }
+    ASSERT_THROW(bigdecimal::deserialize(bad.data(), bad.size()), bigmath::value_error);
+
+    bad = buffer;
+    bad[5] = 1;
+    ASSERT_THROW(bigdecimal_view(bad.data(), bad.size()), bigmath::value_error);
+
+    // varint longer than 64 bits
+    bad = {0x00};
+    bad.insert(bad.end(), 11, 0xFF);
+    ASSERT_THROW(bigdecimal_view(bad.data(), bad.size()), bigmath::value_error);
+
+    // infinity with coefficient
+    bad = {0x02, 0x00, 0x01, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0};
+    ASSERT_THROW(bigdecimal::deserialize(bad.data(), bad.size()), bigmath::value_error);
+}
@@ -0,0 +1,99 @@
+/*!
+ * bigmath.
+ * bigint_expr_test.cpp
+ *
+ * \date 10/17/2026
+ * \author Eduard Maximovich (edward.vstock@gmail.com)
+ * \link   https://github.com/edwardstock
+ */
+
+#include <bigmath/allocator.h>
+#include <bigmath/bigint_expr.h>
+#include <cstdlib>
+#include <gtest/gtest.h>
+
+using namespace bigmath;
+
+static size_t allocations = 0;
+
+static void* counting_alloc(size_t size) {
+    allocations++;
+    return std::malloc(size);
+}
+
+static void* counting_realloc(void* ptr, size_t size) {
+    allocations++;
+    return std::realloc(ptr, size);
+}
+
+TEST(BigIntExpr, Evaluate) {
+    const bigint a("123456789012345678901234567890");
+    const bigint b("-987654321098765432109876543210");
+    const bigint c("555555555555555555555555555555555");
+    const bigint d("7");
+
+    bigint r;
+    r = lazy(a) * b + c * lazy(d);
+    ASSERT_EQ(a * b + c * d, r);
+
+    r = lazy(a) * b - c * lazy(d) - a + b;
+    ASSERT_EQ(a * b - c * d - a + b, r);
+
+    r = a - (lazy(b) - c * lazy(d));
+    ASSERT_EQ(a - (b - c * d), r);
+
+    // products of subexpressions
+    r = (lazy(a) + b) * (lazy(c) - d) * a;
+    ASSERT_EQ((a + b) * (c - d) * a, r);
+
+    const bigint constructed = lazy(a) * a + b * lazy(b);
+    ASSERT_EQ(a * a + b * b, constructed);
+    ASSERT_EQ(a * d, eval(lazy(a) * d));
+    ASSERT_EQ(a, eval(lazy(a)));
+
+    r = bigint("100");
+    r += lazy(a) * b + c * lazy(d);
+    ASSERT_EQ(bigint("100") + a * b + c * d, r);
+    r -= lazy(a) * b - lazy(c);
+    ASSERT_EQ(bigint("100") + a * b + c * d - (a * b - c), r);
+}
+
+TEST(BigIntExpr, Aliasing) {
+    const bigint b("987654321098765432109876543210");
+    bigint r("123456789012345678901234567890");
+    const bigint expected = r * b + b * r;
+    r = lazy(r) * b + b * lazy(r);
+    ASSERT_EQ(expected, r);
+
+    bigint s("12345678901234567890");
+    const bigint expected2 = s + s * b - s;
+    s += lazy(s) * b - s;
+    ASSERT_EQ(expected2, s);
+}
+
+TEST(BigIntExpr, NoTemporaries) {
+    const bigint a("123456789012345678901234567890123456789012345678901234567890");
+    const bigint b("-98765432109876543210987654321098765432109876543210");
+    const bigint c("5555555555555555555555555555555555555555555555555555555555555");
+    const bigint d("777777777777777777777777777777777777777777777777");
+
+    // first evaluation reserves limbs of destination, next ones reuse them
+    bigint r = lazy(a) * b + c * lazy(d);
+    r += lazy(a) * d - b * lazy(c);
+    set_allocator(allocator{counting_alloc, counting_realloc, std::free});
+    allocations = 0;
+    for (int i = 0; i < 10; i++) {
+        r = lazy(a) * b + c * lazy(d);
+        r += lazy(a) * d - b * lazy(c);
+    }
+    const size_t lazy_allocations = allocations;
+    allocations = 0;
+    bigint plain = a * b + c * d;
+    plain += a * d - b * c;
+    const size_t plain_allocations = allocations;
+    set_allocator(system_allocator());
+
+    ASSERT_EQ(0u, lazy_allocations);
+    ASSERT_GT(plain_allocations, 0u);
+    ASSERT_EQ(plain, r);
+}
@@ -223,6 +223,46 @@ TEST(BigInt, ImportBytes) {
     }
 }
 
+TEST(BigInt, ExportToImportFrom) {
+    const bigint v("66634859979403239086722692970");
+    ASSERT_EQ(12u, v.byte_size());
+    ASSERT_EQ(1u, bigint(0).byte_size());
+    ASSERT_EQ(2u, bigint(256).byte_size());
+
+    uint8_t out[32];
+    ASSERT_EQ(12u, v.export_to(out, sizeof(out)));
+    ASSERT_EQ("d74f1075a595f3ffcbf4b76a", bytes_to_hex(out, 12));
+    ASSERT_EQ(12u, v.export_to(out, sizeof(out), endian::little));
+    ASSERT_EQ("6ab7f4cbfff395a575104fd7", bytes_to_hex(out, 12));
+
+    ASSERT_EQ(32u, v.export_to(out, sizeof(out), endian::big, true));
+    ASSERT_EQ("0000000000000000000000000000000000000000d74f1075a595f3ffcbf4b76a", bytes_to_hex(out, 32));
+    bigint r;
+    r.import_from(out, sizeof(out));
+    ASSERT_EQ(v, r);
+
+    ASSERT_EQ(32u, v.export_to(out, sizeof(out), endian::little, true));
+    ASSERT_EQ("6ab7f4cbfff395a575104fd70000000000000000000000000000000000000000", bytes_to_hex(out, 32));
+    r.import_from(out, sizeof(out), endian::little);
+    ASSERT_EQ(v, r);
+
+    ASSERT_EQ(32u, bigint(0).export_to(out, sizeof(out), endian::big, true));
+    ASSERT_EQ(std::string(64, '0'), bytes_to_hex(out, 32));
+    ASSERT_EQ(1u, bigint(0).export_to(out, sizeof(out)));
+    r.import_from(out, 0);
+    ASSERT_EQ(bigint(0), r);
+
+    // 2^256 - 1 grows past inline limbs
+    const bigint max("115792089237316195423570985008687907853269984665640564039457584007913129639935");
+    ASSERT_EQ(32u, max.export_to(out, sizeof(out), endian::big, true));
+    ASSERT_EQ(std::string(64, 'f'), bytes_to_hex(out, 32));
+    r.import_from(out, sizeof(out), endian::little);
+    ASSERT_EQ(max, r);
+
+    ASSERT_THROW(v.export_to(out, 11), bigmath::value_error);
+    ASSERT_THROW((max + 1).export_to(out, sizeof(out), endian::big, true), bigmath::value_error);
+}
+
 TEST(BigInt, FromNumericEnum) {
     enum some : uint8_t {
         A = 0x01,
@@ -360,4 +400,221 @@ TEST(BigInt, BigModulo) {
     std::cout << val << std::endl;
     val %= bigint("10000");
     std::cout << val << std::endl;
-}
\ No newline at end of file
+}
+TEST(BigInt, MixedArithmetic) {
+    const bigint a("100");
+
+    ASSERT_EQ(bigint("107"), a + 7);
+    ASSERT_EQ(bigint("93"), a - 7);
+    ASSERT_EQ(bigint("107"), a - (-7));
+    ASSERT_EQ(bigint("-700"), a * -7);
+    ASSERT_EQ(bigint("14"), a / 7);
+    ASSERT_EQ(bigint("-14"), a / -7);
+    ASSERT_EQ(bigint("2"), a % 7);
+    ASSERT_EQ(bigint("2"), a % -7);
+    ASSERT_EQ(bigint("-2"), bigint("-100") % 7);
+
+    ASSERT_EQ(bigint("-93"), 7 - a);
+    ASSERT_EQ(bigint("107"), 7 + a);
+    ASSERT_EQ(bigint("0"), 7 / a);
+    ASSERT_EQ(bigint("7"), 7 % a);
+    ASSERT_EQ(bigint("3"), 300 / a);
+    ASSERT_EQ(bigint("-3"), -300 / a);
+    ASSERT_EQ(bigint("-50"), -350 % a);
+    ASSERT_EQ(bigint("-3"), 300 / bigint("-100"));
+
+    bigint v("18446744073709551615");
+    v += uint64_t(1);
+    ASSERT_EQ(bigint("18446744073709551616"), v);
+    v -= INT64_MIN;
+    ASSERT_EQ(bigint("27670116110564327424"), v);
+    v *= int64_t(-2);
+    ASSERT_EQ(bigint("-55340232221128654848"), v);
+    v /= 4;
+    ASSERT_EQ(bigint("-13835058055282163712"), v);
+    v %= 1000;
+    ASSERT_EQ(bigint("-712"), v);
+}
+
+TEST(BigInt, MixedComparing) {
+    const bigint ten("10");
+    const bigint neg("-10");
+
+    ASSERT_TRUE(ten > 0);
+    ASSERT_TRUE(ten <= 10);
+    ASSERT_FALSE(ten <= 9);
+    ASSERT_TRUE(ten == 10u);
+    ASSERT_TRUE(neg < 0);
+    ASSERT_TRUE(neg == -10);
+    ASSERT_TRUE(neg > INT64_MIN);
+    ASSERT_TRUE(neg < -9);
+    ASSERT_FALSE(neg < -10);
+    ASSERT_TRUE(-11 < neg);
+    ASSERT_TRUE(UINT64_MAX > ten);
+    ASSERT_TRUE(bigint("-9223372036854775808") == INT64_MIN);
+    ASSERT_TRUE(bigint("-9223372036854775809") < INT64_MIN);
+}
+
+TEST(BigInt, BoolOfLargeValue) {
+    // low limb is zero, but value is not
+    bigint v("18446744073709551616");
+    ASSERT_TRUE((bool) v);
+}
+
+TEST(BigInt, InlineStorageGrowth) {
+    // 2^128 - 1 is the largest inline value
+    bigint v("340282366920938463463374607431768211455");
+    bigint small = v;
+    v += 1;
+    ASSERT_EQ(bigint("340282366920938463463374607431768211456"), v);
+    ASSERT_EQ(bigint("340282366920938463463374607431768211455"), small);
+
+    v *= v;
+    ASSERT_EQ(bigint("115792089237316195423570985008687907853269984665640564039457584007913129639936"), v);
+    v = v / small;
+    ASSERT_EQ(bigint("340282366920938463463374607431768211457"), v);
+    v %= bigint("1000");
+    ASSERT_EQ(bigint("457"), v);
+
+    bigint big = bigint("1") << 300;
+    bigint moved(std::move(big));
+    ASSERT_EQ(bigint("1") << 300, moved);
+    big = bigint("7");
+    ASSERT_EQ(bigint("7"), big);
+    big = std::move(moved);
+    ASSERT_EQ(bigint("2037035976334486086268445688409378161051468393665936250636140449354381299763336706183397376"), big);
+    moved = big;
+    moved = std::move(small);
+    ASSERT_EQ(bigint("340282366920938463463374607431768211455"), moved);
+    ASSERT_EQ(bigint("1"), big >> 300);
+
+    std::vector<uint8_t> bytes(40, 0);
+    bytes[39] = 1;
+    bigint imported(bytes);
+    ASSERT_EQ(bigint("1"), imported);
+
+    ASSERT_EQ(bigint("-18446744073709551616"), bigint("-0018446744073709551616"));
+    ASSERT_EQ(bigint("0"), bigint("-0"));
+    ASSERT_EQ(bigint("255"), bigint("ff", 16));
+    ASSERT_EQ(std::string("ff"), bigint("ff", 16).str());
+}
+
+TEST(BigInt, InlineStorageMatchesMpz) {
+    // values around inline capacity border, checked against plain mpz_class
+    gmp_randclass rnd(gmp_randinit_default);
+    rnd.seed(42);
+    for (int i = 0; i < 2000; i++) {
+        mpz_class x = rnd.get_z_bits(1 + i % 200);
+        mpz_class y = rnd.get_z_bits(1 + (i * 7) % 150) + 1;
+        if (i & 1) {
+            x = -x;
+        }
+        if (i & 2) {
+            y = -y;
+        }
+        const bigint a(x.get_str());
+        const bigint b(y.get_str());
+
+        ASSERT_EQ(mpz_class(x + y).get_str(), (a + b).str());
+        ASSERT_EQ(mpz_class(x - y).get_str(), (a - b).str());
+        ASSERT_EQ(mpz_class(x * y).get_str(), (a * b).str());
+        ASSERT_EQ(mpz_class(x / y).get_str(), (a / b).str());
+        ASSERT_EQ(mpz_class(x % y).get_str(), (a % b).str());
+        ASSERT_EQ(mpz_class(x | y).get_str(), (bigint(a) | b).str());
+        ASSERT_EQ(mpz_class(x & y).get_str(), (bigint(a) & b).str());
+
+        bigint c = a;
+        c *= b;
+        c += a;
+        c -= b;
+        c /= b;
+        ASSERT_EQ(mpz_class((x * y + x - y) / y).get_str(), c.str());
+    }
+}
+
+TEST(BigInt, ToChars) {
+    char buf[64];
+    for (const char* s : {"0", "-1", "18446744073709551615", "-340282366920938463463374607431768211456",
+                          "123456789012345678901234567890123456789012345678901234567890"}) {
+        const bigint v(s);
+        const std::string expected(s);
+
+        const std::to_chars_result res = v.to_chars(buf, buf + sizeof(buf));
+        ASSERT_EQ(std::errc(), res.ec);
+        ASSERT_EQ(expected, std::string(buf, res.ptr));
+
+        // exact size is enough even if mpz_sizeinbase overestimates
+        ASSERT_EQ(std::errc(), v.to_chars(buf, buf + expected.size()).ec);
+        ASSERT_EQ(std::errc::value_too_large, v.to_chars(buf, buf + expected.size() - 1).ec);
+
+        std::string appended = "v=";
+        v.append_to(appended);
+        ASSERT_EQ("v=" + expected, appended);
+    }
+
+    const bigint hex("ff", 16);
+    const std::to_chars_result res = hex.to_chars(buf, buf + sizeof(buf));
+    ASSERT_EQ("ff", std::string(buf, res.ptr));
+}
+
+TEST(BigInt, OutParameters) {
+    gmp_randclass rnd(gmp_randinit_default);
+    rnd.seed(7);
+    bigint r, q, s;
+    for (int i = 0; i < 1000; i++) {
+        mpz_class x = rnd.get_z_bits(1 + i % 300);
+        mpz_class y = rnd.get_z_bits(1 + (i * 7) % 200) + 1;
+        if (i & 1) {
+            x = -x;
+        }
+        if (i & 2) {
+            y = -y;
+        }
+        const bigint a(x.get_str());
+        const bigint b(y.get_str());
+
+        bigint::add(r, a, b);
+        ASSERT_EQ(mpz_class(x + y).get_str(), r.str());
+        bigint::sub(r, a, b);
+        ASSERT_EQ(mpz_class(x - y).get_str(), r.str());
+        bigint::mul(r, a, b);
+        ASSERT_EQ(mpz_class(x * y).get_str(), r.str());
+        bigint::addmul(r, a, a);
+        ASSERT_EQ(mpz_class(x * y + x * x).get_str(), r.str());
+        bigint::submul(r, b, b);
+        ASSERT_EQ(mpz_class(x * y + x * x - y * y).get_str(), r.str());
+
+        bigint::tdiv_qr(q, r, a, b);
+        ASSERT_EQ(mpz_class(x / y).get_str(), q.str());
+        ASSERT_EQ(mpz_class(x % y).get_str(), r.str());
+
+        const mpz_class nx = abs(x);
+        const bigint n(nx.get_str());
+        bigint::sqrt_rem(s, r, n);
+        const mpz_class sx = sqrt(nx);
+        ASSERT_EQ(sx.get_str(), s.str());
+        ASSERT_EQ(mpz_class(nx - sx * sx).get_str(), r.str());
+    }
+
+    // output is one of operands
+    bigint a("123456789012345678901234567890");
+    bigint::mul(a, a, a);
+    ASSERT_EQ(bigint("15241578753238836750495351562536198787501905199875019052100"), a);
+    bigint::tdiv_qr(a, r, a, bigint("1000000007"));
+    ASSERT_EQ(bigint("15241578646547786224660847989910262858130065192964"), a);
+    ASSERT_EQ(bigint("562701352"), r);
+
+    for (unsigned long exp : {0UL, 1UL, 2UL, 13UL, 100UL}) {
+        for (const char* base : {"0", "1", "-1", "2", "-3", "18446744073709551615", "123456789012345678901234567890"}) {
+            mpz_class expected;
+            mpz_pow_ui(expected.get_mpz_t(), mpz_class(base).get_mpz_t(), exp);
+            bigint::pow_ui(r, bigint(base), exp);
+            ASSERT_EQ(expected.get_str(), r.str()) << base << "^" << exp;
+        }
+    }
+    bigint p("3");
+    bigint::pow_ui(p, p, 5);
+    ASSERT_EQ(bigint("243"), p);
+
+    ASSERT_THROW(bigint::sqrt_rem(s, r, bigint("-4")), bigmath::value_error);
+}
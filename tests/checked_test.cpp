@@ -0,0 +1,132 @@
+/*!
+ * bigmath.
+ * checked_test.cpp
+ *
+ * \date 10/17/2026
+ * \author Eduard Maximovich (edward.vstock@gmail.com)
+ * \link   https://github.com/edwardstock
+ */
+
+#include <bigmath/checked.h>
+#include <gtest/gtest.h>
+
+using namespace bigmath;
+
+TEST(Checked, DecimalArithmetic) {
+    const bigdecimal a("10.5");
+    const bigdecimal b("0.25");
+    const bigdecimal zero("0");
+
+    result<bigdecimal> r = checked::add(a, b);
+    ASSERT_TRUE(r.ok());
+    ASSERT_EQ(a + b, r.value);
+    ASSERT_EQ(a - b, checked::sub(a, b).value);
+    ASSERT_EQ(a * b, checked::mul(a, b).value);
+    ASSERT_EQ(a / b, checked::div(a, b).value);
+    ASSERT_EQ(a % b, checked::rem(a, b).value);
+    ASSERT_EQ(a.fma(b, a), checked::fma(a, b, a).value);
+    ASSERT_EQ(bigdecimal("10.50"), checked::quantize(a, bigdecimal("0.01")).value);
+
+    // context traps are ignored and context status is not changed
+    const uint32_t status = context.status();
+    r = checked::div(a, zero);
+    ASSERT_FALSE(r);
+    ASSERT_TRUE(r.has(MPD_Division_by_zero));
+    ASSERT_TRUE(r.value.isinfinite());
+    r = checked::div(zero, zero);
+    ASSERT_FALSE(r.ok());
+    ASSERT_TRUE(r.has(MPD_Division_undefined));
+    ASSERT_FALSE(checked::sqrt(bigdecimal("-1.0")).ok());
+    ASSERT_FALSE(checked::add(a, bigdecimal()).ok()); // sNaN
+    ASSERT_EQ(status, context.status());
+
+    bd_context c(2);
+    c.traps(MPD_Inexact);
+    r = checked::add(a, b, c);
+    ASSERT_TRUE(r.ok());
+    ASSERT_TRUE(r.has(MPD_Inexact | MPD_Rounded));
+    ASSERT_EQ(0u, c.status());
+    ASSERT_THROW(r.raise(c), bigmath::inexact_error);
+    ASSERT_TRUE(c.status() & MPD_Inexact);
+
+    bd_context overflow(10, 5);
+    r = checked::mul(bigdecimal("99999.0"), bigdecimal("99999.0"), overflow);
+    ASSERT_TRUE(r.has(MPD_Overflow));
+    ASSERT_FALSE(r.ok());
+
+    bd_context quiet;
+    quiet.traps(0);
+    ASSERT_TRUE(checked::div(a, zero).raise(quiet).isinfinite());
+    ASSERT_TRUE(quiet.status() & MPD_Division_by_zero);
+}
+
+TEST(Checked, Parse) {
+    result<bigdecimal> r = checked::parse("124.4502");
+    ASSERT_TRUE(r.ok());
+    ASSERT_EQ(bigdecimal("124.4502"), r.value);
+
+    for (const char* s : {"", "-", "1.2.3", "12a", "1e5", "NaN"}) {
+        r = checked::parse(s);
+        ASSERT_FALSE(r.ok()) << s;
+        ASSERT_TRUE(r.has(MPD_Conversion_syntax)) << s;
+        ASSERT_TRUE(r.value.isnan()) << s;
+    }
+
+    ASSERT_TRUE(checked::exact("-Infinity").value.isinfinite());
+    ASSERT_TRUE(checked::exact("1E+5").ok());
+    ASSERT_TRUE(checked::exact("abc").has(MPD_Conversion_syntax));
+
+    result<bigint> i = checked::parse_bigint("-66634859979403239086722692970");
+    ASSERT_TRUE(i.ok());
+    ASSERT_EQ(bigint("-66634859979403239086722692970"), i.value);
+    ASSERT_EQ(bigint(255), checked::parse_bigint("ff", 16).value);
+    ASSERT_TRUE(checked::parse_bigint("12 3").has(MPD_Conversion_syntax));
+    ASSERT_TRUE(checked::parse_bigint("").has(MPD_Conversion_syntax));
+    ASSERT_TRUE(checked::parse_bigint("-").has(MPD_Conversion_syntax));
+    ASSERT_TRUE(checked::parse_bigint("12", 2).has(MPD_Conversion_syntax));
+    ASSERT_FALSE(checked::parse_bigint("12", 1).ok());
+}
+
+TEST(Checked, IntegerConversion) {
+    ASSERT_EQ(-42, checked::to_i64(bigdecimal("-42.0")).value);
+    ASSERT_TRUE(checked::to_i64(bigdecimal("-42.0")).ok());
+    ASSERT_FALSE(checked::to_i64(bigdecimal("42.5")).ok());
+    ASSERT_FALSE(checked::to_i64(bigdecimal("9223372036854775808.0")).ok());
+    ASSERT_FALSE(checked::to_i32(bigdecimal("2147483648.0")).ok());
+    ASSERT_EQ(UINT64_MAX, checked::to_u64(bigdecimal("18446744073709551615.0")).value);
+    ASSERT_FALSE(checked::to_u64(bigdecimal("-1.0")).ok());
+    ASSERT_FALSE(checked::to_u32(bigdecimal()).ok());
+
+    result<bigint> b = checked::to_bigint(bigdecimal("12.5"));
+    ASSERT_TRUE(b.ok());
+    ASSERT_EQ(bigint(12), b.value);
+    ASSERT_TRUE(checked::to_bigint(bigdecimal::exact("Infinity", context)).has(MPD_Invalid_operation));
+
+    ASSERT_EQ(INT64_MIN, checked::to_i64(bigint("-9223372036854775808")).value);
+    ASSERT_TRUE(checked::to_i64(bigint("-9223372036854775808")).ok());
+    ASSERT_FALSE(checked::to_i64(bigint("9223372036854775808")).ok());
+    ASSERT_FALSE(checked::to_i64(bigint("-9223372036854775809")).ok());
+    ASSERT_EQ(UINT64_MAX, checked::to_u64(bigint("18446744073709551615")).value);
+    ASSERT_FALSE(checked::to_u64(bigint("18446744073709551616")).ok());
+    ASSERT_FALSE(checked::to_u64(bigint(-1)).ok());
+    ASSERT_EQ(0u, checked::to_u64(bigint(0)).value);
+}
+
+TEST(Checked, BigIntArithmetic) {
+    const bigint a("66634859979403239086722692970");
+    const bigint b(-1000);
+    ASSERT_EQ(a / b, checked::div(a, b).value);
+    ASSERT_EQ(a % b, checked::mod(a, b).value);
+    result<std::pair<bigint, bigint>> qr = checked::divmod(a, b);
+    ASSERT_TRUE(qr.ok());
+    ASSERT_EQ(a / b, qr.value.first);
+    ASSERT_EQ(a % b, qr.value.second);
+
+    ASSERT_TRUE(checked::div(a, bigint(0)).has(MPD_Division_by_zero));
+    ASSERT_TRUE(checked::mod(a, bigint(0)).has(MPD_Division_by_zero));
+    ASSERT_FALSE(checked::divmod(a, bigint(0)).ok());
+
+    ASSERT_EQ(bigint(12), checked::sqrt(bigint(150)).value);
+    ASSERT_TRUE(checked::sqrt(bigint(-4)).has(MPD_Invalid_operation));
+    ASSERT_THROW(checked::div(a, bigint(0)).raise(), bigmath::division_by_zero);
+}
@@ -0,0 +1,90 @@
+/*!
+ * bigmath.
+ * context_scope_test.cpp
+ *
+ * \date 10/17/2026
+ * \author Eduard Maximovich (edward.vstock@gmail.com)
+ * \link   https://github.com/edwardstock
+ */
+
+#include <bigmath/bigdecimal.h>
+#include <gtest/gtest.h>
+#include <stdexcept>
+
+using namespace bigmath;
+
+TEST(ContextScope, OverrideAndRestore) {
+    const bd_context saved = context;
+    const bigdecimal one("1");
+    const bigdecimal three("3");
+
+    {
+        context_scope scope(5);
+        ASSERT_EQ(5, context.prec());
+        ASSERT_EQ(bigdecimal("0.33333"), one.div(three));
+        {
+            bd_context c(context);
+            c.prec(3);
+            c.round(ROUND_UP);
+            context_scope inner(c);
+            ASSERT_EQ(bigdecimal("0.334"), one.div(three));
+        }
+        ASSERT_EQ(5, context.prec());
+        ASSERT_EQ(ROUND_HALF_EVEN, context.round());
+    }
+    ASSERT_EQ(saved.prec(), context.prec());
+    ASSERT_EQ(saved.round(), context.round());
+    ASSERT_EQ(saved.traps(), context.traps());
+    ASSERT_EQ(saved.policy(), context.policy());
+
+    context = saved;
+}
+
+TEST(ContextScope, Policy) {
+    const bd_context saved = context;
+    const bigdecimal a("1.23456789");
+    const bigdecimal b("2");
+
+    {
+        // operand_digits policy ignores context precision
+        context_scope scope(3);
+        ASSERT_EQ(bigdecimal("2.46913578"), a * b);
+    }
+    {
+        context_scope scope(3, precision_policy::fixed);
+        ASSERT_EQ(bigdecimal("2.47"), a * b);
+    }
+    ASSERT_EQ(precision_policy::operand_digits, context.policy());
+    ASSERT_EQ(bigdecimal("2.46913578"), a * b);
+
+    context = saved;
+}
+
+TEST(ContextScope, StatusAndExceptions) {
+    const bd_context saved = context;
+    context.clear_status();
+
+    try {
+        context_scope scope(5);
+        bigdecimal("1").div(bigdecimal("3"));
+        throw std::runtime_error("leave scope");
+    } catch (const std::runtime_error&) {
+    }
+    ASSERT_EQ(saved.prec(), context.prec());
+    ASSERT_TRUE(context.status() & MPD_Inexact);
+
+    ASSERT_THROW(context_scope(0), value_error);
+    ASSERT_EQ(saved.prec(), context.prec());
+
+    context = saved;
+}
+
+TEST(ContextScope, WithContext) {
+    bd_context c;
+    c.prec(4);
+    const bigdecimal r = with_context(c, [] {
+        return bigdecimal("2").sqrt();
+    });
+    ASSERT_EQ(bigdecimal("1.414"), r);
+    ASSERT_NE(4, context.prec());
+}
@@ -0,0 +1,208 @@
+/*!
+ * bigmath.
+ * decimal_column_test.cpp
+ *
+ * \date 10/17/2026
+ * \author Eduard Maximovich (edward.vstock@gmail.com)
+ * \link   https://github.com/edwardstock
+ */
+
+#include <bigmath/batch.h>
+#include <bigmath/decimal_column.h>
+#include <climits>
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+using namespace bigmath;
+
+static std::vector<bigdecimal> make_values(const std::vector<const char*>& strs) {
+    std::vector<bigdecimal> values;
+    for (const char* s : strs) {
+        values.push_back(bigdecimal::exact(s, bigmath::context));
+    }
+    return values;
+}
+
+/* small amounts with common exponent, large coefficients, other exponents and special values */
+static const std::vector<const char*> MIXED = {
+    "124.450200000000000200",
+    "-0.000000000000000001",
+    "99999999999999999999.999999999999999999",
+    "-99999999999999999999.999999999999999999",
+    "0.000000000000000000",
+    "-0.000000000000000000",
+    "123456789012345678901234567890123456789012345.123456789012345678",
+    "1.5",
+    "-7E+10",
+    "1E-30",
+};
+
+TEST(DecimalColumn, Storage) {
+    const std::vector<bigdecimal> values = make_values(MIXED);
+    decimal_column column(values);
+    ASSERT_EQ(values.size(), column.size());
+    for (size_t i = 0; i < values.size(); i++) {
+        ASSERT_EQ(values[i].to_sci(), column[i].to_sci());
+        ASSERT_EQ(values[i].issigned(), column.issigned(i));
+        ASSERT_EQ(values[i].getconst()->exp, column.exponent(i));
+    }
+
+    // view is usable as mpdecimal operand
+    const mpd_t v = column.view(2);
+    ASSERT_EQ(0, mpd_cmp_total(&v, values[2].getconst()));
+
+    // large coefficient replaced by small one and back
+    column.set(6, bigdecimal("2.5"));
+    ASSERT_EQ(bigdecimal("2.5"), column[6]);
+    column.set(0, values[6]);
+    ASSERT_EQ(values[6], column[0]);
+
+    decimal_column specials;
+    specials.push_back(bigdecimal::exact("Infinity", bigmath::context));
+    specials.push_back(bigdecimal::exact("-Infinity", bigmath::context));
+    specials.push_back(bigdecimal::exact("NaN", bigmath::context));
+    ASSERT_TRUE(specials[0].isinfinite());
+    ASSERT_TRUE(specials[1].issigned());
+    ASSERT_TRUE(specials[2].isnan());
+
+    const decimal_column copy = column;
+    ASSERT_EQ(column[0], copy[0]);
+    column.clear();
+    ASSERT_TRUE(column.empty());
+    ASSERT_EQ(values[6], copy[0]);
+}
+
+TEST(DecimalColumn, Sum) {
+    const std::vector<bigdecimal> values = make_values(MIXED);
+    const decimal_column column(values);
+
+    bd_context wide;
+    wide.prec(200);
+    ASSERT_EQ(batch::sum(values, wide), column.sum(wide));
+    bd_context ctx;
+    ctx.prec(20);
+    ASSERT_EQ(batch::sum(values, ctx), column.sum(ctx));
+    ASSERT_EQ(batch::sum(values), column.sum());
+
+    // carries of many words of common exponent
+    std::vector<bigdecimal> amounts(5000, bigdecimal("99999999999999999999.999999999999999999"));
+    amounts[17] = bigdecimal("-12345.5");
+    ASSERT_EQ(batch::sum(amounts), decimal_column(amounts).sum());
+
+    ASSERT_EQ(bigdecimal("0"), decimal_column().sum());
+
+    // zeros keep exponent of result
+    for (const auto& zeros : {std::vector<const char*>{"0.000", "1.5"}, std::vector<const char*>{"0.00"},
+                              std::vector<const char*>{"-0.00", "0.0"}, std::vector<const char*>{"-0.000", "-2.5"}}) {
+        const std::vector<bigdecimal> v = make_values(zeros);
+        ASSERT_EQ(batch::sum(v).to_sci(), decimal_column(v).sum().to_sci()) << zeros[0];
+        ASSERT_EQ(batch::sum(v, wide).to_sci(), decimal_column(v).sum(wide).to_sci()) << zeros[0];
+    }
+}
+
+TEST(DecimalColumn, Add) {
+    const std::vector<bigdecimal> a = make_values(MIXED);
+    std::vector<bigdecimal> b = make_values({
+        "0.549799999999999800",
+        "0.000000000000000001",
+        "0.000000000000000001",
+        "99999999999999999999.999999999999999999",
+        "-0.000000000000000000",
+        "-0.000000000000000000",
+        "1",
+        "-1.5",
+        "3E+10",
+        "Infinity",
+    });
+    const decimal_column ca(a);
+    const decimal_column cb(b);
+
+    decimal_column out;
+    decimal_column::add(ca, cb, out);
+    ASSERT_EQ(a.size(), out.size());
+    for (size_t i = 0; i < a.size(); i++) {
+        ASSERT_EQ((a[i] + b[i]).to_sci(), out[i].to_sci()) << i;
+    }
+
+    bd_context ctx;
+    ctx.prec(10);
+    ctx.round(ROUND_FLOOR);
+    decimal_column::add(ca, cb, out, ctx);
+    for (size_t i = 0; i < a.size(); i++) {
+        ASSERT_EQ(a[i].add(b[i], ctx).to_sci(), out[i].to_sci()) << i;
+    }
+    ASSERT_TRUE(ctx.status() & MPD_Rounded);
+
+    // result in place of operand
+    decimal_column in_place(a);
+    decimal_column::add(in_place, cb, in_place);
+    for (size_t i = 0; i < a.size(); i++) {
+        ASSERT_EQ((a[i] + b[i]).to_sci(), in_place[i].to_sci()) << i;
+    }
+
+    ASSERT_THROW(decimal_column::add(ca, decimal_column(), out), bigmath::value_error);
+
+    // sum of full 19-digit low words exceeds 2^64
+    const std::vector<bigdecimal> nines = make_values({
+        "0.9999999999999999999",
+        "-0.9999999999999999999",
+        "12345678901234567890.9999999999999999999",
+    });
+    const decimal_column cn(nines);
+    bd_context wide;
+    wide.prec(40);
+    decimal_column::add(cn, cn, out, wide);
+    ASSERT_EQ(bigdecimal("1.9999999999999999998"), out[0]);
+    ASSERT_EQ(bigdecimal("-1.9999999999999999998"), out[1]);
+    ASSERT_EQ(bigdecimal("24691357802469135781.9999999999999999998"), out[2]);
+    decimal_column::add(cn, cn, out);
+    for (size_t i = 0; i < nines.size(); i++) {
+        ASSERT_EQ((nines[i] + nines[i]).to_sci(), out[i].to_sci()) << i;
+    }
+
+    // high words of 2^63 and more wrap 64 bits
+    const std::vector<bigdecimal> high = make_values({
+        "9300000000000000000.0000000000000000001",
+        "-9999999999999999999.9999999999999999999",
+    });
+    const decimal_column ch(high);
+    decimal_column::add(ch, ch, out);
+    for (size_t i = 0; i < high.size(); i++) {
+        ASSERT_EQ((high[i] + high[i]).to_sci(), out[i].to_sci()) << i;
+    }
+    decimal_column::add(ch, ch, out, wide);
+    ASSERT_EQ(bigdecimal("18600000000000000000.0000000000000000002"), out[0]);
+    ASSERT_EQ(bigdecimal("-19999999999999999999.9999999999999999998"), out[1]);
+}
+
+TEST(DecimalColumn, Compare) {
+    const std::vector<bigdecimal> a = make_values(MIXED);
+    std::vector<bigdecimal> b = make_values({
+        "124.450200000000000201",
+        "-0.000000000000000001",
+        "-99999999999999999999.999999999999999999",
+        "-99999999999999999999.999999999999999998",
+        "-0.000000000000000000",
+        "0",
+        "1",
+        "1.50",
+        "3E+10",
+        "NaN",
+    });
+    std::vector<int> out;
+    ASSERT_THROW(decimal_column::compare(decimal_column(a), decimal_column(b), out), bigmath::IEEE_invalid_operation);
+
+    const bd_context saved = bigmath::context;
+    bigmath::context.traps(0);
+    decimal_column::compare(decimal_column(a), decimal_column(b), out);
+    const uint32_t status = bigmath::context.status();
+    bigmath::context = saved;
+    ASSERT_TRUE(status & MPD_Invalid_operation);
+    ASSERT_EQ(a.size(), out.size());
+    for (size_t i = 0; i < a.size() - 1; i++) {
+        uint32_t status = 0;
+        ASSERT_EQ(mpd_qcmp(a[i].getconst(), b[i].getconst(), &status), out[i]) << i;
+    }
+    ASSERT_EQ(INT_MAX, out.back());
+}
@@ -0,0 +1,109 @@
+/*!
+ * bigmath.
+ * decimal_expr_test.cpp
+ *
+ * \date 10/17/2026
+ * \author Eduard Maximovich (edward.vstock@gmail.com)
+ * \link   https://github.com/edwardstock
+ */
+
+#include <bigmath/decimal_expr.h>
+#include <gtest/gtest.h>
+
+using namespace bigmath;
+
+/* exact value of expression computed with 200 digits, rounded once to ctx */
+static bigdecimal round_once(const bigdecimal& exact, const bd_context& ctx) {
+    bd_context c(*ctx.getconst());
+    return exact.plus(c);
+}
+
+static bd_context wide_context() {
+    bd_context c;
+    c.prec(200);
+    return c;
+}
+
+TEST(DecimalExpr, SingleRounding) {
+    const bigdecimal a("1.544330992569880586");
+    const bigdecimal b("3.838614914212036001");
+    const bigdecimal c("7.878515028072670841");
+    const bigdecimal d("0.451406045246141638");
+
+    bd_context ctx;
+    ctx.prec(19);
+    ctx.round(ROUND_HALF_EVEN);
+
+    bd_context wide = wide_context();
+    const bigdecimal exact = a.mul(b, wide).div(c, wide).add(d, wide);
+    ASSERT_EQ(round_once(exact, ctx), eval(lazy(a) * b / c + d, ctx));
+    ASSERT_EQ(bigdecimal::exact("1.203843777412125175", bigmath::context), eval(lazy(a) * b / c + d, ctx));
+
+    // stepwise rounding of each operation gives a different last digit
+    ASSERT_NE(a.mul(b, ctx).div(c, ctx).add(d, ctx), eval(lazy(a) * b / c + d, ctx));
+
+    // default precision follows arithmetic operators: max(digits) of all operands
+    ASSERT_EQ(round_once(exact, bd_context(19)), eval(lazy(a) * b / c + d));
+
+    // subtraction, division of subexpressions and bigdecimal on the left side
+    const bigdecimal exact2 = a.sub(b.div(c.sub(d, wide), wide), wide).mul(c.add(a, wide), wide);
+    ASSERT_EQ(round_once(exact2, ctx), eval((a - b / (lazy(c) - d)) * (c + lazy(a)), ctx));
+    ASSERT_EQ(a.plus(ctx), eval(lazy(a), ctx));
+}
+
+TEST(DecimalExpr, Fma) {
+    const bigdecimal a("123456789.123456789");
+    const bigdecimal b("987654321.987654321");
+    const bigdecimal c("-121932631356500531.347203169112635269");
+
+    bd_context ctx;
+    ctx.prec(10);
+    ASSERT_EQ(a.fma(b, c, ctx), eval(lazy(a) * b + c, ctx));
+    ASSERT_EQ(a.fma(b, c, ctx), eval(c + lazy(a) * b, ctx));
+    ASSERT_EQ(a.fma(b, c, ctx), eval(lazy(a) * b + c * lazy(bigdecimal("1")), ctx));
+
+    // product is not rounded before addition
+    bd_context wide = wide_context();
+    ASSERT_EQ(round_once(a.mul(b, wide).add(c, wide), ctx), eval(lazy(a) * b + c, ctx));
+    ASSERT_NE(a.mul(b, ctx).add(c, ctx), eval(lazy(a) * b + c, ctx));
+}
+
+TEST(DecimalExpr, Policies) {
+    const bigdecimal a("10.5");
+    const bigdecimal b("3");
+    ASSERT_EQ(bigdecimal::exact("3.5", bigmath::context), eval(lazy(a) / b));
+    ASSERT_EQ(a * b + a, eval(lazy(a) * b + a));
+
+    {
+        context_scope scope(5, precision_policy::fixed);
+        ASSERT_EQ(bigdecimal::exact("1.1667", bigmath::context), eval(lazy(a) / b / b));
+    }
+
+    // inline coefficient size follows operands
+    const basic_bigdecimal<2> x("1.5");
+    const basic_bigdecimal<2> result2 = eval(lazy(x) * x - x);
+    ASSERT_EQ(basic_bigdecimal<2>("0.75"), result2);
+}
+
+TEST(DecimalExpr, Cancellation) {
+    const bigdecimal one("1");
+    const bigdecimal three("3");
+    context_scope scope(5, precision_policy::fixed);
+    // rounded quotient loses leading digits in subtraction, guard digits are extended
+    ASSERT_EQ(bigdecimal::exact("0.0000033333", bigmath::context), eval(lazy(one) / three - bigdecimal("0.33333")));
+    ASSERT_EQ(bigdecimal::exact("3.3333E-17", bigmath::context),
+              eval(lazy(one) / three - bigdecimal("0.3333333333333333")));
+}
+
+TEST(DecimalExpr, Traps) {
+    const bigdecimal a("1");
+    const bigdecimal zero("0");
+    bd_context ctx;
+    ctx.traps(ctx.traps() | MPD_Division_by_zero);
+    ASSERT_THROW(eval(lazy(a) / zero + a, ctx), bigmath::division_by_zero);
+
+    bd_context quiet;
+    quiet.traps(0);
+    ASSERT_TRUE(eval(lazy(a) / zero + a, quiet).isinfinite());
+    ASSERT_TRUE(quiet.status() & MPD_Division_by_zero);
+}
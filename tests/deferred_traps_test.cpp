@@ -0,0 +1,161 @@
+/*!
+ * bigmath.
+ * deferred_traps_test.cpp
+ *
+ * \date 10/17/2026
+ * \author Eduard Maximovich (edward.vstock@gmail.com)
+ * \link   https://github.com/edwardstock
+ */
+
+#include <bigmath/bigdecimal.h>
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <string>
+
+using namespace bigmath;
+
+TEST(DeferredTraps, UnionAndFirstIndex) {
+    bd_context c;
+    c.emax(10);
+    const bigdecimal one("1");
+    const bigdecimal zero("0");
+    const bigdecimal huge("1000000");
+
+    bool thrown = false;
+    try {
+        deferred_traps guard(c);
+        ASSERT_EQ(0u, guard.pending());
+        ASSERT_EQ(deferred_traps::npos, guard.first_index());
+
+        ASSERT_EQ(bigdecimal("0.5"), one.div(bigdecimal("2"), c));
+        ASSERT_TRUE(one.div(zero, c).isinfinite()); // #1
+        ASSERT_TRUE(huge.mul(huge, c).isinfinite()); // #2
+        ASSERT_TRUE(one.div(zero, c).isinfinite());
+
+        ASSERT_EQ(4u, guard.count());
+        ASSERT_EQ(uint32_t(MPD_Division_by_zero | MPD_Overflow), guard.pending());
+        ASSERT_EQ(1u, guard.first_index());
+    } catch (const division_by_zero& e) {
+        thrown = true;
+        const std::string msg = e.what();
+        ASSERT_NE(std::string::npos, msg.find("division_by_zero"));
+        ASSERT_NE(std::string::npos, msg.find("overflow_error"));
+        ASSERT_NE(std::string::npos, msg.find("operation #1"));
+    }
+    ASSERT_TRUE(thrown);
+
+    // status is accumulated as without guard, traps fire immediately again
+    ASSERT_TRUE(c.status() & MPD_Division_by_zero);
+    ASSERT_TRUE(c.status() & MPD_Overflow);
+    ASSERT_THROW(one.div(zero, c), division_by_zero);
+}
+
+TEST(DeferredTraps, NoTrapNoThrow) {
+    bd_context c;
+    c.clear_traps(MPD_Division_by_zero);
+    {
+        deferred_traps guard(c);
+        // not trapped flags are not pending
+        ASSERT_TRUE(bigdecimal("1").div(bigdecimal("0"), c).isinfinite());
+        ASSERT_EQ(bigdecimal("0.333333333333333333"), bigdecimal("1").div(bigdecimal("3"), c));
+        ASSERT_EQ(0u, guard.pending());
+    }
+    ASSERT_TRUE(c.status() & MPD_Division_by_zero);
+    ASSERT_TRUE(c.status() & MPD_Inexact);
+}
+
+TEST(DeferredTraps, CheckAndDismiss) {
+    bd_context c;
+    const bigdecimal one("1");
+    const bigdecimal zero("0");
+
+    deferred_traps guard(c);
+    one.div(zero, c);
+    ASSERT_THROW(guard.check(), division_by_zero);
+    // still deferring after check, indices are counted from guard creation
+    ASSERT_EQ(0u, guard.pending());
+    one.div(one, c);
+    one.div(zero, c);
+    ASSERT_EQ(2u, guard.first_index());
+
+    guard.dismiss();
+    ASSERT_EQ(0u, guard.pending());
+    ASSERT_THROW(one.div(zero, c), division_by_zero);
+}
+
+TEST(DeferredTraps, Nested) {
+    bd_context c;
+    const bigdecimal one("1");
+    const bigdecimal zero("0");
+
+    try {
+        deferred_traps outer(c);
+        one.mul(one, c);
+        try {
+            deferred_traps inner(c);
+            one.div(zero, c);
+            ASSERT_EQ(0u, inner.first_index());
+        } catch (const division_by_zero&) {
+            // reported by inner guard, not pending in outer
+        }
+        ASSERT_EQ(0u, outer.pending());
+
+        bigdecimal("-1").sqrt(c);
+        ASSERT_EQ(uint32_t(MPD_Invalid_operation), outer.pending());
+        ASSERT_EQ(2u, outer.first_index());
+    } catch (const invalid_operation_error& e) {
+        ASSERT_NE(std::string::npos, std::string(e.what()).find("operation #2"));
+        return;
+    }
+    FAIL() << "outer guard must throw on exit";
+}
+
+TEST(DeferredTraps, StackUnwinding) {
+    bd_context c;
+    const bigdecimal one("1");
+    const bigdecimal zero("0");
+
+    // other exception is in flight: guard must not throw, pending flags move to outer guard
+    try {
+        deferred_traps outer(c);
+        try {
+            deferred_traps inner(c);
+            one.div(zero, c);
+            throw std::logic_error("unrelated");
+        } catch (const std::logic_error&) {
+        }
+        ASSERT_EQ(uint32_t(MPD_Division_by_zero), outer.pending());
+        ASSERT_EQ(0u, outer.first_index());
+        outer.dismiss();
+    } catch (...) {
+        FAIL() << "dismissed guard must not throw";
+    }
+}
+
+TEST(DeferredTraps, MallocErrorIsNotDeferred) {
+    bd_context c;
+    deferred_traps guard(c);
+    ASSERT_THROW(c.raise(MPD_Malloc_error), malloc_error);
+    guard.dismiss();
+}
+
+TEST(DeferredTraps, FixedPolicyOperators) {
+    const bd_context saved = context;
+    context.policy(precision_policy::fixed);
+    const bigdecimal zero("0");
+    const bigdecimal two("2");
+    bigdecimal v("1");
+    try {
+        deferred_traps guard;
+        for (int i = 0; i < 10; i++) {
+            v = (i == 7) ? v / zero : v * two;
+        }
+        ASSERT_EQ(7u, guard.first_index());
+    } catch (const division_by_zero& e) {
+        ASSERT_NE(std::string::npos, std::string(e.what()).find("operation #7"));
+        context = saved;
+        return;
+    }
+    context = saved;
+    FAIL() << "guard must throw on exit";
+}
@@ -0,0 +1,177 @@
+/*!
+ * bigmath.
+ * fixed_decimal_test.cpp
+ *
+ * \date 10/17/2026
+ * \author Eduard Maximovich (edward.vstock@gmail.com)
+ * \link   https://github.com/edwardstock
+ */
+
+#include <bigmath/fixed_decimal.h>
+#include <gtest/gtest.h>
+#include <random>
+#include <sstream>
+#include <string>
+
+#ifdef HAVE_UINT128_T
+
+using namespace bigmath;
+using fixed18 = fixed_decimal<18>;
+
+TEST(FixedDecimal, Basic) {
+    const fixed18 a("125.111111111111111111");
+    const fixed18 b("125.111111111111111111");
+    ASSERT_EQ(fixed18("250.222222222222222222"), a + b);
+    ASSERT_EQ(fixed18("0"), a - b);
+    ASSERT_EQ("250.222222222222222222", (a + b).str());
+    ASSERT_EQ("0.000000000000000000", fixed18().str());
+    ASSERT_EQ("-0.500000000000000000", fixed18("-.5").str());
+    ASSERT_EQ("12.000000000000000000", fixed18(12).str());
+    ASSERT_EQ("7", fixed_decimal<0>("7").str());
+    ASSERT_EQ(fixed18("-1.5"), -fixed18("1.5"));
+    ASSERT_EQ(fixed18("1.5"), fixed18("-1.5").abs());
+    ASSERT_EQ(fixed18::ONE, fixed18(1).raw());
+    ASSERT_EQ(fixed18("0.000000000000000001"), fixed18::from_raw(1));
+
+    ASSERT_LT(fixed18("-1"), fixed18("0.1"));
+    ASSERT_GE(fixed18("2"), fixed18("2.000"));
+    ASSERT_NE(fixed18("2"), fixed18("2.000000000000000001"));
+
+    fixed18 c("1.5");
+    c *= fixed18("2");
+    c /= fixed18("4");
+    c += fixed18("1");
+    c -= fixed18("0.25");
+    ASSERT_EQ(fixed18("1.5"), c);
+
+    std::stringstream ss;
+    ss << fixed_decimal<2>("-3.1");
+    ASSERT_EQ("-3.10", ss.str());
+
+    char buf[8];
+    ASSERT_EQ(std::errc::value_too_large, fixed_decimal<2>("-3.1").to_chars(buf, buf + 4).ec);
+    ASSERT_EQ(std::errc(), fixed_decimal<2>("-3.1").to_chars(buf, buf + 5).ec);
+}
+
+TEST(FixedDecimal, Conversions) {
+    for (const char* s : {"0", "1", "-1", "0.000000000000000001", "-123456789012345678.901234567890123456",
+                          "170141183460469231731.687303715884105727"}) {
+        const fixed18 f(s);
+        const bigdecimal d = f.to_bigdecimal();
+        ASSERT_EQ(bigdecimal(s), d) << s;
+        ASSERT_EQ(-18, d.getconst()->exp) << s;
+        ASSERT_EQ(f, fixed18(d)) << s;
+        ASSERT_EQ(f.str(), d.format("f")) << s;
+    }
+
+    ASSERT_EQ(fixed18("1500"), fixed18(bigdecimal::exact("1.5E+3", bigmath::context)));
+    ASSERT_EQ(fixed18("1.5"), fixed18(bigdecimal::exact("1.50000000000000000000000", bigmath::context)));
+    ASSERT_EQ(fixed18("0"), fixed18(bigdecimal::exact("0E+100", bigmath::context)));
+    ASSERT_EQ(fixed18("123456789"), fixed18(bigint("123456789")));
+    ASSERT_EQ(bigint("-123456789"), fixed18(bigint("-123456789")).to_bigint());
+    ASSERT_EQ(bigint("3"), fixed18("2.5").to_bigint() + bigint("1"));
+
+    ASSERT_THROW(fixed18(bigdecimal::exact("1E-19", bigmath::context)), bigmath::inexact_error);
+    ASSERT_THROW(fixed18(bigdecimal::exact("1E+21", bigmath::context)), bigmath::overflow_error);
+    ASSERT_THROW(fixed18(bigdecimal::exact("NaN", bigmath::context)), bigmath::value_error);
+    ASSERT_THROW(fixed18(bigint("1000000000000000000000")), bigmath::overflow_error);
+    ASSERT_THROW(fixed_decimal<20>(uint64_t(-1)), bigmath::overflow_error);
+    // 41 digits wrap 128 bits before range check
+    ASSERT_THROW(fixed_decimal<0>(bigdecimal("1" + std::string(40, '0'))), bigmath::overflow_error);
+
+    ASSERT_THROW(fixed18("1.0000000000000000001"), bigmath::inexact_error);
+    ASSERT_EQ(fixed18("1"), fixed18("1.0000000000000000000"));
+    ASSERT_THROW(fixed18("170141183460469231731.687303715884105728"), bigmath::overflow_error);
+    for (const char* s : {"", "-", ".", "1e5", "1.2.3", " 1", "abc", "+-1"}) {
+        ASSERT_THROW(fixed18(std::string_view(s)), bigmath::conversion_syntax_error) << s;
+    }
+}
+
+TEST(FixedDecimal, Overflow) {
+    const fixed18 max = fixed18::from_raw(~(uint128_t) 0 >> 1);
+    fixed18 r("5");
+    ASSERT_FALSE(max.try_add(fixed18::from_raw(1), r));
+    ASSERT_EQ(fixed18("5"), r);
+    ASSERT_FALSE((-max).try_sub(fixed18("2"), r));
+    ASSERT_FALSE(max.try_mul(fixed18("2"), r));
+    ASSERT_FALSE(max.try_div(fixed18("0.5"), r));
+    ASSERT_TRUE(max.try_mul(fixed18("0.5"), r));
+    ASSERT_THROW(max + fixed18("1"), bigmath::overflow_error);
+    ASSERT_THROW(max * max, bigmath::overflow_error);
+    ASSERT_THROW(fixed18("1") / fixed18(), bigmath::division_by_zero);
+
+    // promoted results are exact for add and sub, rounded to 18 digits for mul and div
+    const bigdecimal maxdec = max.to_bigdecimal();
+    ASSERT_EQ(maxdec + maxdec, max.promote_add(max));
+    ASSERT_EQ(-18, max.promote_add(max).getconst()->exp);
+    ASSERT_EQ(bigdecimal::exact("-340282366920938463463.374607431768211454", bigmath::context), (-max).promote_sub(max));
+    ASSERT_EQ(bigdecimal::exact("28948022309329048855892746252171976962977.213799489202546401", bigmath::context),
+              max.promote_mul(max));
+    ASSERT_EQ(bigdecimal::exact("510423550381407695705.485461529060012886", bigmath::context),
+              max.promote_div(fixed18("0.333333333333333333")));
+    ASSERT_EQ(fixed18("2").to_bigdecimal(), fixed18("1").promote_add(fixed18("1")));
+}
+
+/* reference: exact product or correctly rounded quotient from mpdecimal, rescaled to exponent -scale */
+static bigdecimal reference(const bigdecimal& a, const bigdecimal& b, bool div, int round) {
+    uint32_t status = 0;
+    mpd_context_t ctx;
+    mpd_maxcontext(&ctx);
+    bigdecimal exact;
+    if (!div) {
+        mpd_qmul(exact.get(), a.getconst(), b.getconst(), &ctx, &status);
+    } else {
+        // 05UP keeps enough information for the second rounding, quotient has at most 57 integer digits
+        ctx.prec = 100;
+        ctx.round = MPD_ROUND_05UP;
+        mpd_qdiv(exact.get(), a.getconst(), b.getconst(), &ctx, &status);
+    }
+    bigdecimal result;
+    mpd_maxcontext(&ctx);
+    ctx.round = round;
+    mpd_qrescale(result.get(), exact.getconst(), -18, &ctx, &status);
+    return result;
+}
+
+TEST(FixedDecimal, RoundingDifferential) {
+    std::mt19937_64 rnd(42);
+    auto random_fixed = [&rnd](int digits) {
+        std::string s = rnd() % 2 ? "-" : "";
+        for (int i = 0; i < digits; i++) {
+            s += char('0' + rnd() % 10);
+        }
+        return fixed18::from_raw(detail::fixed_parse(s, 0));
+    };
+
+    const int modes[] = {ROUND_UP, ROUND_DOWN, ROUND_CEILING, ROUND_FLOOR, ROUND_HALF_UP, ROUND_HALF_DOWN,
+                         ROUND_HALF_EVEN, ROUND_05UP};
+    std::vector<fixed18> values{fixed18("0.5"), fixed18("-0.5"), fixed18("1.5"), fixed18("0.000000000000000005"),
+                                fixed18("-0.000000000000000015"), fixed18("0.000000000000000001"), fixed18("3")};
+    for (int i = 0; i < 200; i++) {
+        values.push_back(random_fixed(1 + int(rnd() % 38)));
+    }
+
+    for (size_t i = 0; i + 1 < values.size(); i++) {
+        const fixed18& a = values[i];
+        const fixed18& b = values[i + 1];
+        for (int round : modes) {
+            const bigdecimal expected_mul = reference(a.to_bigdecimal(), b.to_bigdecimal(), false, round);
+            ASSERT_EQ(expected_mul, a.promote_mul(b, round)) << a << " * " << b << " " << round;
+            fixed18 r;
+            if (a.try_mul(b, r, round)) {
+                ASSERT_EQ(expected_mul, r.to_bigdecimal()) << a << " * " << b << " " << round;
+            }
+
+            if (b.iszero()) {
+                continue;
+            }
+            const bigdecimal expected_div = reference(a.to_bigdecimal(), b.to_bigdecimal(), true, round);
+            ASSERT_EQ(expected_div, a.promote_div(b, round)) << a << " / " << b << " " << round;
+            if (a.try_div(b, r, round)) {
+                ASSERT_EQ(expected_div, r.to_bigdecimal()) << a << " / " << b << " " << round;
+            }
+        }
+    }
+}
+
+#endif // HAVE_UINT128_T
@@ -0,0 +1,142 @@
+/*!
+ * bigmath.
+ * parallel_test.cpp
+ *
+ * \date 10/17/2026
+ * \author Eduard Maximovich (edward.vstock@gmail.com)
+ * \link   https://github.com/edwardstock
+ */
+
+#include <atomic>
+#include <bigmath/bigdecimal.h>
+#include <bigmath/bigint.h>
+#include <bigmath/parallel.h>
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace bigmath;
+
+static bigint add_to(bigint acc, const bigint& v) {
+    acc += v;
+    return acc;
+}
+
+TEST(Parallel, ReduceBigInt) {
+    std::vector<bigint> balances;
+    bigint expected("0");
+    for (uint32_t i = 0; i < 20000; i++) {
+        balances.emplace_back(std::to_string(uint64_t(i) * 1000003ull * 998244353ull) + "123456789");
+        expected += balances.back();
+    }
+
+    for (size_t threads : {0, 1, 3}) {
+        thread_pool pool(threads);
+        ASSERT_EQ(expected, parallel::reduce(balances.begin(), balances.end(), bigint("0"), add_to, pool, 100));
+        ASSERT_EQ(expected, parallel::reduce(balances.begin(), balances.end(), bigint("0"), add_to, pool));
+    }
+    ASSERT_EQ(expected, parallel::reduce(balances.begin(), balances.end(), bigint("0"), add_to));
+
+    // accumulator updated in place
+    const auto add_inplace = [](bigint& acc, const bigint& v) { acc += v; };
+    ASSERT_EQ(expected, parallel::reduce(balances.begin(), balances.end(), bigint("0"), add_inplace));
+    ASSERT_EQ(bigint("5"), parallel::reduce(balances.begin(), balances.begin(), bigint("5"), add_to));
+}
+
+TEST(Parallel, ContextAndStatus) {
+    std::vector<bigdecimal> values;
+    for (uint32_t i = 1; i <= 3000; i++) {
+        values.emplace_back(std::to_string(i) + ".123456789");
+    }
+
+    const bd_context saved = bigmath::context;
+    bigmath::context.policy(precision_policy::fixed);
+    bigmath::context.prec(6);
+    bigmath::context.clear_status();
+
+    // every chunk uses copy of caller's context, result doesn't depend on count of threads
+    std::atomic<bool> wrong_context{false};
+    const auto add = [&wrong_context](bigdecimal acc, const bigdecimal& v) {
+        if (bigmath::context.prec() != 6) {
+            wrong_context = true;
+        }
+        acc += v;
+        return acc;
+    };
+    thread_pool single(0);
+    thread_pool pool(3);
+    const bigdecimal r1 = parallel::reduce(values.begin(), values.end(), bigdecimal("0"), add, single, 64);
+    const bigdecimal r2 = parallel::reduce(values.begin(), values.end(), bigdecimal("0"), add, pool, 64);
+    const uint32_t status = bigmath::context.status();
+    bigmath::context = saved;
+
+    ASSERT_FALSE(wrong_context);
+    ASSERT_EQ(r1, r2);
+    ASSERT_TRUE(status & MPD_Inexact);
+    ASSERT_TRUE(status & MPD_Rounded);
+
+    // worker contexts are restored after chunks
+    pool.run(16, [&wrong_context](size_t) {
+        if (bigmath::context.prec() == 6 || bigmath::context.policy() == precision_policy::fixed) {
+            wrong_context = true;
+        }
+    });
+    ASSERT_FALSE(wrong_context);
+}
+
+TEST(Parallel, Transform) {
+    std::vector<bigdecimal> amounts;
+    for (uint32_t i = 0; i < 5000; i++) {
+        amounts.emplace_back(std::to_string(i) + ".5");
+    }
+    std::vector<bigint> out(amounts.size());
+    thread_pool pool(2);
+    const auto end = parallel::transform(
+        amounts.begin(), amounts.end(), out.begin(), [](const bigdecimal& v) { return (v * bigdecimal("2")).to_bigint(); },
+        pool, 128);
+    ASSERT_EQ(out.end(), end);
+    for (uint32_t i = 0; i < out.size(); i++) {
+        ASSERT_EQ(bigint(std::to_string(i * 2 + 1)), out[i]);
+    }
+}
+
+TEST(Parallel, Exceptions) {
+    thread_pool pool(3);
+
+    // lowest failed index wins, other tasks still run
+    std::atomic<size_t> executed{0};
+    try {
+        pool.run(100, [&executed](size_t i) {
+            executed++;
+            if (i % 10 == 7) {
+                throw std::runtime_error(std::to_string(i));
+            }
+        });
+        FAIL() << "exception expected";
+    } catch (const std::runtime_error& e) {
+        ASSERT_STREQ("7", e.what());
+    }
+    ASSERT_EQ(100u, executed.load());
+
+    // traps of caller's context are active in chunks
+    std::vector<bigdecimal> values(1000, bigdecimal("1"));
+    values[500] = bigdecimal("0");
+    const auto div = [](bigdecimal acc, const bigdecimal& v) { return acc / v; };
+    const bd_context saved = bigmath::context;
+    bigmath::context.policy(precision_policy::fixed);
+    bigmath::context.traps(bigmath::context.traps() | MPD_Division_by_zero);
+    ASSERT_THROW(parallel::reduce(values.begin(), values.end(), bigdecimal("1"), div, pool, 10), bigmath::division_by_zero);
+    bigmath::context = saved;
+}
+
+TEST(Parallel, Nested) {
+    thread_pool pool(2);
+    std::atomic<size_t> sum{0};
+    pool.run(8, [&pool, &sum](size_t i) {
+        pool.run(8, [&sum, i](size_t j) {
+            sum += i * 8 + j;
+        });
+    });
+    ASSERT_EQ(size_t(63 * 64 / 2), sum.load());
+}
@@ -0,0 +1,69 @@
+/*!
+ * bigmath.
+ * static_context_test.cpp
+ *
+ * \date 10/17/2026
+ * \author Eduard Maximovich (edward.vstock@gmail.com)
+ * \link   https://github.com/edwardstock
+ */
+
+#include <bigmath/bigdecimal.h>
+#include <gtest/gtest.h>
+
+using namespace bigmath;
+
+using ctx38 = static_context<38>;
+using ctx5_down = static_context<5, ROUND_DOWN, 10, -10>;
+
+static_assert(ctx38::value.prec == 38, "prec");
+static_assert(ctx38::value.round == MPD_ROUND_HALF_EVEN, "round");
+static_assert(ctx5_down::value.emax == 10 && ctx5_down::value.emin == -10, "exponent limits");
+static_assert(is_static_context<ctx38>::value, "trait");
+static_assert(!is_static_context<bd_context>::value, "trait");
+
+TEST(StaticContext, SameAsRuntimeContext) {
+    bd_context c(38, 999999, -999999, ROUND_HALF_EVEN);
+    ASSERT_EQ(c.prec(), ctx38::to_context().prec());
+    ASSERT_EQ(c.traps(), ctx38::to_context().traps());
+
+    const bigdecimal a("2");
+    const bigdecimal b("3");
+    ASSERT_EQ(a.div(b, c), a.div(b, ctx38{}));
+    ASSERT_EQ(a.add(b, c), a.add(b, ctx38{}));
+    ASSERT_EQ(a.sub(b, c), a.sub(b, ctx38{}));
+    ASSERT_EQ(a.mul(b, c), a.mul(b, ctx38{}));
+    ASSERT_EQ(a.rem(b, c), a.rem(b, ctx38{}));
+    ASSERT_EQ(a.divint(b, c), a.divint(b, ctx38{}));
+    ASSERT_EQ(a.pow(b, c), a.pow(b, ctx38{}));
+    ASSERT_EQ(a.max(b, c), a.max(b, ctx38{}));
+    ASSERT_EQ(a.min(b, c), a.min(b, ctx38{}));
+    ASSERT_EQ(a.fma(b, a, c), a.fma(b, a, ctx38{}));
+    ASSERT_EQ(a.sqrt(c), a.sqrt(ctx38{}));
+    ASSERT_EQ(a.ln(c), a.ln(ctx38{}));
+    ASSERT_EQ(a.exp(c), a.exp(ctx38{}));
+    ASSERT_EQ(a.log10(c), a.log10(ctx38{}));
+    ASSERT_EQ(a.minus(c), a.minus(ctx38{}));
+    ASSERT_EQ(bigdecimal("-2.50").abs(c), bigdecimal("-2.50").abs(ctx38{}));
+    ASSERT_EQ(bigdecimal("2.50").reduce(c), bigdecimal("2.50").reduce(ctx38{}));
+    ASSERT_EQ(bigdecimal("2.5").to_integral(c), bigdecimal("2.5").to_integral(ctx38{}));
+    ASSERT_EQ(bigdecimal("1.2345").quantize(bigdecimal("0.01"), c),
+              bigdecimal("1.2345").quantize(bigdecimal("0.01"), ctx38{}));
+}
+
+TEST(StaticContext, RoundingAndTraps) {
+    const bigdecimal a("2");
+    const bigdecimal b("3");
+    ASSERT_EQ(bigdecimal("0.66666"), a.div(b, ctx5_down{}));
+    ASSERT_EQ(bigdecimal("1.2345"), bigdecimal("1.23456789").apply(ctx5_down{}));
+    ASSERT_EQ(bigdecimal("1.2345").to_sci(), bigdecimal("1.23456789").plus(ctx5_down{}).to_sci());
+
+    ASSERT_THROW(a.div(bigdecimal("0"), ctx38{}), division_by_zero);
+    ASSERT_THROW(bigdecimal("-1").sqrt(ctx38{}), invalid_operation_error);
+    ASSERT_THROW(bigdecimal("10000000000").mul(bigdecimal("10"), ctx5_down{}), overflow_error);
+
+    // not trapped flags are dropped, thread context is not touched
+    const uint32_t status = context.status();
+    using quiet = static_context<5, ROUND_HALF_EVEN, 999999, -999999, 0>;
+    ASSERT_TRUE(a.div(bigdecimal("0"), quiet{}).isinfinite());
+    ASSERT_EQ(status, context.status());
+}
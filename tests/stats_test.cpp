@@ -0,0 +1,90 @@
+/*!
+ * bigmath.
+ * stats_test.cpp
+ *
+ * \date 10/17/2026
+ * \author Eduard Maximovich (edward.vstock@gmail.com)
+ * \link   https://github.com/edwardstock
+ */
+
+#include <bigmath/bigdecimal.h>
+#include <bigmath/bigint.h>
+#include <bigmath/stats.h>
+#include <gtest/gtest.h>
+#include <string>
+#include <thread>
+
+using namespace bigmath;
+
+TEST(Stats, Counters) {
+    const bigdecimal a("1.5");
+    const bigdecimal b("2.25");
+    stats::reset();
+
+    for (int i = 0; i < 10; i++) {
+        bigdecimal r = a.add(b);
+        r = r.mul(b);
+    }
+    {
+        // 100 digits don't fit inline buffer of 76 digits
+        const bigdecimal big(std::string(100, '7'));
+    }
+    bigint x("1");
+    x <<= 4096;
+    ASSERT_THROW(a.div(bigdecimal("0")), division_by_zero);
+
+    const stats::counters c = stats::snapshot();
+    if (!stats::enabled) {
+        ASSERT_EQ(0u, c.raises);
+        ASSERT_EQ(0u, c.decimal_allocs);
+        ASSERT_TRUE(c.ops.empty());
+        return;
+    }
+
+    ASSERT_EQ(10u, c.calls("add"));
+    ASSERT_EQ(10u, c.calls("mul"));
+    ASSERT_EQ(1u, c.calls("div"));
+    ASSERT_EQ(0u, c.calls("sqrt"));
+    ASSERT_GE(c.raises, 21u);
+    ASSERT_EQ(1u, c.traps);
+    ASSERT_GE(c.decimal_spills, 1u);
+    ASSERT_GE(c.decimal_allocs, 1u);
+    ASSERT_GE(c.decimal_frees, 1u);
+    ASSERT_GE(c.decimal_bytes, 100u / 19 * sizeof(mpd_uint_t));
+    ASSERT_GE(c.bigint_allocs + c.bigint_reallocs, 1u);
+    ASSERT_GE(c.bigint_bytes, 4096u / 8);
+}
+
+TEST(Stats, Spills) {
+    bd_context wide;
+    wide.prec(200);
+    stats::reset();
+
+    // 100 digits don't fit inline buffer of 76 digits: parsed, copied and computed into heap
+    const bigdecimal big(std::string(100, '7'));
+    const bigdecimal copy = big;
+    const bigdecimal sum = big.add(copy, wide);
+
+    // counted while values are alive
+    const stats::counters c = stats::snapshot();
+    ASSERT_EQ(stats::enabled ? 3u : 0u, c.decimal_spills);
+    ASSERT_TRUE(mpd_isdynamic_data(sum.getconst()));
+}
+
+TEST(Stats, Threads) {
+    stats::reset();
+    std::thread t([] {
+        const bigdecimal a("1.5");
+        for (int i = 0; i < 5; i++) {
+            bigdecimal r = a.sub(a);
+        }
+    });
+    t.join();
+
+    const stats::counters c = stats::snapshot();
+    // counters of finished thread are kept
+    ASSERT_EQ(stats::enabled ? 5u : 0u, c.calls("sub"));
+
+    stats::reset();
+    ASSERT_EQ(0u, stats::snapshot().calls("sub"));
+}
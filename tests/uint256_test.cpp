@@ -0,0 +1,202 @@
+/*!
+ * bigmath.
+ * uint256_test.cpp
+ *
+ * \date 10/17/2026
+ * \author Eduard Maximovich (edward.vstock@gmail.com)
+ * \link   https://github.com/edwardstock
+ */
+
+#include <bigmath/uint256.h>
+#include <gtest/gtest.h>
+#include <random>
+#include <sstream>
+#include <vector>
+
+using namespace bigmath;
+
+static const bigint TWO_256("115792089237316195423570985008687907853269984665640564039457584007913129639936");
+static const bigint TWO_255("57896044618658097711785492504343953926634992332820282019728792003956564819968");
+static const bigint MINUS_TWO_255 = bigint(0) - TWO_255;
+
+/* value of random width: 1 to 4 limbs, sometimes with all bits set in limbs */
+template<bool Signed>
+static basic_int256<Signed> random_value(std::mt19937_64& rng) {
+    uint8_t bytes[32] = {0};
+    const size_t n = 1 + rng() % 32;
+    for (size_t i = 32 - n; i < 32; i++) {
+        bytes[i] = rng() % 4 == 0 ? 0xFF : uint8_t(rng());
+    }
+    basic_int256<Signed> v;
+    v.import_from(bytes);
+    return rng() % 2 ? v : -v;
+}
+
+/* v mod 2^256 in range of uint256 or int256 */
+static bigint wrap(bigint v, bool is_signed) {
+    v %= TWO_256;
+    if (v < 0) {
+        v += TWO_256;
+    }
+    if (is_signed && v >= TWO_255) {
+        v -= TWO_256;
+    }
+    return v;
+}
+
+TEST(UInt256, Conversions) {
+    const uint256 max = uint256::max();
+    ASSERT_EQ("115792089237316195423570985008687907853269984665640564039457584007913129639935", max.str());
+    ASSERT_EQ(TWO_256 - 1, max.to_bigint());
+    ASSERT_EQ(max, uint256(TWO_256 - 1));
+    ASSERT_EQ(max, uint256("0xffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff"));
+    ASSERT_EQ(max, uint256(int256(-1)));
+    ASSERT_EQ("0", uint256().str());
+    ASSERT_EQ("12345678901234567890", uint256("12345678901234567890").str());
+    ASSERT_EQ(uint256(uint64_t(0xDEADBEEF)), uint256("0xDeadBeef"));
+
+    ASSERT_EQ("-57896044618658097711785492504343953926634992332820282019728792003956564819968", int256::min().str());
+    ASSERT_EQ(int256::min(), int256(MINUS_TWO_255));
+    ASSERT_EQ(int256::max(), int256(TWO_255 - 1));
+    ASSERT_EQ(MINUS_TWO_255, int256::min().to_bigint());
+    ASSERT_EQ(int256(-42), int256("-42"));
+    ASSERT_EQ(bigint(-42), int256(-42).to_bigint());
+    ASSERT_EQ(-1, int256(-42).sign());
+    ASSERT_EQ(0, int256().sign());
+    ASSERT_TRUE(int256(-42).issigned());
+    ASSERT_FALSE(uint256(int256(-42)).issigned());
+
+    ASSERT_THROW(uint256{TWO_256}, bigmath::overflow_error);
+    ASSERT_THROW(uint256(bigint(-1)), bigmath::overflow_error);
+    ASSERT_THROW(int256{TWO_255}, bigmath::overflow_error);
+    ASSERT_THROW(int256{MINUS_TWO_255 - 1}, bigmath::overflow_error);
+    ASSERT_THROW(uint256(TWO_256.str()), bigmath::overflow_error);
+    ASSERT_THROW(uint256("-1"), bigmath::overflow_error);
+    ASSERT_THROW(int256(TWO_255.str()), bigmath::overflow_error);
+    ASSERT_THROW(uint256("0x1" + std::string(64, '0')), bigmath::overflow_error);
+    ASSERT_THROW(uint256(""), bigmath::conversion_syntax_error);
+    ASSERT_THROW(uint256("0x"), bigmath::conversion_syntax_error);
+    ASSERT_THROW(uint256("12a"), bigmath::conversion_syntax_error);
+    ASSERT_EQ(uint256(0), uint256("-0"));
+
+    std::stringstream ss;
+    ss << int256(-7) << " " << uint256(7);
+    ASSERT_EQ("-7 7", ss.str());
+
+    char small[3];
+    ASSERT_EQ(std::errc::value_too_large, int256(-100).to_chars(small, small + sizeof(small)).ec);
+}
+
+TEST(UInt256, Bytes) {
+    const uint256 v("0x0102030405060708091011121314151617181920212223242526272829303132");
+    uint8_t out[32];
+    v.export_to(out);
+    for (size_t i = 0; i < 32; i++) {
+        ASSERT_EQ(uint8_t((i + 1) / 10 * 16 + (i + 1) % 10), out[i]) << i;
+    }
+    uint256 r;
+    r.import_from(out);
+    ASSERT_EQ(v, r);
+
+    v.export_to(out, endian::little);
+    ASSERT_EQ(0x32, out[0]);
+    ASSERT_EQ(0x01, out[31]);
+    r.import_from(out, endian::little);
+    ASSERT_EQ(v, r);
+
+    // same bytes as bigint export_to() with fixed width
+    uint8_t expected[32];
+    v.to_bigint().export_to(expected, sizeof(expected), endian::big, true);
+    v.export_to(out);
+    ASSERT_EQ(0, memcmp(expected, out, sizeof(out)));
+
+    int256(-1).export_to(out);
+    for (uint8_t b : out) {
+        ASSERT_EQ(0xFF, b);
+    }
+}
+
+template<bool Signed>
+static void check_arithmetic() {
+    std::mt19937_64 rng(Signed ? 2 : 1);
+    for (size_t i = 0; i < 2000; i++) {
+        const basic_int256<Signed> a = random_value<Signed>(rng);
+        const basic_int256<Signed> b = random_value<Signed>(rng);
+        const bigint x = a.to_bigint(), y = b.to_bigint();
+        ASSERT_EQ(a, basic_int256<Signed>(x));
+        ASSERT_EQ(x.str(), a.str());
+        ASSERT_EQ(a, basic_int256<Signed>(a.str()));
+
+        ASSERT_EQ(wrap(x + y, Signed), (a + b).to_bigint());
+        ASSERT_EQ(wrap(x - y, Signed), (a - b).to_bigint());
+        ASSERT_EQ(wrap(x * y, Signed), (a * b).to_bigint());
+        ASSERT_EQ(wrap(bigint(0) - x, Signed), (-a).to_bigint());
+        if (!b.iszero()) {
+            // bigint division truncates as well
+            ASSERT_EQ(wrap(x / y, Signed), (a / b).to_bigint()) << a << " / " << b;
+            ASSERT_EQ(wrap(x % y, Signed), (a % b).to_bigint()) << a << " % " << b;
+        }
+        ASSERT_EQ(x < y, a < b);
+        ASSERT_EQ(x <= y, a <= b);
+        ASSERT_EQ(x == y, a == b);
+
+        basic_int256<Signed> r;
+        ASSERT_EQ(wrap(x + y, Signed) == x + y, a.try_add(b, r));
+        ASSERT_EQ(wrap(x - y, Signed) == x - y, a.try_sub(b, r));
+        const bool mul_ok = wrap(x * y, Signed) == x * y;
+        ASSERT_EQ(mul_ok, a.try_mul(b, r)) << a << " * " << b;
+        if (mul_ok) {
+            ASSERT_EQ(x * y, r.to_bigint());
+        }
+
+        const unsigned shift = unsigned(rng() % 300);
+        bigint pow2;
+        bigint::pow_ui(pow2, bigint(2), shift);
+        ASSERT_EQ(wrap(x * pow2, Signed), (a << shift).to_bigint()) << a << " << " << shift;
+        // floor division: arithmetic shift of negative values rounds to minus infinity
+        bigint floor_div = x / pow2;
+        if (x < 0 && floor_div * pow2 != x) {
+            floor_div -= 1;
+        }
+        ASSERT_EQ(wrap(floor_div, Signed), (a >> shift).to_bigint()) << a << " >> " << shift;
+    }
+}
+
+TEST(UInt256, Arithmetic) {
+    check_arithmetic<false>();
+}
+
+TEST(Int256, Arithmetic) {
+    check_arithmetic<true>();
+}
+
+TEST(Int256, Overflow) {
+    int256 r(7);
+    ASSERT_FALSE(int256::max().try_add(int256(1), r));
+    ASSERT_EQ(int256(7), r);
+    ASSERT_EQ(int256::min(), int256::max() + int256(1));
+    ASSERT_FALSE(int256::min().try_sub(int256(1), r));
+    ASSERT_FALSE(int256::min().try_mul(int256(-1), r));
+    ASSERT_TRUE(int256::min().try_mul(int256(1), r));
+    ASSERT_FALSE(int256::min().try_div(int256(-1), r));
+    ASSERT_EQ(int256::min(), int256::min() / int256(-1));
+    ASSERT_TRUE(int256(-7).try_div(int256(2), r));
+    ASSERT_EQ(int256(-3), r);
+
+    uint256 u;
+    ASSERT_FALSE(uint256::max().try_add(uint256(1), u));
+    ASSERT_EQ(uint256(0), uint256::max() + uint256(1));
+    ASSERT_FALSE(uint256(0).try_sub(uint256(1), u));
+    ASSERT_FALSE((uint256(1) << 128).try_mul(uint256(1) << 128, u));
+    ASSERT_TRUE((uint256(1) << 127).try_mul(uint256(1) << 128, u));
+    ASSERT_EQ(uint256(1) << 255, u);
+
+    ASSERT_THROW(uint256(1) / uint256(0), bigmath::division_by_zero);
+    ASSERT_THROW(int256(1) % int256(0), bigmath::division_by_zero);
+    ASSERT_THROW(int256(1).try_div(int256(0), r), bigmath::division_by_zero);
+
+    uint256 q, rem;
+    uint256::div_mod(uint256("1000000000000000000000000000000000000007"), uint256("1000000000000000000000"), q, rem);
+    ASSERT_EQ(uint256("1000000000000000000"), q);
+    ASSERT_EQ(uint256(7), rem);
+}